@@ -0,0 +1,620 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Command line tool to compile LaTeX2AI items without Illustrator.
+ *
+ * The items are given as XML files in the "LaTeX2AI_item" format and a pdf file is created for each of them. Items with
+ * the same code are only compiled once. The tool only uses the portable core of LaTeX2AI, see doc/BUILD_FROM_SOURCE.md
+ * for how to build it.
+ *
+ * With --benchmark the tool compiles generated batches of items and reports the time spent in the LaTeX and
+ * Ghostscript calls separately from the time spent in LaTeX2AI itself. Together with the l2a-fake-tex stand-in, the
+ * overhead of LaTeX2AI can be measured without a TeX installation.
+ *
+ * With --extract the items are read from files that contain their XML data, e.g., Illustrator files saved without
+ * compression. The pdf files stored in the items are written to the links directory, in the same way as the plugin
+ * does it, and the items can be compiled again with a given header.
+ */
+
+
+#include "l2a_background_compile.h"
+#include "l2a_compile_core.h"
+#include "l2a_encoded_file_writer.h"
+#include "l2a_header_resolver.h"
+#include "l2a_links_folder.h"
+
+#include "auto_generated/tex.h"
+
+#include "base64.h"
+#include "json.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <thread>
+
+
+//! Names of the files in the compile directory, they are the same as in the plugin.
+static const char* cli_tex_header_name_ = "LaTeX2AI_header.tex";
+static const char* cli_tex_name_ = "LaTeX2AI_item.tex";
+
+//! Name of the compile directory in the output directory.
+static const char* cli_compile_directory_name_ = "LaTeX2AI_compile";
+
+//! Names of the links directory, the manifest in it and the postfix of the pdf files, they are the same as in the
+//! plugin.
+static const char* cli_links_directory_name_ = "links";
+static const char* cli_links_manifest_name_ = "LaTeX2AI_manifest.txt";
+static const char* cli_pdf_item_post_fix_ = "_LaTeX2AI_";
+
+
+/**
+ * \brief Options of the command line tool.
+ */
+struct CompileOptions
+{
+    std::filesystem::path header_path_;
+    std::filesystem::path output_directory_;
+    std::filesystem::path latex_bin_path_;
+    std::string latex_engine_ = "pdflatex";
+    std::string latex_command_options_ = "-interaction nonstopmode -halt-on-error -file-line-error";
+    std::string gs_command_ = "gs";
+    std::vector<std::filesystem::path> item_files_;
+
+    //! Files to extract the items from and the directory for the extracted pdf files. If the directory is empty, the
+    //! links directory next to each file is used.
+    std::vector<std::filesystem::path> extract_files_;
+    std::filesystem::path links_directory_;
+
+    //! Number of batches that are compiled in parallel.
+    size_t n_jobs_ = 1;
+
+    //! Batch sizes for the benchmark, the benchmark is run if this is not empty.
+    std::vector<size_t> benchmark_sizes_;
+};
+
+/**
+ * \brief Timings of the compilation of one batch.
+ */
+struct CompileTimings
+{
+    //! Time to create the LaTeX document and the commands.
+    double prepare_ = 0.0;
+
+    //! Time for the LaTeX and Ghostscript calls.
+    double latex_ = 0.0;
+    double split_ = 0.0;
+
+    //! Time for writing the files and checking the created pages.
+    double files_ = 0.0;
+
+    //! Time to read and encode the pages, as they are stored in the items.
+    double encode_ = 0.0;
+};
+
+/**
+ * \brief Print the usage of the tool.
+ */
+void PrintUsage()
+{
+    std::cerr << "Usage: l2a-compile --header <file> --output <directory> [options] <item.xml>...\n"
+                 "       l2a-compile --extract <file> [--header <file> --output <directory>] [options]\n"
+                 "       l2a-compile --benchmark <sizes> --output <directory> [options]\n"
+                 "\n"
+                 "Compile LaTeX2AI items and write <item>.pdf for each item file to the output directory.\n"
+                 "\n"
+                 "With --extract, the items are read from an Illustrator file that was saved without compression (or\n"
+                 "any other file that contains the item data). The pdf files stored in the items are written to the\n"
+                 "links directory. If a header is given, the items are compiled again and the pdf files are written\n"
+                 "to the output directory, named as the plugin would name them. A summary is printed as JSON. Files\n"
+                 "without any item, e.g., compressed Illustrator files, are an error.\n"
+                 "\n"
+                 "Options:\n"
+                 "  --header <file>        LaTeX2AI header of the document (default for --benchmark: LaTeX2AI header)\n"
+                 "  --output <directory>   Directory for the created pdf files\n"
+                 "  --engine <name>        LaTeX engine (default: pdflatex)\n"
+                 "  --bin <directory>      Directory of the LaTeX binaries (default: search in PATH)\n"
+                 "  --options <options>    Options for the LaTeX engine\n"
+                 "  --gs <command>         Ghostscript command (default: gs)\n"
+                 "  --jobs <n>             Number of batches that are compiled in parallel (default: 1)\n"
+                 "  --extract <file>       File to extract the items from, can be given multiple times\n"
+                 "  --links <directory>    Directory for the extracted pdf files (default: links next to the file)\n"
+                 "  --benchmark <sizes>    Compile generated batches with the comma separated numbers of items and\n"
+                 "                         print the timings as JSON\n";
+}
+
+/**
+ * \brief Parse the command line arguments.
+ */
+bool ParseArguments(int argc, char* argv[], CompileOptions& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argument = argv[i];
+        if (argument.rfind("--", 0) != 0)
+        {
+            options.item_files_.push_back(std::filesystem::u8path(argument));
+            continue;
+        }
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for " << argument << "\n";
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (argument == "--header")
+            options.header_path_ = std::filesystem::u8path(value);
+        else if (argument == "--output")
+            options.output_directory_ = std::filesystem::u8path(value);
+        else if (argument == "--engine")
+            options.latex_engine_ = value;
+        else if (argument == "--bin")
+            options.latex_bin_path_ = std::filesystem::u8path(value);
+        else if (argument == "--options")
+            options.latex_command_options_ = value;
+        else if (argument == "--gs")
+            options.gs_command_ = value;
+        else if (argument == "--jobs")
+            options.n_jobs_ = (size_t)std::max(1L, std::atol(value.c_str()));
+        else if (argument == "--extract")
+            options.extract_files_.push_back(std::filesystem::u8path(value));
+        else if (argument == "--links")
+            options.links_directory_ = std::filesystem::u8path(value);
+        else if (argument == "--benchmark")
+        {
+            std::stringstream sizes(value);
+            std::string size;
+            while (std::getline(sizes, size, ','))
+            {
+                const long n_items = std::atol(size.c_str());
+                if (n_items <= 0)
+                {
+                    std::cerr << "Invalid batch size " << size << "\n";
+                    return false;
+                }
+                options.benchmark_sizes_.push_back((size_t)n_items);
+            }
+        }
+        else
+        {
+            std::cerr << "Unknown option " << argument << "\n";
+            return false;
+        }
+    }
+    if (!options.extract_files_.empty())
+        return options.item_files_.empty() && options.benchmark_sizes_.empty() &&
+               options.header_path_.empty() == options.output_directory_.empty();
+    if (options.output_directory_.empty()) return false;
+    if (!options.benchmark_sizes_.empty()) return options.item_files_.empty();
+    return !options.header_path_.empty() && !options.item_files_.empty();
+}
+
+/**
+ * \brief Run a command in a working directory, the output of the command is discarded.
+ */
+int RunCompileCommand(const std::string& command, const std::filesystem::path& working_directory)
+{
+    const std::string full_command = "cd \"" + working_directory.u8string() + "\" && " + command + " > /dev/null 2>&1";
+    return std::system(full_command.c_str());
+}
+
+/**
+ * \brief Get the elapsed time in seconds since a time point.
+ */
+double GetElapsedTime(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * \brief Get the directory in which a batch of items is compiled.
+ */
+std::filesystem::path GetCompileDirectory(const CompileOptions& options, const size_t i_batch)
+{
+    std::filesystem::path directory =
+        std::filesystem::absolute(options.output_directory_) / cli_compile_directory_name_;
+    if (i_batch > 0) directory += "_" + std::to_string(i_batch);
+    return directory;
+}
+
+/**
+ * \brief Create the job to compile the items, in the same way as the plugin does for the background compilation.
+ */
+L2A::UTIL::BackgroundCompileJob CreateCompileJob(const CompileOptions& options, const std::string& header_text,
+    const std::vector<L2A::UTIL::LocalPackage>& local_packages, const std::vector<L2A::UTIL::RedoPlanItem>& items,
+    const std::filesystem::path& directory)
+{
+    const std::filesystem::path tex_file = directory / cli_tex_name_;
+    std::filesystem::path pdf_file = tex_file;
+    pdf_file.replace_extension(".pdf");
+
+    const L2A::UTIL::RedoPlan plan = L2A::UTIL::CreateRedoPlan(items);
+    L2A::UTIL::BackgroundCompileJob job;
+    job.directory_ = directory;
+    job.header_name_ = cli_tex_header_name_;
+    job.header_text_ = header_text;
+    job.local_packages_ = local_packages;
+    job.tex_name_ = cli_tex_name_;
+    job.tex_text_ = L2A::UTIL::GetLatexDocumentText(
+        L2A::UTIL::GetLatexPagesCode(items, plan.compile_items_), cli_tex_header_name_);
+    job.latex_command_ = L2A::UTIL::GetLatexCompileCommand(
+        options.latex_bin_path_, options.latex_engine_, options.latex_command_options_, tex_file);
+    job.split_command_ = L2A::UTIL::GetSplitPdfPagesCommand(pdf_file, options.gs_command_);
+    for (const auto& i_item : plan.compile_items_) job.pages_.push_back(items[i_item]);
+    return job;
+}
+
+/**
+ * \brief Compile the items and measure the time of the individual steps.
+ * @return False if the compilation failed.
+ */
+bool CompileItems(const CompileOptions& options, const std::string& header_text,
+    const std::vector<L2A::UTIL::LocalPackage>& local_packages, const std::vector<L2A::UTIL::RedoPlanItem>& items,
+    const std::filesystem::path& directory, L2A::UTIL::BackgroundCompileResult& result, CompileTimings& timings)
+{
+    auto start = std::chrono::steady_clock::now();
+    const auto job = CreateCompileJob(options, header_text, local_packages, items, directory);
+    timings.prepare_ = GetElapsedTime(start);
+
+    // The first command is the LaTeX call, the second one the Ghostscript call.
+    size_t n_commands = 0;
+    const auto run_command = [&](const std::string& command, const std::filesystem::path& working_directory)
+    {
+        const auto command_start = std::chrono::steady_clock::now();
+        const int exit_code = RunCompileCommand(command, working_directory);
+        (n_commands++ == 0 ? timings.latex_ : timings.split_) = GetElapsedTime(command_start);
+        return exit_code;
+    };
+    start = std::chrono::steady_clock::now();
+    const bool is_ok = L2A::UTIL::CompileBackgroundJob(job, run_command, result);
+    timings.files_ = GetElapsedTime(start) - timings.latex_ - timings.split_;
+    return is_ok;
+}
+
+/**
+ * \brief Compile the items in batches that run in parallel, each batch in its own directory. Identical items are only
+ * compiled once.
+ * @return False if the compilation of a batch failed.
+ */
+bool CompileItemsParallel(const CompileOptions& options, const std::string& header_text,
+    const std::vector<L2A::UTIL::LocalPackage>& local_packages, const std::vector<L2A::UTIL::RedoPlanItem>& items,
+    std::vector<L2A::UTIL::BackgroundCompileResult>& results)
+{
+    results.clear();
+    const L2A::UTIL::RedoPlan plan = L2A::UTIL::CreateRedoPlan(items);
+    const size_t n_unique = plan.compile_items_.size();
+    if (n_unique == 0) return true;
+
+    const size_t n_batches = std::min(options.n_jobs_, n_unique);
+    std::vector<std::vector<L2A::UTIL::RedoPlanItem>> batches(n_batches);
+    for (size_t i_unique = 0; i_unique < n_unique; i_unique++)
+        batches[i_unique * n_batches / n_unique].push_back(items[plan.compile_items_[i_unique]]);
+
+    results.resize(n_batches);
+    std::vector<char> is_ok(n_batches, 0);
+    std::vector<std::thread> threads;
+    for (size_t i_batch = 0; i_batch < n_batches; i_batch++)
+        threads.emplace_back(
+            [&, i_batch]()
+            {
+                CompileTimings timings;
+                is_ok[i_batch] = CompileItems(options, header_text, local_packages, batches[i_batch],
+                    GetCompileDirectory(options, i_batch), results[i_batch], timings);
+            });
+    for (auto& thread : threads) thread.join();
+    return std::all_of(is_ok.begin(), is_ok.end(), [](const char value) { return value != 0; });
+}
+
+/**
+ * \brief Find the compiled page of an item in the results of the batches.
+ */
+const std::filesystem::path* FindCompiledPage(
+    const std::vector<L2A::UTIL::BackgroundCompileResult>& results, const L2A::UTIL::RedoPlanItem& item)
+{
+    for (const auto& result : results)
+    {
+        const std::filesystem::path* page = result.FindPage(item);
+        if (page != nullptr) return page;
+    }
+    return nullptr;
+}
+
+/**
+ * \brief Read the contents of a file.
+ * @return False if the file could not be read.
+ */
+bool ReadFileContents(const std::filesystem::path& path, std::string& contents)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    contents = buffer.str();
+    return true;
+}
+
+/**
+ * \brief Extract the items from the files and write the pdf files stored in them to the links directories. If a
+ * header is given, the items are compiled again. A summary is printed as JSON.
+ */
+int RunExtract(const CompileOptions& options, const std::string& header_text,
+    const std::vector<L2A::UTIL::LocalPackage>& local_packages)
+{
+    using json = nlohmann::json;
+
+    json files = json::array();
+    std::vector<L2A::UTIL::RedoPlanItem> items;
+    std::vector<std::string> item_document_names;
+    for (const auto& extract_file : options.extract_files_)
+    {
+        std::string contents;
+        if (!ReadFileContents(extract_file, contents))
+        {
+            std::cerr << "Could not read the file " << extract_file.u8string() << "\n";
+            return 1;
+        }
+
+        // The pdf files are named and stored in the manifest as the plugin does it for the document.
+        const std::string document_name = extract_file.stem().u8string();
+        const std::filesystem::path links_directory = options.links_directory_.empty()
+                                                          ? extract_file.parent_path() / cli_links_directory_name_
+                                                          : options.links_directory_;
+        std::vector<L2A::UTIL::EncodedFileWrite> pdf_files;
+        std::vector<std::string> pdf_hashes;
+        std::set<std::string> pdf_names;
+        size_t n_items = 0;
+        size_t n_invalid_items = 0;
+        size_t n_items_without_pdf = 0;
+        size_t n_legacy_hash_items = 0;
+        for (const auto& item_xml : L2A::UTIL::FindItemXML(contents))
+        {
+            L2A::UTIL::RedoPlanItem item;
+            std::string encoded_contents;
+            std::string hash;
+            bool is_legacy_hash;
+            if (!L2A::UTIL::ReadItemXML(item_xml, item) ||
+                !L2A::UTIL::ReadItemPDFFile(item_xml, encoded_contents, hash, is_legacy_hash))
+            {
+                n_invalid_items++;
+                continue;
+            }
+            n_items++;
+            items.push_back(item);
+            item_document_names.push_back(document_name);
+            if (encoded_contents.empty())
+            {
+                n_items_without_pdf++;
+                continue;
+            }
+            if (is_legacy_hash) n_legacy_hash_items++;
+
+            const std::string pdf_name = document_name + cli_pdf_item_post_fix_ + hash + ".pdf";
+            if (!pdf_names.insert(pdf_name).second) continue;
+            L2A::UTIL::EncodedFileWrite pdf_file;
+            pdf_file.path_ = links_directory / pdf_name;
+            pdf_file.encoded_contents_ = std::move(encoded_contents);
+            pdf_files.push_back(std::move(pdf_file));
+            pdf_hashes.push_back(hash);
+        }
+
+        // Without any item in the file there is nothing to extract, this is not reported as an empty manifest.
+        if (n_items == 0 && n_invalid_items == 0)
+        {
+            if (L2A::UTIL::IsCompressedIllustratorData(contents))
+                std::cerr << "The file " << extract_file.u8string()
+                          << " is compressed, save it without compression to extract the LaTeX2AI items\n";
+            else
+                std::cerr << "No LaTeX2AI items found in the file " << extract_file.u8string() << "\n";
+            return 1;
+        }
+
+        std::filesystem::create_directories(links_directory);
+        L2A::UTIL::WriteEncodedFiles(pdf_files, L2A::UTIL::GetEncodedFileWriteThreadCount());
+        L2A::UTIL::LinksManifest manifest(links_directory / cli_links_manifest_name_);
+        size_t n_failed_files = 0;
+        for (size_t i_file = 0; i_file < pdf_files.size(); i_file++)
+        {
+            if (pdf_files[i_file].is_written_)
+                manifest.Update(pdf_files[i_file].path_.filename().u8string(), pdf_hashes[i_file],
+                    pdf_files[i_file].content_hash_);
+            else
+                n_failed_files++;
+        }
+        manifest.Write();
+
+        files.push_back({{"file", extract_file.u8string()}, {"links_directory", links_directory.u8string()},
+            {"n_items", n_items}, {"n_invalid_items", n_invalid_items}, {"n_items_without_pdf", n_items_without_pdf},
+            {"n_legacy_hash_items", n_legacy_hash_items}, {"n_pdf_files", pdf_files.size() - n_failed_files},
+            {"n_failed_pdf_files", n_failed_files}});
+    }
+    json summary = {{"files", files}};
+
+    // Compile the items again with the given header.
+    if (!options.header_path_.empty())
+    {
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<L2A::UTIL::BackgroundCompileResult> results;
+        if (!CompileItemsParallel(options, header_text, local_packages, items, results))
+        {
+            std::cerr << "The compilation failed, see the files in "
+                      << GetCompileDirectory(options, 0).parent_path().u8string() << "\n";
+            return 2;
+        }
+
+        // The pages are named after the hash of their encoded contents, as the plugin does it.
+        std::set<std::filesystem::path> compiled_files;
+        for (size_t i_item = 0; i_item < items.size(); i_item++)
+        {
+            std::string page;
+            const std::filesystem::path* page_path = FindCompiledPage(results, items[i_item]);
+            if (page_path == nullptr || !ReadFileContents(*page_path, page))
+            {
+                std::cerr << "Could not read the compiled page of item " << i_item << "\n";
+                return 2;
+            }
+            const std::string hash = L2A::UTIL::GetStringHash(base64::encode(page.data(), page.size()));
+            const std::filesystem::path item_pdf =
+                options.output_directory_ / (item_document_names[i_item] + cli_pdf_item_post_fix_ + hash + ".pdf");
+            if (compiled_files.insert(item_pdf).second)
+                std::filesystem::copy_file(*page_path, item_pdf, std::filesystem::copy_options::overwrite_existing);
+        }
+        summary["compile"] = {{"n_items", items.size()}, {"n_pdf_files", compiled_files.size()},
+            {"n_batches", results.size()}, {"time", GetElapsedTime(start)}};
+    }
+
+    std::cout << summary.dump(4) << "\n";
+    return 0;
+}
+
+/**
+ * \brief Compile generated batches of items and print the timings as JSON.
+ */
+int RunBenchmark(const CompileOptions& options, const std::string& header_text,
+    const std::vector<L2A::UTIL::LocalPackage>& local_packages)
+{
+    using json = nlohmann::json;
+
+    json results = json::array();
+    for (const auto n_items : options.benchmark_sizes_)
+    {
+        // Every other item is a baseline item.
+        std::vector<L2A::UTIL::RedoPlanItem> items(n_items);
+        for (size_t i_item = 0; i_item < n_items; i_item++)
+        {
+            items[i_item].latex_code_ = "$x_{" + std::to_string(i_item) + "}$";
+            items[i_item].is_baseline_ = i_item % 2 == 1;
+        }
+
+        L2A::UTIL::BackgroundCompileResult result;
+        CompileTimings timings;
+        if (!CompileItems(
+                options, header_text, local_packages, items, GetCompileDirectory(options, 0), result, timings))
+        {
+            std::cerr << "The compilation of " << n_items << " items failed\n";
+            return 2;
+        }
+
+        // Encode the pages as they are stored in the items.
+        const auto start = std::chrono::steady_clock::now();
+        size_t n_encoded_bytes = 0;
+        for (const auto& item : items)
+        {
+            std::ifstream page_file(*result.FindPage(item), std::ios::binary);
+            std::stringstream buffer;
+            buffer << page_file.rdbuf();
+            const std::string page = buffer.str();
+            const std::string encoded = base64::encode(page.data(), page.size());
+            n_encoded_bytes += encoded.size() + L2A::UTIL::GetStringHash(encoded).size();
+        }
+        timings.encode_ = GetElapsedTime(start);
+
+        const double overhead = timings.prepare_ + timings.files_ + timings.encode_;
+        const double total = overhead + timings.latex_ + timings.split_;
+        results.push_back({{"n_items", n_items}, {"prepare", timings.prepare_}, {"latex", timings.latex_},
+            {"split", timings.split_}, {"files", timings.files_}, {"encode", timings.encode_},
+            {"overhead", overhead}, {"total", total}, {"overhead_per_item", overhead / (double)n_items},
+            {"encoded_bytes", n_encoded_bytes}});
+    }
+
+    const json benchmark = {{"latex_command", L2A::UTIL::GetLatexCompileCommand(options.latex_bin_path_,
+                                                  options.latex_engine_, options.latex_command_options_, "<tex>")},
+        {"gs_command", options.gs_command_}, {"results", results}};
+    std::cout << benchmark.dump(4) << "\n";
+    return 0;
+}
+
+/**
+ * \brief Main function of the command line tool.
+ */
+int main(int argc, char* argv[])
+{
+    CompileOptions options;
+    if (!ParseArguments(argc, argv, options))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    // Resolve the header, the benchmark uses the default header if none is given.
+    L2A::UTIL::HeaderResolver header_resolver;
+    std::string header_text = L2A_LATEX_HEADER_;
+    std::vector<L2A::UTIL::LocalPackage> local_packages;
+    if (!options.header_path_.empty())
+    {
+        if (!std::filesystem::is_regular_file(options.header_path_))
+        {
+            std::cerr << "The header " << options.header_path_.u8string() << " does not exist\n";
+            return 1;
+        }
+        const auto& resolved_header = header_resolver.Resolve(options.header_path_);
+        if (!resolved_header.cycle_.empty())
+        {
+            std::cerr << "The header includes itself via " << resolved_header.cycle_.back().u8string() << "\n";
+            return 1;
+        }
+        header_text = resolved_header.text_;
+        local_packages = resolved_header.local_packages_;
+    }
+
+    if (!options.benchmark_sizes_.empty()) return RunBenchmark(options, header_text, local_packages);
+    if (!options.extract_files_.empty()) return RunExtract(options, header_text, local_packages);
+
+    // Read the items.
+    std::vector<L2A::UTIL::RedoPlanItem> items(options.item_files_.size());
+    for (size_t i_item = 0; i_item < items.size(); i_item++)
+    {
+        std::ifstream item_file(options.item_files_[i_item]);
+        std::stringstream buffer;
+        buffer << item_file.rdbuf();
+        if (!item_file.is_open() || !L2A::UTIL::ReadItemXML(buffer.str(), items[i_item]))
+        {
+            std::cerr << "Could not read the item " << options.item_files_[i_item].u8string() << "\n";
+            return 1;
+        }
+    }
+
+    std::vector<L2A::UTIL::BackgroundCompileResult> results;
+    if (!CompileItemsParallel(options, header_text, local_packages, items, results))
+    {
+        std::cerr << "The compilation failed, see the files in "
+                  << GetCompileDirectory(options, 0).parent_path().u8string() << "\n";
+        return 2;
+    }
+
+    // Copy the page of each item to the output directory.
+    for (size_t i_item = 0; i_item < items.size(); i_item++)
+    {
+        std::filesystem::path item_pdf = options.output_directory_ / options.item_files_[i_item].filename();
+        item_pdf.replace_extension(".pdf");
+        std::filesystem::copy_file(
+            *FindCompiledPage(results, items[i_item]), item_pdf, std::filesystem::copy_options::overwrite_existing);
+        std::cout << item_pdf.u8string() << "\n";
+    }
+    return 0;
+}
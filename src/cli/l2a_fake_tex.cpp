@@ -0,0 +1,175 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Stand-in for the LaTeX engine and Ghostscript to benchmark the compilation of items without TeX.
+ *
+ * Called with a tex file, a pdf with one page for each item in the file is created. Called with the Ghostscript
+ * arguments used by LaTeX2AI, the pdf is split into single page pdf files. The created pdf files are valid, but the
+ * pages are empty. The latencies of the real tools can be simulated with the environment variables
+ * L2A_FAKE_COMPILE_MS, L2A_FAKE_COMPILE_PAGE_MS, L2A_FAKE_SPLIT_MS and L2A_FAKE_SPLIT_PAGE_MS.
+ */
+
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+/**
+ * \brief Get a latency in milliseconds from an environment variable.
+ */
+double GetFakeLatency(const char* name)
+{
+    const char* value = std::getenv(name);
+    return value == nullptr ? 0.0 : std::atof(value);
+}
+
+/**
+ * \brief Wait for the simulated latency of a tool.
+ */
+void WaitFakeLatency(const char* fixed_name, const char* page_name, const size_t n_pages)
+{
+    const double latency = GetFakeLatency(fixed_name) + GetFakeLatency(page_name) * (double)n_pages;
+    if (latency > 0.0) std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(latency));
+}
+
+/**
+ * \brief Write a valid pdf file with empty pages.
+ */
+bool WriteFakePdf(const std::string& path, const size_t n_pages)
+{
+    // Objects 1 and 2 are the catalog and the page tree, followed by the pages.
+    std::vector<std::string> objects;
+    objects.push_back("<< /Type /Catalog /Pages 2 0 R >>");
+    std::string kids;
+    for (size_t i_page = 0; i_page < n_pages; i_page++) kids += std::to_string(i_page + 3) + " 0 R ";
+    objects.push_back("<< /Type /Pages /Kids [ " + kids + "] /Count " + std::to_string(n_pages) + " >>");
+    for (size_t i_page = 0; i_page < n_pages; i_page++)
+        objects.push_back("<< /Type /Page /Parent 2 0 R /MediaBox [0 0 20 10] >>");
+
+    std::ostringstream pdf;
+    pdf << "%PDF-1.4\n";
+    std::vector<size_t> offsets;
+    for (size_t i_object = 0; i_object < objects.size(); i_object++)
+    {
+        offsets.push_back((size_t)pdf.tellp());
+        pdf << i_object + 1 << " 0 obj\n" << objects[i_object] << "\nendobj\n";
+    }
+    const size_t xref_offset = (size_t)pdf.tellp();
+    pdf << "xref\n0 " << objects.size() + 1 << "\n0000000000 65535 f \n";
+    for (const auto offset : offsets)
+    {
+        const std::string offset_string = std::to_string(offset);
+        pdf << std::string(10 - offset_string.size(), '0') << offset_string << " 00000 n \n";
+    }
+    pdf << "trailer\n<< /Size " << objects.size() + 1 << " /Root 1 0 R >>\nstartxref\n" << xref_offset << "\n%%EOF\n";
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << pdf.str();
+    return file.good();
+}
+
+/**
+ * \brief Read a text file.
+ */
+bool ReadFakeInput(const std::string& path, std::string& text)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    text = buffer.str();
+    return true;
+}
+
+/**
+ * \brief Create the pdf for a tex file, each item in the document is one page.
+ */
+int FakeCompile(const std::string& tex_path)
+{
+    std::string text;
+    if (!ReadFakeInput(tex_path, text)) return 1;
+
+    size_t n_pages = 0;
+    std::istringstream lines(text);
+    std::string line;
+    while (std::getline(lines, line))
+        if (line.rfind("\\LaTeXtoAI{", 0) == 0 || line.rfind("\\LaTeXtoAIbase{", 0) == 0) n_pages++;
+
+    WaitFakeLatency("L2A_FAKE_COMPILE_MS", "L2A_FAKE_COMPILE_PAGE_MS", n_pages);
+
+    // The log contains the time of each page in units of 1/65536 s, as written by the item template.
+    const long long page_ticks = (long long)(GetFakeLatency("L2A_FAKE_COMPILE_PAGE_MS") * 65.536);
+    std::ofstream log_file(tex_path.substr(0, tex_path.size() - 4) + ".log", std::ios::trunc);
+    for (size_t i_page = 1; i_page <= n_pages; i_page++)
+        log_file << "LaTeX2AI page time: " << i_page << " " << page_ticks << "\n";
+
+    const std::string pdf_path = tex_path.substr(0, tex_path.size() - 4) + ".pdf";
+    return WriteFakePdf(pdf_path, n_pages) ? 0 : 1;
+}
+
+/**
+ * \brief Split a pdf file into single pages, the output pattern contains "%d" for the page number.
+ */
+int FakeSplit(const std::string& output_pattern, const std::string& pdf_path)
+{
+    std::string text;
+    if (!ReadFakeInput(pdf_path, text)) return 1;
+    const size_t count_position = text.find("/Count ");
+    if (count_position == std::string::npos) return 1;
+    const size_t n_pages = (size_t)std::atol(text.c_str() + count_position + 7);
+
+    WaitFakeLatency("L2A_FAKE_SPLIT_MS", "L2A_FAKE_SPLIT_PAGE_MS", n_pages);
+    const size_t placeholder_position = output_pattern.find("%d");
+    if (placeholder_position == std::string::npos) return 1;
+    for (size_t i_page = 1; i_page <= n_pages; i_page++)
+    {
+        std::string page_path = output_pattern;
+        page_path.replace(placeholder_position, 2, std::to_string(i_page));
+        if (!WriteFakePdf(page_path, 1)) return 1;
+    }
+    return 0;
+}
+
+/**
+ * \brief Main function of the stand-in tool.
+ */
+int main(int argc, char* argv[])
+{
+    const std::vector<std::string> arguments(argv + 1, argv + argc);
+    for (size_t i = 0; i + 2 < arguments.size(); i++)
+        if (arguments[i] == "-o") return FakeSplit(arguments[i + 1], arguments[i + 2]);
+    for (const auto& argument : arguments)
+        if (argument.size() > 4 && argument.compare(argument.size() - 4, 4, ".tex") == 0) return FakeCompile(argument);
+
+    std::cerr << "Usage: l2a-fake-tex [options] <file.tex>\n"
+                 "       l2a-fake-tex -sDEVICE=pdfwrite -o <name>_%d.pdf <name>.pdf\n";
+    return 1;
+}
@@ -0,0 +1,325 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Command line tool to profile the document level functions of LaTeX2AI on synthetic documents.
+ *
+ * Documents with the given numbers of items are created in memory (see L2A::UTIL::FakeDocument) and the functions that
+ * loop over all items of a document are timed: finding the items, creating the states drawn by the annotator, the hit
+ * test and the invalidation after a change, the redo plan, the check of the linked pdf files and the analysis of the
+ * document footprint. The timings are printed as JSON. See doc/BUILD_FROM_SOURCE.md for how to build the tool.
+ */
+
+
+#include "l2a_compile_core.h"
+#include "l2a_document_footprint.h"
+#include "l2a_document_model.h"
+#include "l2a_invalidation.h"
+#include "l2a_links_folder.h"
+#include "l2a_redo_plan.h"
+#include "l2a_spatial_index.h"
+
+#include "json.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+
+/**
+ * \brief Options of the command line tool.
+ */
+struct ScaleOptions
+{
+    //! Numbers of LaTeX2AI items in the documents.
+    std::vector<size_t> sizes_ = {1000, 10000, 100000};
+
+    //! Number of other placed items per LaTeX2AI item.
+    double other_items_fraction_ = 0.1;
+
+    //! Number of different LaTeX codes per LaTeX2AI item.
+    double codes_fraction_ = 0.5;
+
+    //! Size of the encoded pdf file stored in each item.
+    size_t payload_size_ = 0;
+
+    //! Directory for the linked pdf files, if this is empty the files are not created.
+    std::filesystem::path output_directory_;
+};
+
+/**
+ * \brief Print the usage of the tool.
+ */
+void PrintUsage()
+{
+    std::cerr << "Usage: l2a-scale [options]\n"
+                 "\n"
+                 "Time the document level functions of LaTeX2AI on synthetic documents and print the timings as JSON.\n"
+                 "\n"
+                 "Options:\n"
+                 "  --sizes <sizes>        Comma separated numbers of LaTeX2AI items (default: 1000,10000,100000)\n"
+                 "  --other <fraction>     Other placed items per LaTeX2AI item (default: 0.1)\n"
+                 "  --codes <fraction>     Different LaTeX codes per LaTeX2AI item (default: 0.5)\n"
+                 "  --payload <bytes>      Size of the random pdf data stored in the note of each item (default: 0)\n"
+                 "  --output <directory>   Create the linked pdf files and the manifest in this directory, so the\n"
+                 "                         check of the linked files accesses the file system as in the plugin\n";
+}
+
+/**
+ * \brief Parse the command line arguments.
+ */
+bool ParseArguments(int argc, char* argv[], ScaleOptions& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argument = argv[i];
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for " << argument << "\n";
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (argument == "--sizes")
+        {
+            options.sizes_.clear();
+            std::stringstream sizes(value);
+            std::string size;
+            while (std::getline(sizes, size, ','))
+            {
+                const long n_items = std::atol(size.c_str());
+                if (n_items <= 0)
+                {
+                    std::cerr << "Invalid document size " << size << "\n";
+                    return false;
+                }
+                options.sizes_.push_back((size_t)n_items);
+            }
+        }
+        else if (argument == "--other")
+            options.other_items_fraction_ = std::atof(value.c_str());
+        else if (argument == "--codes")
+            options.codes_fraction_ = std::atof(value.c_str());
+        else if (argument == "--payload")
+            options.payload_size_ = (size_t)std::max(0L, std::atol(value.c_str()));
+        else if (argument == "--output")
+            options.output_directory_ = std::filesystem::u8path(value);
+        else
+        {
+            std::cerr << "Unknown option " << argument << "\n";
+            return false;
+        }
+    }
+    return !options.sizes_.empty() && options.other_items_fraction_ >= 0.0 && options.codes_fraction_ > 0.0;
+}
+
+/**
+ * \brief Get the elapsed time in seconds since a time point.
+ */
+double GetElapsedTime(const std::chrono::steady_clock::time_point& start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * \brief Get the states of the items as they are drawn by the annotator. As in the plugin, the note of each item is
+ * parsed to get the values of the item that change the drawing.
+ */
+std::vector<L2A::UTIL::DrawnItemState> GetItemStates(
+    const L2A::UTIL::DocumentModel& document, const std::vector<AIArtHandle>& items)
+{
+    std::vector<L2A::UTIL::DrawnItemState> states;
+    states.reserve(items.size());
+    for (const auto& item : items)
+    {
+        L2A::UTIL::RedoPlanItem item_data;
+        L2A::UTIL::ReadItemXML(document.GetNote(item), item_data);
+
+        const auto geometry = document.GetGeometry(item);
+        bool is_hidden;
+        bool is_locked;
+        document.GetIsHiddenLocked(item, is_hidden, is_locked);
+        states.push_back(L2A::UTIL::CreateDrawnItemState(
+            item, geometry, L2A::UTIL::GetPlacementPoints(geometry), is_hidden, is_locked));
+        states.back().values_.push_back(item_data.is_baseline_ ? 1.0 : 0.0);
+    }
+    return states;
+}
+
+/**
+ * \brief Create the pdf files of the items in the links directory and add them to the manifest, as if the document
+ * was checked before.
+ */
+void CreateLinkedFiles(const L2A::UTIL::FakeDocument& document, const std::vector<AIArtHandle>& items,
+    const std::filesystem::path& links_directory, L2A::UTIL::LinksManifest& manifest)
+{
+    std::filesystem::create_directories(links_directory);
+    for (const auto& item : items)
+    {
+        const std::filesystem::path pdf_path = document.GetPlacedItemPath(item);
+        const std::string pdf_name = pdf_path.filename().u8string();
+        std::string hash;
+        L2A::UTIL::ReadItemPDFFileHash(document.GetNote(item), hash);
+        if (manifest.GetEntries().count(pdf_name) > 0) continue;
+
+        std::ofstream(pdf_path, std::ios::binary) << hash;
+        manifest.Update(pdf_name, hash, L2A::UTIL::GetDataContentHash(hash.c_str(), hash.size()));
+    }
+}
+
+/**
+ * \brief Time the document level functions for one document.
+ */
+nlohmann::json RunScale(const ScaleOptions& options, const size_t n_items)
+{
+    nlohmann::json timings;
+    nlohmann::json calls;
+    const auto start_create = std::chrono::steady_clock::now();
+
+    L2A::UTIL::SyntheticDocumentOptions document_options;
+    document_options.n_items_ = n_items;
+    document_options.n_other_items_ = (size_t)(options.other_items_fraction_ * (double)n_items);
+    document_options.n_codes_ = std::max((size_t)1, (size_t)(options.codes_fraction_ * (double)n_items));
+    document_options.payload_size_ = options.payload_size_;
+    if (!options.output_directory_.empty())
+        document_options.links_directory_ =
+            std::filesystem::absolute(options.output_directory_) / ("links_" + std::to_string(n_items));
+    L2A::UTIL::FakeDocument document;
+    L2A::UTIL::CreateSyntheticDocument(document, document_options);
+    timings["create_document"] = GetElapsedTime(start_create);
+
+    // Find the LaTeX2AI items, this is done for most events in the plugin.
+    document.ResetCallCount();
+    auto start = std::chrono::steady_clock::now();
+    std::vector<AIArtHandle> items;
+    L2A::UTIL::GetDocumentItems(document, items, L2A::UTIL::ArtSelection::all, document_options.item_name_);
+    timings["find_items"] = GetElapsedTime(start);
+    calls["find_items"] = document.GetCallCount();
+
+    // States of the items and the spatial index, this is done by the annotator after each selection change.
+    document.ResetCallCount();
+    start = std::chrono::steady_clock::now();
+    std::vector<L2A::UTIL::DrawnItemState> states = GetItemStates(document, items);
+    std::vector<AIRealRect> boxes;
+    boxes.reserve(states.size());
+    for (const auto& state : states) boxes.push_back(state.bounds_);
+    L2A::UTIL::SpatialIndex index;
+    index.Build(boxes);
+    timings["annotator_states"] = GetElapsedTime(start);
+    calls["annotator_states"] = document.GetCallCount();
+
+    // Hit test at the placement points of all items, this is done for each mouse move of the tool.
+    start = std::chrono::steady_clock::now();
+    size_t n_hits = 0;
+    for (const auto& state : states)
+        n_hits += index.QueryPoint({state.bounds_.left, state.bounds_.bottom}, 1.0).size();
+    timings["hit_test"] = GetElapsedTime(start);
+
+    // Move one percent of the items and get the parts of the document that have to be redrawn.
+    for (size_t i_item = 0; i_item < items.size(); i_item += 100)
+    {
+        AIRealRect& bounds = document.GetArtMutable(items[i_item]).bounds_;
+        bounds.left += 5.0;
+        bounds.right += 5.0;
+    }
+    document.ResetCallCount();
+    start = std::chrono::steady_clock::now();
+    std::vector<L2A::UTIL::DrawnItemState> new_states = GetItemStates(document, items);
+    const auto changed_bounds = L2A::UTIL::GetChangedBounds(states, new_states, 0.002, 16);
+    timings["invalidation"] = GetElapsedTime(start);
+    calls["invalidation"] = document.GetCallCount();
+
+    // Plan the redo of all items.
+    document.ResetCallCount();
+    start = std::chrono::steady_clock::now();
+    std::vector<L2A::UTIL::RedoPlanItem> plan_items(items.size());
+    for (size_t i_item = 0; i_item < items.size(); i_item++)
+        L2A::UTIL::ReadItemXML(document.GetNote(items[i_item]), plan_items[i_item]);
+    const L2A::UTIL::RedoPlan redo_plan = L2A::UTIL::CreateRedoPlan(plan_items);
+    timings["redo_plan"] = GetElapsedTime(start);
+    calls["redo_plan"] = document.GetCallCount();
+
+    // Check the linked pdf files of all items, this is done when a document is opened or saved.
+    L2A::UTIL::LinksManifest manifest(document_options.links_directory_ / "LaTeX2AI_manifest.txt");
+    if (!options.output_directory_.empty())
+        CreateLinkedFiles(document, items, document_options.links_directory_, manifest);
+    document.ResetCallCount();
+    start = std::chrono::steady_clock::now();
+    std::vector<L2A::UTIL::ItemLinkState> link_states;
+    link_states.reserve(items.size());
+    for (const auto& item : items)
+    {
+        std::string hash;
+        L2A::UTIL::ReadItemPDFFileHash(document.GetNote(item), hash);
+        const std::string pdf_name = document_options.document_name_ + document_options.pdf_item_post_fix_ + hash +
+                                     ".pdf";
+        const std::filesystem::path pdf_path = document_options.links_directory_ / pdf_name;
+        link_states.push_back({pdf_name, hash, document.GetPlacedItemPath(item) == pdf_path});
+    }
+    const L2A::UTIL::ItemLinksPlan links_plan = L2A::UTIL::CreateItemLinksPlan(manifest, link_states);
+    timings["links_plan"] = GetElapsedTime(start);
+    calls["links_plan"] = document.GetCallCount();
+
+    // Analyze the data stored in the items.
+    document.ResetCallCount();
+    start = std::chrono::steady_clock::now();
+    const L2A::UTIL::DocumentFootprint footprint =
+        L2A::UTIL::AnalyzeDocumentFootprint(document, document_options.item_name_);
+    timings["footprint"] = GetElapsedTime(start);
+    calls["footprint"] = document.GetCallCount();
+
+    nlohmann::json result;
+    result["n_items"] = items.size();
+    result["n_art"] = document.Size();
+    result["time"] = timings;
+    result["document_calls"] = calls;
+    result["n_hits"] = n_hits;
+    result["n_changed_rects"] = changed_bounds.size();
+    result["n_compile_items"] = redo_plan.compile_items_.size();
+    result["n_write_items"] = links_plan.write_items_.size();
+    result["n_relink_items"] = links_plan.relink_items_.size();
+    result["note_size"] = footprint.note_size_;
+    result["deduplication_savings"] = footprint.deduplication_savings_;
+    return result;
+}
+
+/**
+ * \brief Main function of the command line tool.
+ */
+int main(int argc, char* argv[])
+{
+    ScaleOptions options;
+    if (!ParseArguments(argc, argv, options))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    nlohmann::json results = nlohmann::json::array();
+    for (const size_t n_items : options.sizes_) results.push_back(RunScale(options, n_items));
+    std::cout << results.dump(4) << "\n";
+    return 0;
+}
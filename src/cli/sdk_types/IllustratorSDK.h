@@ -0,0 +1,76 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Stand-in for the Illustrator SDK header with the plain data types used by the portable utilities.
+ *
+ * The geometry, invalidation, spatial index and document model utilities only use these types from the SDK. With this
+ * header they can be built without the Illustrator SDK for the l2a-scale command line tool. It must not be used for the
+ * plugin. As the SDK header, it includes the standard headers the utilities rely on.
+ */
+
+#ifndef CLI_ILLUSTRATOR_SDK_H_
+#define CLI_ILLUSTRATOR_SDK_H_
+
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace ai
+{
+    typedef std::int16_t int16;
+    typedef std::int32_t int32;
+    typedef std::uint16_t uint16;
+}  // namespace ai
+
+typedef double AIReal;
+typedef double ASReal;
+
+struct AIRealPoint
+{
+    AIReal h, v;
+};
+
+struct AIRealRect
+{
+    AIReal left, top, right, bottom;
+};
+
+struct AIRealMatrix
+{
+    AIReal a, b, c, d, tx, ty;
+};
+
+struct AIRGBColor
+{
+    ai::uint16 red, green, blue;
+};
+
+typedef struct ArtObject* AIArtHandle;
+
+#endif
@@ -32,8 +32,14 @@
 #include "l2a_annotator.h"
 
 #include "l2a_ai_functions.h"
+#include "l2a_constants.h"
+#include "l2a_document_model.h"
 #include "l2a_error.h"
 #include "l2a_item.h"
+#include "l2a_math.h"
+
+#include <algorithm>
+#include <array>
 
 
 /**
@@ -57,8 +63,41 @@ L2A::Annotator::Annotator(SPInterfaceMessage* message) : cursor_item_(nullptr)
  */
 void L2A::Annotator::ArtSelectionChanged()
 {
-    // Reset the item vector.
+    // Keep the states of the drawn items, to compare them with the reloaded ones.
+    std::vector<L2A::UTIL::DrawnItemState> old_item_states = std::move(item_states_);
+    ReloadItems();
+    invalidation_statistics_.n_events_++;
+    invalidation_statistics_.last_event_area_ = 0.0;
+
+    // If the annotator is inactive nothing is drawn, so nothing has to be invalidated.
+    if (!IsActive())
+    {
+        invalidation_statistics_.n_skipped_events_++;
+        return;
+    }
+
+    // Only invalidate the parts of the view where items were added, removed or changed.
+    const auto changed_bounds = L2A::UTIL::GetChangedBounds(
+        old_item_states, item_states_, L2A::CONSTANTS::eps_pos_, max_invalidation_rects_);
+    if (changed_bounds.size() == 0) invalidation_statistics_.n_skipped_events_++;
+    for (const auto& bounds : changed_bounds)
+        invalidation_statistics_.last_event_area_ += InvalAnnotationItemBounds(bounds);
+    invalidation_statistics_.n_rects_ += changed_bounds.size();
+    invalidation_statistics_.total_area_ += invalidation_statistics_.last_event_area_;
+}
+
+/**
+ *
+ */
+void L2A::Annotator::ReloadItems()
+{
+    // Reset the item vectors.
     item_vector_.clear();
+    item_geometry_.clear();
+    item_points_h_.clear();
+    item_points_v_.clear();
+    item_index_.Clear();
+    item_states_.clear();
 
     // Only do something if the annotator is active.
     if (!IsActive())
@@ -68,32 +107,47 @@ void L2A::Annotator::ArtSelectionChanged()
         // Get all l2a items in the document.
         std::vector<AIArtHandle> all_items;
         L2A::AI::GetDocumentItems(all_items, L2A::AI::SelectionState::all);
+        item_vector_.reserve(all_items.size());
+        item_geometry_.reserve(all_items.size());
+        item_points_h_.reserve(n_placements_ * all_items.size());
+        item_points_v_.reserve(n_placements_ * all_items.size());
+        std::vector<AIRealRect> item_boxes;
+        item_boxes.reserve(all_items.size());
+        item_states_.reserve(all_items.size());
+        const L2A::AI::Document document;
         for (auto& item : all_items)
         {
             // Create item object.
             L2A::Item new_item(item);
 
             // Get all coordinates of the item.
-            std::vector<PlaceAlignment> placements;
-            placements.push_back(PlaceAlignment::kTopLeft);
-            placements.push_back(PlaceAlignment::kTopMid);
-            placements.push_back(PlaceAlignment::kTopRight);
-            placements.push_back(PlaceAlignment::kMidLeft);
-            placements.push_back(PlaceAlignment::kMidMid);
-            placements.push_back(PlaceAlignment::kMidRight);
-            placements.push_back(PlaceAlignment::kBotLeft);
-            placements.push_back(PlaceAlignment::kBotMid);
-            placements.push_back(PlaceAlignment::kBotRight);
-            std::vector<AIRealPoint> item_points = new_item.GetPosition(placements);
-
-            // Fill up the map.
-            std::map<PlaceAlignment, AIRealPoint> item_boundaries;
-            for (unsigned int i_placement = 0; i_placement < placements.size(); i_placement++)
-                item_boundaries[placements[i_placement]] = item_points[i_placement];
+            const auto geometry = new_item.GetGeometry();
+            const auto item_points = L2A::UTIL::GetPlacementPoints(geometry);
+            for (const auto& point : item_points)
+            {
+                item_points_h_.push_back(point.h);
+                item_points_v_.push_back(point.v);
+            }
+
+            // Store all values that change the drawing of the item.
+            bool is_hidden;
+            bool is_locked;
+            document.GetIsHiddenLocked(item, is_hidden, is_locked);
+            const auto& property = new_item.GetProperty();
+            L2A::UTIL::DrawnItemState state =
+                L2A::UTIL::CreateDrawnItemState(item, geometry, item_points, is_hidden, is_locked);
+            state.values_.push_back(property.IsBaseline() ? 1.0 : 0.0);
+            state.values_.push_back((AIReal)property.GetAIAlignment());
+            item_boxes.push_back(state.bounds_);
+            item_states_.push_back(std::move(state));
 
             // Add to the item vetor.
-            item_vector_.push_back(std::make_pair(new_item, item_boundaries));
+            item_vector_.push_back(new_item);
+            item_geometry_.push_back(geometry);
         }
+
+        // Build the spatial index for hit tests and culling.
+        item_index_.Build(item_boxes);
     }
 }
 
@@ -119,7 +173,7 @@ void L2A::Annotator::SetAnnotatorWithInvalidateBounds(bool active)
     // This only makes sense if an Illustrator document is opened.
     if (L2A::AI::GetDocumentCount() > 0)
     {
-        ArtSelectionChanged();
+        ReloadItems();
         InvalAnnotation();
     }
 }
@@ -153,6 +207,15 @@ bool L2A::Annotator::CheckForArtHit(AIToolMessage* message)
     // This function can only be called if the annotator is active.
     if (!IsActive()) l2a_error("Annotator has to be active.");
 
+    // The hit test of Illustrator checks all art in the document. This is only done if the cursor is close to one of
+    // the cached items. The tolerance is the radius of the drawn placement point in view coordinates.
+    const AIReal tolerance = L2A::CONSTANTS::radius_ / L2A::AI::GetDocumentViewZoom();
+    if (item_index_.QueryPoint(message->cursor, tolerance).size() == 0)
+    {
+        cursor_item_ = nullptr;
+        return false;
+    }
+
     // Check if cursor is over any art.
     AIHitRef hitRef = nullptr;
     AIToolHitData toolHitData;
@@ -183,8 +246,64 @@ void L2A::Annotator::Draw(AIAnnotatorMessage* message) const
     // This can only be called when the annotator is active.
     if (!IsActive()) l2a_error("The annotator has to be active.");
 
+    // Only draw the items that intersect the area that has to be redrawn. The update rectangle is enlarged, so that
+    // the placement point and the line width are also taken into account.
+    AIRect update_rect = message->updateRect;
+    if (update_rect.left >= update_rect.right || update_rect.top >= update_rect.bottom)
+    {
+        std::vector<size_t> all_item_ids(item_vector_.size());
+        for (size_t i = 0; i < all_item_ids.size(); i++) all_item_ids[i] = i;
+        DrawItems(message, all_item_ids);
+        return;
+    }
+    const int view_tolerance = L2A::CONSTANTS::radius_ + L2A::CONSTANTS::line_width_;
+    update_rect.left -= view_tolerance;
+    update_rect.top -= view_tolerance;
+    update_rect.right += view_tolerance;
+    update_rect.bottom += view_tolerance;
+    const AIRealRect update_bounds = L2A::AI::ViewBoundsToArtworkBounds(update_rect);
+
+    DrawItems(message, item_index_.QueryRect(update_bounds));
+}
+
+/**
+ *
+ */
+void L2A::Annotator::DrawItems(AIAnnotatorMessage* message, const std::vector<size_t>& item_ids) const
+{
+    if (item_ids.size() == 0) return;
+
+    // Collect the placement points of all items that are drawn.
+    const size_t n_points = n_placements_ * item_ids.size();
+    std::vector<AIReal> points_h(n_points);
+    std::vector<AIReal> points_v(n_points);
+    for (size_t i = 0; i < item_ids.size(); i++)
+    {
+        std::copy_n(&item_points_h_[n_placements_ * item_ids[i]], n_placements_, &points_h[n_placements_ * i]);
+        std::copy_n(&item_points_v_[n_placements_ * item_ids[i]], n_placements_, &points_v[n_placements_ * i]);
+    }
+
+    // The transformation to the view is the same for all points, so it is only fetched once and applied to all points
+    // at once.
+    const AIRealMatrix artwork_to_view = L2A::AI::GetArtworkToViewTransformation();
+    std::vector<AIReal> view_points_h(n_points);
+    std::vector<AIReal> view_points_v(n_points);
+    L2A::UTIL::MATH::TransformPoints(
+        artwork_to_view, n_points, points_h.data(), points_v.data(), view_points_h.data(), view_points_v.data());
+
     // Loop over items and draw boundary.
-    for (const auto& item : item_vector_) std::get<0>(item).Draw(message, std::get<1>(item));
+    std::array<AIPoint, n_placements_> item_view_points;
+    for (size_t i = 0; i < item_ids.size(); i++)
+    {
+        for (size_t i_placement = 0; i_placement < n_placements_; i_placement++)
+        {
+            item_view_points[i_placement].h =
+                L2A::UTIL::MATH::RoundToInteger(view_points_h[n_placements_ * i + i_placement]);
+            item_view_points[i_placement].v =
+                L2A::UTIL::MATH::RoundToInteger(view_points_v[n_placements_ * i + i_placement]);
+        }
+        item_vector_[item_ids[i]].Draw(message, item_view_points, item_geometry_[item_ids[i]]);
+    }
 }
 
 /**
@@ -213,3 +332,25 @@ void L2A::Annotator::InvalAnnotation() const
     // Invalidate the rect bounds so it is redrawn.
     InvalAnnotation(view_bounds);
 }
+
+/**
+ *
+ */
+AIReal L2A::Annotator::InvalAnnotationItemBounds(const AIRealRect& artwork_bounds) const
+{
+    // Get the rectangle to invalidate, enlarged by the drawn placement point and the line width.
+    AIRect inval_rect = L2A::AI::ArtworkBoundsToViewBounds(artwork_bounds);
+    const int view_tolerance = L2A::CONSTANTS::radius_ + L2A::CONSTANTS::line_width_;
+    inval_rect.left -= view_tolerance;
+    inval_rect.top -= view_tolerance;
+    inval_rect.right += view_tolerance;
+    inval_rect.bottom += view_tolerance;
+
+    // Invalidate the rect bounds so it is redrawn.
+    AIErr result = sAIAnnotator->InvalAnnotationRect(nullptr, &inval_rect);
+    l2a_check_ai_error(result);
+
+    const AIRealRect inval_bounds = {
+        (AIReal)inval_rect.left, (AIReal)inval_rect.top, (AIReal)inval_rect.right, (AIReal)inval_rect.bottom};
+    return L2A::UTIL::GetRectArea(inval_bounds);
+}
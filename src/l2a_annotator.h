@@ -31,9 +31,12 @@
 #define L2A_ANNOTATOR_H_
 
 
+#include "l2a_geometry.h"
+#include "l2a_invalidation.h"
+#include "l2a_spatial_index.h"
 #include "l2a_suites.h"
 
-#include <map>
+#include <vector>
 
 // Forward declaration.
 namespace L2A
@@ -57,7 +60,7 @@ namespace L2A
 
         /**
          * \brief This method is called when the art selection changed. If the annotator is active, the items are
-         * reloaded.
+         * reloaded and the parts of the view where the drawn items changed are invalidated.
          */
         void ArtSelectionChanged();
 
@@ -111,12 +114,40 @@ namespace L2A
          */
         void InvalAnnotation() const;
 
+        /**
+         * \brief Get the statistics of the invalidations due to changed items.
+         */
+        const L2A::UTIL::InvalidationStatistics& GetInvalidationStatistics() const { return invalidation_statistics_; }
+
        private:
         /**
          * \brief Set the annotator inactive.
          */
         void SetAnnotator(bool active);
 
+        /**
+         * \brief Reload the items from the document. If the annotator is inactive, the items are only cleared.
+         */
+        void ReloadItems();
+
+        /**
+         * \brief Invalidate the artwork bounds of an item, including the drawn placement point and line width.
+         * @return The invalidated area in view coordinates.
+         */
+        AIReal InvalAnnotationItemBounds(const AIRealRect& artwork_bounds) const;
+
+        /**
+         * \brief Draw the boundaries of the given items.
+         */
+        void DrawItems(AIAnnotatorMessage* message, const std::vector<size_t>& item_ids) const;
+
+       private:
+        //! Number of placement points stored for each item.
+        static constexpr size_t n_placements_ = 9;
+
+        //! Maximum number of rectangles that are invalidated separately after a change of the items.
+        static constexpr size_t max_invalidation_rects_ = 32;
+
        private:
         //! Handle for the annotator added by this plug-in.
         AIAnnotatorHandle annotator_handle_;
@@ -124,9 +155,25 @@ namespace L2A
         //! Item the cursor is over.
         AIArtHandle cursor_item_;
 
-        //! Vector of items. The items are stored in pairs, where the second pair entry are all positions of the
-        //! bounding box.
-        std::vector<std::pair<L2A::Item, std::map<PlaceAlignment, AIRealPoint>>> item_vector_;
+        //! Vector of items.
+        std::vector<L2A::Item> item_vector_;
+
+        //! Geometry snapshots of the items.
+        std::vector<L2A::UTIL::GeometrySnapshot> item_geometry_;
+
+        //! Artwork coordinates of the placement points of all items. For each item there are n_placements_ entries,
+        //! ordered as in the PlaceAlignment enum.
+        std::vector<AIReal> item_points_h_;
+        std::vector<AIReal> item_points_v_;
+
+        //! Spatial index over the bounding boxes of the items in item_vector_.
+        L2A::UTIL::SpatialIndex item_index_;
+
+        //! Drawn states of the items in item_vector_, used to find the parts of the view that have to be redrawn.
+        std::vector<L2A::UTIL::DrawnItemState> item_states_;
+
+        //! Statistics of the invalidations due to changed items.
+        L2A::UTIL::InvalidationStatistics invalidation_statistics_;
     };
 }  // namespace L2A
 
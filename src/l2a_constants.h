@@ -83,6 +83,10 @@ namespace L2A
 
         //! Color for diamond bounding box.
         static const AIRGBColor color_diamond_ = {65000, 0, 0};
+
+        //! I/O budget of the background links maintenance.
+        static const size_t links_maintenance_bytes_per_second_ = 8 * 1024 * 1024;
+        static const size_t links_maintenance_files_per_second_ = 200;
     }  // namespace CONSTANTS
 }  // namespace L2A
 
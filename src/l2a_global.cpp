@@ -40,6 +40,7 @@
 #include "l2a_parameter_list.h"
 #include "l2a_plugin.h"
 #include "l2a_string_functions.h"
+#include "l2a_trace.h"
 #include "l2a_version.h"
 
 /**
@@ -101,6 +102,9 @@ L2A::GLOBAL::Global::Global() : is_testing_(false)
     // Clean the temporary directory.
     L2A::UTIL::ClearTemporaryDirectory();
 
+    // Start recording the trace spans if it is enabled.
+    L2A::UTIL::GetTraceBuffer().SetEnabled(trace_pipeline_);
+
     // We are now at a stage where we have the variables for gs and latex, either from the default parameters or from
     // the settings file. In either case we now do some basic checks if the paths are correct. If they are not we try to
     // find them automatically.
@@ -142,7 +146,10 @@ void L2A::GLOBAL::Global::ToParameterList(std::shared_ptr<L2A::UTIL::ParameterLi
     parameter_list->SetOption(ai::UnicodeString("latex_engine"), latex_engine_);
     parameter_list->SetOption(ai::UnicodeString("latex_command_options"), latex_command_options_);
     parameter_list->SetOption(ai::UnicodeString("gs_command"), gs_command_);
+    parameter_list->SetOption(ai::UnicodeString("watch_header"), watch_header_);
+    parameter_list->SetOption(ai::UnicodeString("trace_pipeline"), trace_pipeline_);
     parameter_list->SetOption(ai::UnicodeString("item_ui_finish_on_enter"), item_ui_finish_on_enter_);
+    parameter_list->SetOption(ai::UnicodeString("check_latex_syntax"), check_latex_syntax_);
     parameter_list->SetOption(ai::UnicodeString("warning_boundary_boxes"), warning_boundary_boxes_);
     parameter_list->SetOption(ai::UnicodeString("warning_ai_not_saved"), warning_ai_not_saved_);
 }
@@ -157,7 +164,10 @@ void L2A::GLOBAL::Global::GetDefaultParameterList(std::shared_ptr<L2A::UTIL::Par
     parameter_list->SetOption(ai::UnicodeString("latex_command_options"),
         ai::UnicodeString("-interaction nonstopmode -halt-on-error -file-line-error"));
     parameter_list->SetOption(ai::UnicodeString("gs_command"), ai::UnicodeString(""));
+    parameter_list->SetOption(ai::UnicodeString("watch_header"), false);
+    parameter_list->SetOption(ai::UnicodeString("trace_pipeline"), false);
     parameter_list->SetOption(ai::UnicodeString("item_ui_finish_on_enter"), false);
+    parameter_list->SetOption(ai::UnicodeString("check_latex_syntax"), true);
     parameter_list->SetOption(ai::UnicodeString("warning_boundary_boxes"), true);
     parameter_list->SetOption(ai::UnicodeString("warning_ai_not_saved"), true);
 }
@@ -221,8 +231,14 @@ bool L2A::GLOBAL::Global::SetFromParameterList(const L2A::UTIL::ParameterList& p
         {ai::UnicodeString("latex_command_options"), ai::UnicodeString("command_latex_options")}, set_all);
     set_all = set_variable_from_keys_default(
         gs_command_, {ai::UnicodeString("gs_command"), ai::UnicodeString("command_gs")}, set_all);
+    set_all = set_variable_from_keys(
+        watch_header_, {ai::UnicodeString("watch_header")}, set_all, conversion_bool);
+    set_all = set_variable_from_keys(
+        trace_pipeline_, {ai::UnicodeString("trace_pipeline")}, set_all, conversion_bool);
     set_all = set_variable_from_keys(
         item_ui_finish_on_enter_, {ai::UnicodeString("item_ui_finish_on_enter")}, set_all, conversion_bool);
+    set_all = set_variable_from_keys(
+        check_latex_syntax_, {ai::UnicodeString("check_latex_syntax")}, set_all, conversion_bool);
     set_all = set_variable_from_keys(
         warning_boundary_boxes_, {ai::UnicodeString("warning_boundary_boxes")}, set_all, conversion_bool);
     set_all = set_variable_from_keys(
@@ -112,10 +112,20 @@ namespace L2A
             //! Command for ghostscript in the shell.
             ai::UnicodeString gs_command_;
 
+            //! Flag if the header is watched and stale items are compiled in the background when it changes.
+            bool watch_header_;
+
+            //! Flag if the stages of the item pipeline are traced, the trace is written to the application data
+            //! directory.
+            bool trace_pipeline_;
+
             //! Flag if item UI form can be finished by pressing Enter
             //! If this is false, it can be finished by pressing Shift+Enter
             bool item_ui_finish_on_enter_;
 
+            //! Flag if the LaTeX code of items is checked for syntax errors before it is compiled.
+            bool check_latex_syntax_;
+
             //! Flag for warning if ai file is not saved.
             bool warning_ai_not_saved_;
 
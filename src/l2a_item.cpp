@@ -32,20 +32,114 @@
 #include "l2a_item.h"
 
 #include "l2a_ai_functions.h"
+#include "l2a_background_compile.h"
+#include "l2a_compile_core.h"
 #include "l2a_constants.h"
+#include "l2a_document_model.h"
+#include "l2a_encoded_file_writer.h"
 #include "l2a_error.h"
 #include "l2a_file_system.h"
 #include "l2a_global.h"
 #include "l2a_latex.h"
+#include "l2a_latex_syntax.h"
+#include "l2a_links_folder.h"
+#include "l2a_links_maintenance.h"
 #include "l2a_math.h"
+#include "l2a_metrics.h"
 #include "l2a_names.h"
 #include "l2a_parameter_list.h"
 #include "l2a_plugin.h"
 #include "l2a_string_functions.h"
 #include "l2a_suites.h"
+#include "l2a_trace.h"
 #include "l2a_ui_manager.h"
 #include "l2a_utils.h"
 
+#include <set>
+#include <unordered_set>
+
+
+/**
+ * \brief Get the path to the manifest file of a links folder.
+ */
+std::filesystem::path GetLinksManifestPath(const ai::FilePath& pdf_file_directory)
+{
+    return L2A::UTIL::FilePathAiToStd(pdf_file_directory) / L2A::NAMES::links_manifest_name_;
+}
+
+/**
+ * \brief Save the encoded pdf files of multiple items. The files are decoded and written in parallel, the manifest
+ * is updated on the main thread. Items with the same pdf path share the file, it is only written once.
+ */
+void SaveEncodedPDFFiles(const std::vector<const L2A::Item*>& items, const std::vector<ai::FilePath>& pdf_paths,
+    L2A::UTIL::LinksManifest& manifest)
+{
+    // Everything that needs the Illustrator suites is done before the files are written in parallel. Each path is
+    // only written by one thread.
+    std::vector<L2A::UTIL::EncodedFileWrite> files;
+    std::vector<size_t> file_items;
+    std::set<std::filesystem::path> paths;
+    std::set<std::filesystem::path> directories;
+    for (size_t i_item = 0; i_item < items.size(); i_item++)
+    {
+        L2A::UTIL::EncodedFileWrite file;
+        file.path_ = L2A::UTIL::FilePathAiToStd(pdf_paths[i_item]);
+        if (!paths.insert(file.path_).second) continue;
+        file.encoded_contents_ = L2A::UTIL::StringAiToStd(items[i_item]->GetProperty().GetPDFFileContents());
+        directories.insert(file.path_.parent_path());
+        files.push_back(std::move(file));
+        file_items.push_back(i_item);
+    }
+    for (const auto& directory : directories)
+        if (!std::filesystem::is_directory(directory)) std::filesystem::create_directories(directory);
+
+    L2A::UTIL::WriteEncodedFiles(files, L2A::UTIL::GetEncodedFileWriteThreadCount());
+
+    for (size_t i_file = 0; i_file < files.size(); i_file++)
+    {
+        const L2A::Item& item = *items[file_items[i_file]];
+        if (files[i_file].is_written_)
+        {
+            manifest.Update(files[i_file].path_.filename().u8string(),
+                L2A::UTIL::StringAiToStd(item.GetProperty().GetPDFFileHash()), files[i_file].content_hash_);
+        }
+        else
+        {
+            // Write the file on the main thread, this also raises the error if it can not be written.
+            item.SaveEncodedPDFFile(pdf_paths[file_items[i_file]], manifest);
+        }
+    }
+}
+
+/**
+ * \brief Get the compile digest the items are compared to in a redo plan.
+ */
+ai::UnicodeString GetRedoPlanCompileDigest()
+{
+    // Without a saved document there is no header, so no item can be up to date.
+    if (!L2A::UTIL::IsFile(L2A::UTIL::GetDocumentPath(false))) return ai::UnicodeString("");
+    return L2A::LATEX::GetCompileDigest();
+}
+
+/**
+ * \brief Get the data of the items needed to plan a redo of the items.
+ */
+std::vector<L2A::UTIL::RedoPlanItem> CreateRedoPlanItems(const std::vector<L2A::Item>& l2a_items)
+{
+    const ai::UnicodeString compile_digest = GetRedoPlanCompileDigest();
+
+    std::vector<L2A::UTIL::RedoPlanItem> plan_items(l2a_items.size());
+    for (size_t i_item = 0; i_item < l2a_items.size(); i_item++)
+    {
+        const L2A::Property& property = l2a_items[i_item].GetProperty();
+        plan_items[i_item].latex_code_ = L2A::UTIL::StringAiToStd(property.GetLaTeXCode());
+        plan_items[i_item].is_baseline_ = property.IsBaseline();
+        plan_items[i_item].is_up_to_date_ = !compile_digest.empty() && !property.GetPDFFileHash().empty() &&
+                                            !property.IsStale(compile_digest);
+        plan_items[i_item].compile_time_ = property.GetCompileTime();
+    }
+    return plan_items;
+}
 
 /**
  *
@@ -60,9 +154,10 @@ L2A::Item::Item(const AIRealPoint& position, const L2A::Property& property, cons
     // Store the pdf data in the property
     property_.SetPDFFile(created_pdf_file);
 
-    // Save the pdf in the pdf folder
+    // Save the pdf in the pdf folder, the manifest of the folder is written once the item is created.
     const auto pdf_file = GetPDFPath();
-    SaveEncodedPDFFile(pdf_file);
+    L2A::UTIL::LinksManifest manifest(GetLinksManifestPath(pdf_file.GetParent()));
+    SaveEncodedPDFFile(pdf_file, manifest);
 
     // Create the placed item
     placed_item_ = L2A::AI::CreatePlacedItem(pdf_file);
@@ -73,6 +168,7 @@ L2A::Item::Item(const AIRealPoint& position, const L2A::Property& property, cons
 
     // Move the file to the cursor position
     MoveItem(position);
+    manifest.Write();
 
     // Everything was successful, we write the input from this item to the application directory, so we can use it with
     // the next one.
@@ -166,21 +262,30 @@ L2A::ItemChangeResult L2A::Item::Change(const ai::UnicodeString& form_return_val
             // TODO: this works, but it is very strange what we copy around here, this should be improved
             // PDF could be created, now store the pdf file in the placed item
             new_property.SetPDFFile(pdf_file);
+            new_property.SetCompileDigest(latex_creation_result.compile_digest_);
+            new_property.SetCompileTime(latex_creation_result.compile_times_[0]);
             GetPropertyMutable() = new_property;
             pdf_file = GetPDFPath();
-            SaveEncodedPDFFile(pdf_file);
+            L2A::UTIL::LinksManifest manifest(GetLinksManifestPath(pdf_file.GetParent()));
+            SaveEncodedPDFFile(pdf_file, manifest);
 
             // Relink the placed item with the new pdf file
             L2A::AI::RelinkPlacedItem(GetPlacedItemMutable(), pdf_file);
 
             // Redo the boundary
             RedoBoundary();
+            manifest.Write();
         }
         else if (latex_creation_result.result_ == L2A::LATEX::LatexCreationResult::Result::error_tex_code)
         {
             // The LaTeX call worked, but the LaTeX code resulted in errors -> ask the user to fix the code
             return ItemChangeResult{ItemChangeResult::Result::latex_error, latex_creation_result};
         }
+        else if (latex_creation_result.result_ == L2A::LATEX::LatexCreationResult::Result::error_syntax)
+        {
+            // The LaTeX code was not compiled, the error is shown in the item form
+            return ItemChangeResult{ItemChangeResult::Result::syntax_error, latex_creation_result};
+        }
         else
         {
             // An error occurred that is not caused by bad LaTeX code. Likely reasons can be a bad file path to TeX or
@@ -192,6 +297,12 @@ L2A::ItemChangeResult L2A::Item::Change(const ai::UnicodeString& form_return_val
     // If something changed add the information to the placed item note
     if (diff.Changed())
     {
+        if (!diff.changed_latex)
+        {
+            // The form does not return the compile data, so it is kept from the current pdf file.
+            new_property.SetCompileDigest(GetProperty().GetCompileDigest());
+            new_property.SetCompileTime(GetProperty().GetCompileTime());
+        }
         GetPropertyMutable() = new_property;
         SetNoteAndName();
 
@@ -210,14 +321,17 @@ L2A::ItemChangeResult L2A::Item::Change(const ai::UnicodeString& form_return_val
  */
 void L2A::Item::RedoBoundary()
 {
+    L2A::UTIL::TraceScope trace_scope("RedoBoundary");
+
     // If object is not stretched and not diamond -> do nothing.
-    if (!IsStretched() && !IsDiamond()) return;
+    const auto geometry = GetGeometry();
+    if (!geometry.IsStretched() && !geometry.IsDiamond()) return;
 
     // Get the position of the reference point.
-    AIRealPoint old_position = GetPosition();
+    AIRealPoint old_position = GetPosition({property_.GetAIAlignment()}, geometry).at(0);
 
     // Get the angle.
-    AIReal angle = GetAngle();
+    AIReal angle = geometry.GetAngle();
 
     // Rotate the object back to the initial position.
     AIRealMatrix artMatrix;
@@ -268,16 +382,22 @@ ai::FilePath L2A::Item::GetPDFPath() const
 /**
  *
  */
-void L2A::Item::SaveEncodedPDFFile(const ai::FilePath& pdf_path) const
+void L2A::Item::SaveEncodedPDFFile(const ai::FilePath& pdf_path, L2A::UTIL::LinksManifest& manifest) const
 {
+    L2A::UTIL::MetricsTimer metrics_timer("save_pdf");
+    L2A::UTIL::TraceScope trace_scope("SaveEncodedPDFFile");
+
     // Make sure the directory exists.
     if (!L2A::UTIL::IsDirectory(pdf_path.GetParent())) L2A::UTIL::CreateDirectoryL2A(pdf_path.GetParent());
 
     const ai::UnicodeString& pdf_contents = property_.GetPDFFileContents();
-    if (!pdf_contents.empty())
-        L2A::UTIL::decode_file_base64(pdf_path, pdf_contents);
-    else
-        l2a_error("Could not save the encoded pdf file, got empty encoded data.");
+    if (pdf_contents.empty()) l2a_error("Could not save the encoded pdf file, got empty encoded data.");
+    const std::uint64_t content_hash = L2A::UTIL::decode_file_base64(pdf_path, pdf_contents);
+
+    // Add the written file to the manifest, so later checks of the file only have to look at the file status. The hash
+    // of the contents is taken from the decoded data, the file is not read again.
+    manifest.Update(L2A::UTIL::StringAiToStd(pdf_path.GetFileName()),
+        L2A::UTIL::StringAiToStd(property_.GetPDFFileHash()), content_hash);
 }
 
 /**
@@ -333,80 +453,47 @@ AIRealPoint L2A::Item::GetPosition() const
  */
 std::vector<AIRealPoint> L2A::Item::GetPosition(const std::vector<PlaceAlignment>& placements) const
 {
-    // Vector of points to return.
-    std::vector<AIRealPoint> positions;
+    return GetPosition(placements, GetGeometry());
+}
 
-    // Variables for the placement factor and the points on the item.
+/**
+ *
+ */
+std::vector<AIRealPoint> L2A::Item::GetPosition(
+    const std::vector<PlaceAlignment>& placements, const L2A::UTIL::GeometrySnapshot& geometry) const
+{
+    // Get the coordinates of the placement points.
+    std::vector<AIRealPoint> positions;
+    positions.reserve(placements.size());
     AIReal pos_fac[2];
-    AIRealPoint position;
-
-    // Boundary coordinates for item.
-    AIRealRect bounds = L2A::AI::GetArtBounds(placed_item_);
-
-    if ((!IsRotated()) && (!IsDiamond()))
+    for (const auto& alignment : placements)
     {
-        // Item is rectangle that is not rotated. This should be the default case.
-
-        // Get the coordinates of the placement point.
-        for (const auto& alignment : placements)
-        {
-            L2A::AI::AlignmentToFac(alignment, pos_fac);
-            position.h = (ASReal)(bounds.left + pos_fac[0] * (bounds.right - bounds.left));
-            position.v = (ASReal)(bounds.bottom + pos_fac[1] * (bounds.top - bounds.bottom));
-            positions.push_back(position);
-        }
+        L2A::AI::AlignmentToFac(alignment, pos_fac);
+        positions.push_back(geometry.GetPosition(pos_fac));
     }
-    else
-    {
-        // Angles of the basis vectors
-        AIReal angle_1 = GetAngle(0);
-        AIReal angle_2 = GetAngle(1);
-
-        // Scale factor of the basis vectors.
-        AIReal scale_1 = GetStretch(0);
-        AIReal scale_2 = GetStretch(1);
-
-        // Dimensions of the pdf file.
-        AIRealRect image_box = L2A::AI::GetPlacedBoundingBox(placed_item_);
-        AIReal pdf_height = image_box.top - image_box.bottom;
-        AIReal pdf_width = image_box.right - image_box.left;
-
-        // Vectors to each corner of the item.
-        AIReal vec0[2] = {0., 0.};
-        AIReal vec1[2] = {scale_1 * pdf_width * cos(angle_1), scale_1 * pdf_width * sin(angle_1)};
-        AIReal vec2[2] = {scale_2 * pdf_height * cos(angle_2), scale_2 * pdf_height * sin(angle_2)};
-        AIReal vec3[2] = {vec1[0] + vec2[0], vec1[1] + vec2[1]};
-
-        // Get the minimum distance for both directions.
-        AIReal diff_x = min(min(min(vec0[0], vec1[0]), vec2[0]), vec3[0]);
-        AIReal diff_y = min(min(min(vec0[1], vec1[1]), vec2[1]), vec3[1]);
-
-        // Position of the bottom left node.
-        AIReal pos_node[2] = {bounds.left - diff_x, bounds.bottom - diff_y};
-
-        // Get the coordinates of the placement point.
-        for (const auto& alignment : placements)
-        {
-            L2A::AI::AlignmentToFac(alignment, pos_fac);
-            position.h = (ASReal)(pos_node[0] + pos_fac[0] * vec1[0] + pos_fac[1] * vec2[0]);
-            position.v = (ASReal)(pos_node[1] + pos_fac[0] * vec1[1] + pos_fac[1] * vec2[1]);
-            positions.push_back(position);
-        }
-    }
-
     return positions;
 }
 
 /**
  *
  */
-void L2A::Item::Draw(AIAnnotatorMessage* message, const std::map<PlaceAlignment, AIRealPoint>& item_boundaries) const
+L2A::UTIL::GeometrySnapshot L2A::Item::GetGeometry() const
+{
+    return L2A::UTIL::GeometrySnapshot(L2A::AI::GetPlacedMatrix(placed_item_), L2A::AI::GetArtBounds(placed_item_),
+        L2A::AI::GetPlacedBoundingBox(placed_item_));
+}
+
+/**
+ *
+ */
+void L2A::Item::Draw(AIAnnotatorMessage* message, const std::array<AIPoint, 9>& item_view_points,
+    const L2A::UTIL::GeometrySnapshot& geometry) const
 {
     // Get the color for this item.
     AIRGBColor item_color;
-    if (IsDiamond())
+    if (geometry.IsDiamond())
         item_color = L2A::CONSTANTS::color_diamond_;
-    else if (IsStretched())
+    else if (geometry.IsStretched())
         item_color = L2A::CONSTANTS::color_scaled_;
     else
         item_color = L2A::CONSTANTS::color_ok_;
@@ -432,10 +519,9 @@ void L2A::Item::Draw(AIAnnotatorMessage* message, const std::map<PlaceAlignment,
     // Get the coordinates of all Array with the relevant view positions.
     std::vector<AIPoint> polygon_points_view;
     for (auto const& placement : {kMidLeft, kTopLeft, kTopRight, kBotRight, kBotLeft, kMidLeft})
-        polygon_points_view.push_back(L2A::AI::ArtworkPointToViewPoint(item_boundaries.at(placement)));
+        polygon_points_view.push_back(item_view_points[placement]);
     std::vector<AIPoint> baseline_points_view;
-    for (auto const& placement : {kMidLeft, kMidRight})
-        baseline_points_view.push_back(L2A::AI::ArtworkPointToViewPoint(item_boundaries.at(placement)));
+    for (auto const& placement : {kMidLeft, kMidRight}) baseline_points_view.push_back(item_view_points[placement]);
 
     // Draw the boundary.
     AIErr error = sAIAnnotatorDrawer->DrawPolygon(
@@ -443,7 +529,7 @@ void L2A::Item::Draw(AIAnnotatorMessage* message, const std::map<PlaceAlignment,
     l2a_check_ai_error(error);
 
     // Draw the placement point.
-    AIPoint placement_point = L2A::AI::ArtworkPointToViewPoint(item_boundaries.at(property_.GetAIAlignment()));
+    AIPoint placement_point = item_view_points[property_.GetAIAlignment()];
     AIRect centre;
     centre.left = placement_point.h - L2A::CONSTANTS::radius_;
     centre.right = placement_point.h + L2A::CONSTANTS::radius_;
@@ -471,76 +557,21 @@ void L2A::Item::Draw(AIAnnotatorMessage* message, const std::map<PlaceAlignment,
 /**
  *
  */
-AIReal L2A::Item::GetAngle(unsigned short director) const
-{
-    // Get the values from the matrix.
-    AIRealMatrix artMatrix = L2A::AI::GetPlacedMatrix(placed_item_);
-
-    if (director == 0)
-        return -atan2(artMatrix.b, artMatrix.a);
-    else
-        return atan2(-artMatrix.d, artMatrix.c);
-}
+bool L2A::Item::IsDiamond() const { return GetGeometry().IsDiamond(); }
 
 /**
  *
  */
-bool L2A::Item::IsRotated() const
-{
-    // check if item is rotated
-    if (abs(GetAngle()) < L2A::CONSTANTS::eps_angle_)
-        return false;
-    else
-        return true;
-}
+bool L2A::Item::IsStretched() const { return GetGeometry().IsStretched(); }
 
 /**
  *
  */
-bool L2A::Item::IsDiamond() const
+void L2A::RedoItems(
+    std::vector<AIArtHandle>& redo_items, const RedoItemsOption& redo_option, const bool force_recompile)
 {
-    // Check if the angle between the two directors is pi/2
-    AIReal angle_1 = GetAngle(0);
-    AIReal angle_2 = GetAngle(1);
-    // Use the strech tollerance here, because not the angles are compared, but their cosines.
-    if (abs(cos(angle_2 - angle_1)) < L2A::CONSTANTS::eps_strech_)
-        return false;
-    else
-        return true;
-}
+    L2A::UTIL::TraceScope trace_scope("RedoItems");
 
-/**
- *
- */
-AIReal L2A::Item::GetStretch(unsigned short director) const
-{
-    // Get the values from the matrix.
-    AIRealMatrix artMatrix = L2A::AI::GetPlacedMatrix(placed_item_);
-
-    if (director == 0)
-        return sqrt(artMatrix.b * artMatrix.b + artMatrix.a * artMatrix.a);
-    else
-        return sqrt(artMatrix.c * artMatrix.c + artMatrix.d * artMatrix.d);
-}
-
-/**
- *
- */
-bool L2A::Item::IsStretched() const
-{
-    // Check if item is streched, both strech factors must be smaller than eps.
-    if ((abs(1. - GetStretch(0)) < L2A::CONSTANTS::eps_strech_) &&
-        (abs(1. - GetStretch(1)) < L2A::CONSTANTS::eps_strech_))
-        return false;
-    else
-        return true;
-}
-
-/**
- *
- */
-void L2A::RedoItems(std::vector<AIArtHandle>& redo_items, const RedoItemsOption& redo_option)
-{
     L2A::AI::SetUndoText(ai::UnicodeString("Undo Redo LaTeX2AI Items"), ai::UnicodeString("Redo LaTeX2AI Items"));
 
     // Check if something needs to be done
@@ -571,7 +602,7 @@ void L2A::RedoItems(std::vector<AIArtHandle>& redo_items, const RedoItemsOption&
 
     if (redo_option == RedoItemsOption::latex)
     {
-        if (!RedoLaTeXItems(l2a_items)) return;
+        if (!RedoLaTeXItems(l2a_items, force_recompile)) return;
     }
 
     // Redo the boundaries of all items (this has to be done for both cases of redo_option
@@ -581,47 +612,141 @@ void L2A::RedoItems(std::vector<AIArtHandle>& redo_items, const RedoItemsOption&
 /**
  *
  */
-bool L2A::RedoLaTeXItems(std::vector<L2A::Item>& l2a_items)
+bool L2A::RedoLaTeXItems(std::vector<L2A::Item>& l2a_items, const bool force_recompile)
 {
-    // Loop over every element and get the property
+    // Only get the properties of the items that actually have to be compiled.
+    std::vector<L2A::UTIL::RedoPlanItem> plan_items = CreateRedoPlanItems(l2a_items);
+    if (force_recompile)
+        for (auto& plan_item : plan_items) plan_item.is_up_to_date_ = false;
+    const L2A::UTIL::RedoPlan plan = L2A::UTIL::CreateRedoPlan(plan_items);
+    L2A::UTIL::GetMetrics().Increment("redo_skipped_items", plan.n_skipped_);
+    L2A::UTIL::GetMetrics().Increment("redo_deduplicated_items", plan.n_deduplicated_);
+    if (plan.compile_items_.empty()) return true;
+
+    // Pages that were compiled in the background do not have to be compiled again, unless a recompile is forced.
+    const L2A::UTIL::BackgroundCompileResult* staged_compile = force_recompile ? nullptr : GetStagedCompile();
+    ai::UnicodeString compile_digest;
+    if (staged_compile != nullptr) compile_digest = L2A::UTIL::StringStdToAi(staged_compile->compile_digest_);
+
+    std::vector<ai::FilePath> pdf_files(plan.compile_items_.size(), ai::FilePath(ai::UnicodeString("")));
+    std::vector<double> compile_times(plan.compile_items_.size(), -1.0);
+    std::vector<size_t> compile_pages;
     std::vector<L2A::Property> properties;
-    for (const auto& item : l2a_items)
+    for (size_t i_compile = 0; i_compile < plan.compile_items_.size(); i_compile++)
     {
-        // TODO: dont copy the pdf contents here
-        properties.push_back(item.GetProperty());
+        const size_t i_item = plan.compile_items_[i_compile];
+        const std::filesystem::path* staged_page =
+            staged_compile != nullptr ? staged_compile->FindPage(plan_items[i_item]) : nullptr;
+        if (staged_page != nullptr && std::filesystem::is_regular_file(*staged_page))
+        {
+            pdf_files[i_compile] = L2A::UTIL::FilePathStdToAi(*staged_page);
+            compile_times[i_compile] = staged_compile->GetPageTime(plan_items[i_item]);
+        }
+        else
+        {
+            // TODO: dont copy the pdf contents here
+            compile_pages.push_back(i_compile);
+            properties.push_back(l2a_items[i_item].GetProperty());
+        }
     }
 
-    // Create the pdf file for each item
-    auto [latex_creation_result, pdf_files] = L2A::LATEX::CreateLatexItems(properties);
-    if (latex_creation_result.result_ != L2A::LATEX::LatexCreationResult::Result::ok)
+    // Create the pdf file for each item that is not staged
+    if (!properties.empty())
     {
-        L2A::GlobalPluginMutable().GetUiManager().GetDebugForm().OpenDebugForm(
-            L2A::UI::Debug::Action::redo_items, latex_creation_result);
-        return false;
+        auto [latex_creation_result, compiled_pdf_files] = L2A::LATEX::CreateLatexItems(properties);
+        if (latex_creation_result.result_ == L2A::LATEX::LatexCreationResult::Result::error_syntax)
+        {
+            // There is no log file for the debug form, so the user is told which item has the error.
+            const size_t i_item = plan.compile_items_[compile_pages[latex_creation_result.syntax_error_item_]];
+            ai::UnicodeString message("The LaTeX code of the item \"");
+            message += l2a_items[i_item].GetAIName();
+            message += ai::UnicodeString("\" has an error, no items were compiled.\n");
+            message +=
+                L2A::UTIL::StringStdToAi(L2A::UTIL::GetLatexSyntaxErrorText(latex_creation_result.syntax_error_));
+            message += ai::UnicodeString("\n\n");
+            message += l2a_items[i_item].GetProperty().GetLaTeXCode();
+            L2A::AI::WarningAlert(message);
+            return false;
+        }
+        else if (latex_creation_result.result_ != L2A::LATEX::LatexCreationResult::Result::ok)
+        {
+            L2A::GlobalPluginMutable().GetUiManager().GetDebugForm().OpenDebugForm(
+                L2A::UI::Debug::Action::redo_items, latex_creation_result);
+            return false;
+        }
+        for (size_t i_page = 0; i_page < compile_pages.size(); i_page++)
+        {
+            pdf_files[compile_pages[i_page]] = compiled_pdf_files[i_page];
+            compile_times[compile_pages[i_page]] = latex_creation_result.compile_times_[i_page];
+        }
+        compile_digest = latex_creation_result.compile_digest_;
     }
+    L2A::UTIL::GetMetrics().Increment("redo_staged_pages", plan.compile_items_.size() - compile_pages.size());
+    L2A::UTIL::GetMetrics().Increment("redo_compiled_pages", compile_pages.size());
 
     // Create the PDFs for the items and store them in the placed items. We dont reset the boundary box here. This is
     // done in the redo function, we leave it out here, since one might want to use this function without resetting the
-    // bounding box.
-    for (unsigned int i = 0; i < l2a_items.size(); i++)
+    // bounding box. Identical items get the same pdf file, it only has to be written once.
+    L2A::UTIL::LinksManifest manifest(GetLinksManifestPath(L2A::UTIL::GetPdfFileDirectory()));
+    for (size_t i_item = 0; i_item < l2a_items.size(); i_item++)
     {
+        const size_t i_compile = plan.compile_index_[i_item];
+        if (i_compile == L2A::UTIL::RedoPlan::skip) continue;
+
         // Get the PDF path.
-        auto& l2a_item = l2a_items[i];
-        l2a_item.GetPropertyMutable().SetPDFFile(pdf_files[i]);
+        auto& l2a_item = l2a_items[i_item];
+        l2a_item.GetPropertyMutable().SetPDFFile(pdf_files[i_compile]);
+        l2a_item.GetPropertyMutable().SetCompileDigest(compile_digest);
+        l2a_item.GetPropertyMutable().SetCompileTime(compile_times[i_compile]);
         ai::FilePath new_path = l2a_item.GetPDFPath();
-        l2a_item.SaveEncodedPDFFile(new_path);
+        if (plan.compile_items_[i_compile] == i_item) l2a_item.SaveEncodedPDFFile(new_path, manifest);
         L2A::AI::RelinkPlacedItem(l2a_item.GetPlacedItemMutable(), new_path);
         l2a_item.SetNoteAndName();
     }
+    manifest.Write();
 
     return true;
 }
 
+/**
+ *
+ */
+const L2A::UTIL::BackgroundCompileResult* L2A::GetStagedCompile()
+{
+    const L2A::UTIL::BackgroundCompileResult* staged_compile = L2A::GlobalPluginMutable().GetStagedCompile();
+    if (staged_compile == nullptr) return nullptr;
+    if (staged_compile->document_path_ != L2A::UTIL::FilePathAiToStd(L2A::UTIL::GetDocumentPath(false)) ||
+        L2A::UTIL::StringStdToAi(staged_compile->compile_digest_) != L2A::LATEX::GetCompileDigest())
+        return nullptr;
+    return staged_compile;
+}
+
+/**
+ *
+ */
+std::vector<L2A::UTIL::RedoPlanItem> L2A::GetRedoPlanItems(const std::vector<AIArtHandle>& items)
+{
+    L2A::UTIL::TraceScope trace_scope("GetRedoPlanItems");
+
+    // The items are read directly from their notes, so the stored pdf files do not have to be parsed.
+    const std::string compile_digest = L2A::UTIL::StringAiToStd(GetRedoPlanCompileDigest());
+    std::vector<L2A::UTIL::RedoPlanItem> plan_items(items.size());
+    for (size_t i_item = 0; i_item < items.size(); i_item++)
+    {
+        if (!L2A::UTIL::ReadItemRedoPlanItem(
+                L2A::UTIL::StringAiToStd(L2A::AI::GetNote(items[i_item])), compile_digest, plan_items[i_item]))
+            l2a_error("Could not read the data of the item \"" + L2A::AI::GetName(items[i_item]) + "\"");
+    }
+    return plan_items;
+}
+
 /**
  *
  */
 void L2A::CheckItemDataStructure()
 {
+    L2A::UTIL::TraceScope trace_scope("CheckItemDataStructure");
+
     // We need a valid document path for this function to work.
     if (!L2A::UTIL::IsFile(L2A::UTIL::GetDocumentPath(false))) return;
 
@@ -675,58 +800,101 @@ void L2A::CheckItemDataStructure()
     const ai::FilePath pdf_file_directory = L2A::UTIL::GetPdfFileDirectory();
     if (working_items.size() > 0) L2A::UTIL::CreateDirectoryL2A(pdf_file_directory);
 
-    // Loop over each LaTeX2AI item and check if it is stored correctly.
-    std::vector<ai::FilePath> used_pdf_files;
+    // Loop over each LaTeX2AI item and check if it is stored correctly. The manifest contains the files written by
+    // LaTeX2AI, so the contents of an existing file are only checked with the file status. The pdf is only written
+    // again if the file is missing or was changed.
+    L2A::UTIL::LinksManifest manifest(GetLinksManifestPath(pdf_file_directory));
+    std::vector<ai::FilePath> pdf_paths;
+    std::vector<L2A::UTIL::ItemLinkState> link_states;
+    pdf_paths.reserve(working_items.size());
+    link_states.reserve(working_items.size());
     for (auto& item : working_items)
     {
-        const ai::FilePath new_pdf_path = item.GetPDFPath();
+        pdf_paths.push_back(item.GetPDFPath());
         const ai::FilePath old_pdf_path = L2A::AI::GetPlacedItemPath(item.GetPlacedItem());
-        if (!(L2A::UTIL::IsEqualFile(new_pdf_path, old_pdf_path) && L2A::UTIL::IsFile(new_pdf_path)))
-        {
-            // Store the pdf in the correct path and relink it.
-            item.SaveEncodedPDFFile(new_pdf_path);
-            L2A::AI::SetPlacedItemPath(item.GetPlacedItemMutable(), new_pdf_path);
-        }
-        used_pdf_files.push_back(new_pdf_path);
+        link_states.push_back({L2A::UTIL::StringAiToStd(pdf_paths.back().GetFileName()),
+            L2A::UTIL::StringAiToStd(item.GetProperty().GetPDFFileHash()),
+            L2A::UTIL::IsEqualFile(pdf_paths.back(), old_pdf_path)});
     }
+    L2A::UTIL::ItemLinksPlan links_plan = L2A::UTIL::CreateItemLinksPlan(manifest, link_states);
 
-    // Cleanup pdf links directory.
+    // Store the pdfs in the correct path and relink them. Relinking has to be done on the main thread.
+    std::vector<const L2A::Item*> write_items;
+    std::vector<ai::FilePath> write_pdf_paths;
+    for (const size_t i_item : links_plan.write_items_)
     {
-        // Get all pdf items.
-        ai::UnicodeString pattern = ai::UnicodeString(".*") + L2A::NAMES::pdf_item_post_fix_ + ".*\\.pdf$";
-        std::vector<ai::FilePath> pdf_item_files = L2A::UTIL::FindFilesInFolder(pdf_file_directory, pattern);
+        write_items.push_back(&working_items[i_item]);
+        write_pdf_paths.push_back(pdf_paths[i_item]);
+    }
+    SaveEncodedPDFFiles(write_items, write_pdf_paths, manifest);
+    for (const size_t i_item : links_plan.relink_items_)
+        L2A::AI::SetPlacedItemPath(working_items[i_item].GetPlacedItemMutable(), pdf_paths[i_item]);
 
-        // Get all documents parallel to the current document.
-        pattern = ai::UnicodeString(".*\\.ai$");
-        std::vector<ai::FilePath> ai_document_files =
-            L2A::UTIL::FindFilesInFolder(L2A::UTIL::GetDocumentPath().GetParent(), pattern);
+    // Cleanup and scrub the pdf links directory. This is done by the background worker, the removed files are
+    // deleted from the manifest and the files that have to be repaired are written again in
+    // L2A::RepairItemPDFFiles. The scrub only reads the files that are new or changed since the last scrub.
+    {
+        L2A::UTIL::LinksMaintenanceJob job;
+        job.links_directory_ = L2A::UTIL::FilePathAiToStd(pdf_file_directory);
+        job.document_path_ = L2A::UTIL::FilePathAiToStd(L2A::UTIL::GetDocumentPath());
+        job.time_ = std::filesystem::file_time_type::clock::now();
 
-        // Loop over each pdf label and check if it should be deleted.
-        for (const auto& pdf_path : pdf_item_files)
-        {
-            bool delete_this_file = true;
+        job.type_ = L2A::UTIL::LinksMaintenanceJob::Type::scrub;
+        L2A::GlobalPluginMutable().PostLinksMaintenanceJob(job);
 
-            // Check if the pdf if part of this document.
-            for (const auto& used_file : used_pdf_files)
-            {
-                if (pdf_path == used_file) delete_this_file = false;
-            }
+        job.type_ = L2A::UTIL::LinksMaintenanceJob::Type::garbage_collection;
+        job.used_file_names_ = std::move(links_plan.used_pdf_files_);
+        L2A::GlobalPluginMutable().PostLinksMaintenanceJob(job);
+    }
 
-            // Check if the pdf fits to another Illustrator document by its name.
-            const ai::UnicodeString pdf_name = pdf_path.GetFileName();
-            for (const auto& ai_file : ai_document_files)
-            {
-                // Do not check the name of this document, as the individual items are already checked above.
-                if (L2A::UTIL::GetDocumentPath() == ai_file) continue;
+    // The manifest is only used to avoid unnecessary writes of the pdf files. If it can not be written, the files are
+    // written again in the next check.
+    manifest.Write();
+}
 
-                ai::UnicodeString ai_name = ai_file.GetFileNameNoExt();
-                if (L2A::UTIL::StartsWith(pdf_name, ai_name + L2A::NAMES::pdf_item_post_fix_, true))
-                    delete_this_file = false;
-            }
+/**
+ *
+ */
+void L2A::RepairItemPDFFiles(const std::vector<std::string>& file_names)
+{
+    if (file_names.empty() || !L2A::UTIL::IsFile(L2A::UTIL::GetDocumentPath(false))) return;
+    const std::unordered_set<std::string> repair_files(file_names.begin(), file_names.end());
 
-            // If the file is not used by this document or shares the name with an existing Illustrator document, delete
-            // it.
-            if (delete_this_file) L2A::UTIL::RemoveFile(pdf_path);
-        }
+    std::vector<AIArtHandle> items_all;
+    L2A::AI::GetDocumentItems(items_all, L2A::AI::SelectionState::all);
+
+    std::vector<L2A::Item> repair_items;
+    std::vector<ai::FilePath> repair_pdf_paths;
+    for (auto& item : items_all)
+    {
+        L2A::Item l2a_item(item);
+        if (l2a_item.GetProperty().GetPDFFileHash().empty()) continue;
+
+        const ai::FilePath pdf_path = l2a_item.GetPDFPath();
+        if (repair_files.count(L2A::UTIL::StringAiToStd(pdf_path.GetFileName())) == 0) continue;
+        repair_items.push_back(l2a_item);
+        repair_pdf_paths.push_back(pdf_path);
     }
+
+    // Write the pdf files again from the data stored in the items and relink them, so Illustrator reloads the files.
+    std::vector<const L2A::Item*> write_items;
+    for (const auto& item : repair_items) write_items.push_back(&item);
+    L2A::UTIL::LinksManifest manifest(GetLinksManifestPath(L2A::UTIL::GetPdfFileDirectory()));
+    SaveEncodedPDFFiles(write_items, repair_pdf_paths, manifest);
+    for (size_t i_item = 0; i_item < repair_items.size(); i_item++)
+        L2A::AI::SetPlacedItemPath(repair_items[i_item].GetPlacedItemMutable(), repair_pdf_paths[i_item]);
+    manifest.Write();
+}
+
+/**
+ *
+ */
+void L2A::WritePipelineTrace()
+{
+    const L2A::UTIL::TraceBuffer& trace_buffer = L2A::UTIL::GetTraceBuffer();
+    if (!trace_buffer.IsEnabled()) return;
+
+    ai::FilePath trace_path = L2A::UTIL::GetApplicationDataDirectory();
+    trace_path.AddComponent(ai::UnicodeString(L2A::NAMES::trace_file_name_));
+    L2A::UTIL::WriteChromeTrace(trace_buffer, L2A::UTIL::FilePathAiToStd(trace_path));
 }
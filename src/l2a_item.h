@@ -31,10 +31,12 @@
 #define L2A_ITEM_H_
 
 
+#include "l2a_geometry.h"
 #include "l2a_latex.h"
 #include "l2a_property.h"
+#include "l2a_redo_plan.h"
 
-#include <map>
+#include <array>
 
 
 // Forward declaration
@@ -44,6 +46,11 @@ struct AIAnnotatorMessage;
 // Forward declaration.
 namespace L2A
 {
+    namespace UTIL
+    {
+        class LinksManifest;
+        struct BackgroundCompileResult;
+    }
     namespace TEST
     {
         namespace UTIL
@@ -75,6 +82,8 @@ namespace L2A
             ok,
             //! There was a LaTeX error user has to be asked for the input again
             latex_error,
+            //! The LaTeX code has a syntax error, the user has to fix it in the item form
+            syntax_error,
             //! Not changed, and no new input wanted
             cancel
         };
@@ -155,8 +164,10 @@ namespace L2A
 
         /**
          * \brief Create the encoded PDF file.
+         * @param manifest Manifest of the links folder, the written file is added to it. The manifest file is not
+         * written here, this is done once for all files of an operation.
          */
-        void SaveEncodedPDFFile(const ai::FilePath& pdf_path) const;
+        void SaveEncodedPDFFile(const ai::FilePath& pdf_path, L2A::UTIL::LinksManifest& manifest) const;
 
         /**
          * \brief Get the name of the item in Illustrator.
@@ -173,10 +184,25 @@ namespace L2A
          */
         std::vector<AIRealPoint> GetPosition(const std::vector<PlaceAlignment>& placements) const;
 
+        /**
+         * \brief Get the positions of multiple points on the item for a given geometry snapshot of this item.
+         */
+        std::vector<AIRealPoint> GetPosition(
+            const std::vector<PlaceAlignment>& placements, const L2A::UTIL::GeometrySnapshot& geometry) const;
+
+        /**
+         * \brief Get a snapshot of the current geometry of the placed item.
+         */
+        L2A::UTIL::GeometrySnapshot GetGeometry() const;
+
         /**
          * \brief Draw the boundary of the placed item in the document.
+         * @param item_view_points View coordinates of the placement points of the item, ordered as in the
+         * PlaceAlignment enum.
+         * @param geometry Geometry snapshot of this item.
          */
-        void Draw(AIAnnotatorMessage* message, const std::map<PlaceAlignment, AIRealPoint>& item_boundaries) const;
+        void Draw(AIAnnotatorMessage* message, const std::array<AIPoint, 9>& item_view_points,
+            const L2A::UTIL::GeometrySnapshot& geometry) const;
 
         /**
          * \brief Check if the item is of diamond shape.
@@ -194,21 +220,6 @@ namespace L2A
          */
         void MoveItem(const AIRealPoint& position_item);
 
-        /**
-         * \brief Get the angle of the item along the x1 or x2 axis (director is 0 for x1 and 1 for x2).
-         */
-        AIReal GetAngle(unsigned short director = 0) const;
-
-        /**
-         * \brief Check if the item is rotated.
-         */
-        bool IsRotated() const;
-
-        /**
-         * \brief Get the stretch of the item in a direction.
-         */
-        AIReal GetStretch(unsigned short director = 0) const;
-
        private:
         //! Properties of this item.
         L2A::Property property_;
@@ -228,18 +239,45 @@ namespace L2A
 
     /**
      * \brief Redo all items. Give the user the option to chose what to redo.
+     * @param force_recompile If true, items that are up to date are also compiled again.
+     */
+    void RedoItems(
+        std::vector<AIArtHandle>& items, const RedoItemsOption& redo_option, const bool force_recompile = false);
+
+    /**
+     * \brief Redo the LaTeX code for all items in the vector. Items that are up to date are skipped, unless
+     * force_recompile is set, and identical items are only compiled once.
+     */
+    bool RedoLaTeXItems(std::vector<L2A::Item>& l2a_items, const bool force_recompile = false);
+
+    /**
+     * \brief Get the data of the items needed to plan a redo of the items. Only the LaTeX code and the compile data
+     * are read from the items, the stored pdf files are not parsed.
      */
-    void RedoItems(std::vector<AIArtHandle>& items, const RedoItemsOption& redo_option);
+    std::vector<L2A::UTIL::RedoPlanItem> GetRedoPlanItems(const std::vector<AIArtHandle>& items);
 
     /**
-     * \brief Redo the LaTeX code for all items in the vector.
+     * \brief Get the pages of the last background compilation, if they belong to the active document and were compiled
+     * with the current header and options. Otherwise nullptr is returned.
      */
-    bool RedoLaTeXItems(std::vector<L2A::Item>& l2a_items);
+    const L2A::UTIL::BackgroundCompileResult* GetStagedCompile();
 
     /**
      * \brief Check if the pdf files of the items are stored and linked correctly.
      */
     void CheckItemDataStructure();
 
+    /**
+     * \brief Write the pdf files of the items in the active document again from the data stored in the items.
+     * @param file_names Names of the pdf files that have to be written, e.g., found by the links maintenance worker.
+     */
+    void RepairItemPDFFiles(const std::vector<std::string>& file_names);
+
+    /**
+     * \brief Write the spans recorded in the item pipeline as Chrome trace to the application data directory. Nothing
+     * is done if the tracing is disabled.
+     */
+    void WritePipelineTrace();
+
 }  // namespace L2A
 #endif
@@ -34,15 +34,23 @@
 #include "auto_generated/tex.h"
 
 #include "l2a_ai_functions.h"
+#include "l2a_background_compile.h"
+#include "l2a_compile_core.h"
 #include "l2a_execute.h"
 #include "l2a_file_system.h"
 #include "l2a_global.h"
+#include "l2a_header_resolver.h"
+#include "l2a_latex_syntax.h"
+#include "l2a_metrics.h"
 #include "l2a_names.h"
 #include "l2a_parameter_list.h"
 #include "l2a_property.h"
+#include "l2a_redo_plan.h"
 #include "l2a_string_functions.h"
+#include "l2a_trace.h"
 
-#include <regex>
+#include <set>
+#include <sstream>
 
 #ifdef WIN_ENV
 #include <Shlobj.h>
@@ -54,15 +62,8 @@
  */
 ai::UnicodeString L2A::LATEX::GetLatexString(const ai::UnicodeString& latex_code)
 {
-    // Get the latex code.
-    ai::UnicodeString code(L2A_LATEX_ITEM_);
-
-    // Replace placeholders.
-    L2A::UTIL::StringReplaceAll(
-        code, ai::UnicodeString("{tex_header_name}"), ai::UnicodeString(L2A::NAMES::tex_header_name_));
-    L2A::UTIL::StringReplaceAll(code, ai::UnicodeString("{latex_code}"), ai::UnicodeString(latex_code));
-
-    return code;
+    return L2A::UTIL::StringStdToAi(
+        L2A::UTIL::GetLatexDocumentText(L2A::UTIL::StringAiToStd(latex_code), L2A::NAMES::tex_header_name_));
 }
 
 /**
@@ -70,34 +71,12 @@ ai::UnicodeString L2A::LATEX::GetLatexString(const ai::UnicodeString& latex_code
  */
 ai::UnicodeString L2A::LATEX::GetLatexCompileCommand(const ai::FilePath& tex_file)
 {
-    // This string will contain the actual command send to the commandline
-    ai::UnicodeString full_latex_command;
-
-    const auto& latex_bin_path = L2A::Global().latex_bin_path_;
-    const auto& latex_engine = L2A::Global().latex_engine_;
-    if (latex_bin_path.GetFullPath() == "")
-    {
-        // In the case there is an empty bin directory, so we simply run the latex engine command name
-        full_latex_command += latex_engine;
-    }
-    else
-    {
-        ai::FilePath exe_path = latex_bin_path;
-#ifdef WIN_ENV
-        exe_path.AddComponent(latex_engine + ".exe");
-#else
-        exe_path.AddComponent(latex_engine);
-#endif
-        full_latex_command += "\"" + exe_path.GetFullPath() + "\"";
-    }
-
-    // Add the options and the name of the tex file
-    full_latex_command += " ";
-    full_latex_command += L2A::Global().latex_command_options_;
-    full_latex_command += " \"";
-    full_latex_command += tex_file.GetFullPath();
-    full_latex_command += "\"";
-    return full_latex_command;
+    const auto& global = L2A::Global();
+    const std::string command =
+        L2A::UTIL::GetLatexCompileCommand(L2A::UTIL::FilePathAiToStd(global.latex_bin_path_),
+            L2A::UTIL::StringAiToStd(global.latex_engine_), L2A::UTIL::StringAiToStd(global.latex_command_options_),
+            L2A::UTIL::FilePathAiToStd(tex_file));
+    return L2A::UTIL::StringStdToAi(command);
 }
 
 /**
@@ -114,12 +93,13 @@ std::vector<ai::FilePath> L2A::LATEX::SplitPdfPages(const ai::FilePath& pdf_file
 std::vector<ai::FilePath> L2A::LATEX::SplitPdfPages(
     const ai::FilePath& pdf_file, const unsigned int& n_pages, const ai::UnicodeString& gs_command)
 {
+    L2A::UTIL::TraceScope trace_scope("SplitPdfPages");
+
     // Check if file exists
     if (!L2A::UTIL::IsFile(pdf_file))
         l2a_error("The file to split up '" + pdf_file.GetFullPath() + "' does not exits!");
 
     // Get name and folder of the pdf file
-    const ai::UnicodeString pdf_name = pdf_file.GetFileName();
     const ai::UnicodeString pdf_name_no_ext = pdf_file.GetFileNameNoExt();
     ai::FilePath pdf_folder = pdf_file.GetParent();
 
@@ -134,13 +114,7 @@ std::vector<ai::FilePath> L2A::LATEX::SplitPdfPages(
     }
 
     // Get the ghostscript command to split the pdf
-    ai::UnicodeString full_gs_command;
-    full_gs_command += "\"";
-    full_gs_command += gs_command;
-    full_gs_command += "\" -sDEVICE=pdfwrite -o ";
-    full_gs_command += pdf_name_no_ext;
-    full_gs_command += "_%d.pdf ";
-    full_gs_command += pdf_name;
+    const ai::UnicodeString full_gs_command = GetSplitPdfPagesCommand(pdf_file, gs_command);
 
     // Call the command to split up the pdf file
     L2A::UTIL::SetWorkingDirectory(pdf_folder);
@@ -183,6 +157,15 @@ std::vector<ai::FilePath> L2A::LATEX::SplitPdfPages(
     return pdf_files;
 }
 
+/**
+ *
+ */
+ai::UnicodeString L2A::LATEX::GetSplitPdfPagesCommand(const ai::FilePath& pdf_file, const ai::UnicodeString& gs_command)
+{
+    return L2A::UTIL::StringStdToAi(L2A::UTIL::GetSplitPdfPagesCommand(
+        L2A::UTIL::FilePathAiToStd(pdf_file), L2A::UTIL::StringAiToStd(gs_command)));
+}
+
 /**
  *
  */
@@ -196,33 +179,87 @@ std::pair<L2A::LATEX::LatexCreationResult, ai::FilePath> L2A::LATEX::CreateLatex
         return {latex_result, ai::FilePath(ai::UnicodeString(""))};
 }
 
+namespace
+{
+    /**
+     * \brief Add the timings of a compilation to the metrics, when the compilation is finished.
+     */
+    class CompileMetricsGuard
+    {
+       public:
+        CompileMetricsGuard(const size_t n_items) : timer_("compile_items") { record_.n_items_ = n_items; }
+        ~CompileMetricsGuard()
+        {
+            record_.total_time_ = timer_.Stop();
+            L2A::UTIL::GetMetrics().AddCompile(record_);
+            L2A::UTIL::GetMetrics().Increment(record_.is_ok_ ? "compiles" : "failed_compiles");
+        }
+
+        //! Timings of the compilation, they are filled during the compilation.
+        L2A::UTIL::CompileRecord record_;
+
+       private:
+        //! Timer for the total time.
+        L2A::UTIL::MetricsTimer timer_;
+    };
+}  // namespace
+
 /**
  *
  */
 std::pair<L2A::LATEX::LatexCreationResult, std::vector<ai::FilePath>> L2A::LATEX::CreateLatexItems(
     const std::vector<L2A::Property>& properties)
 {
+    // Structural errors in the code are found without calling TeX. This is done before the compile metrics are
+    // recorded, as nothing is compiled.
+    if (L2A::Global().check_latex_syntax_)
+    {
+        L2A::UTIL::MetricsTimer syntax_timer("check_latex_syntax");
+        LatexCreationResult latex_creation_result{LatexCreationResult::Result::error_syntax};
+        for (size_t i_property = 0; i_property < properties.size(); i_property++)
+        {
+            if (!L2A::UTIL::CheckLatexSyntax(L2A::UTIL::StringAiToStd(properties[i_property].GetLaTeXCode()),
+                    latex_creation_result.syntax_error_))
+            {
+                L2A::UTIL::GetMetrics().Increment("latex_syntax_errors");
+                latex_creation_result.syntax_error_item_ = i_property;
+                return {latex_creation_result, {}};
+            }
+        }
+    }
+
+    CompileMetricsGuard compile_metrics(properties.size());
     std::vector<ai::FilePath> pdf_files;
+    ai::UnicodeString compile_digest;
+    std::vector<double> page_times;
+    std::vector<double> compile_times;
 
     try
     {
-        // Loop over all properties and get the combined the latex code as string
-        ai::UnicodeString combined_latex_code("\n\n");
-        for (const auto& property : properties)
+        // The digest has to be taken before the document is compiled, so a header change during the compilation marks
+        // the items as stale.
+        compile_digest = GetCompileDigest();
+
+        // Items with the same code and baseline flag result in the same page, so each of them is only added once to
+        // the document.
+        std::vector<L2A::UTIL::RedoPlanItem> plan_items(properties.size());
+        for (size_t i_property = 0; i_property < properties.size(); i_property++)
         {
-            if (property.IsBaseline())
-                combined_latex_code += ai::UnicodeString("\\LaTeXtoAIbase{");
-            else
-                combined_latex_code += ai::UnicodeString("\\LaTeXtoAI{");
-            combined_latex_code += property.GetLaTeXCode();
-            combined_latex_code += ai::UnicodeString("}\n\n");
+            plan_items[i_property].latex_code_ = L2A::UTIL::StringAiToStd(properties[i_property].GetLaTeXCode());
+            plan_items[i_property].is_baseline_ = properties[i_property].IsBaseline();
         }
+        const L2A::UTIL::RedoPlan page_plan = L2A::UTIL::CreateRedoPlan(plan_items);
+        compile_metrics.record_.n_pages_ = page_plan.compile_items_.size();
+
+        // Get the combined latex code of all unique properties as string
+        const ai::UnicodeString combined_latex_code =
+            L2A::UTIL::StringStdToAi(L2A::UTIL::GetLatexPagesCode(plan_items, page_plan.compile_items_));
 
         // Create the latex document
         ai::FilePath pdf_file;
         try
         {
-            if (!CreateLatexDocument(combined_latex_code, pdf_file))
+            if (!CreateLatexDocument(combined_latex_code, pdf_file, &compile_metrics.record_))
             {
                 auto file_name = pdf_file.GetFileNameNoExt();
                 auto log_file = pdf_file.GetParent();
@@ -232,7 +269,11 @@ std::pair<L2A::LATEX::LatexCreationResult, std::vector<ai::FilePath>> L2A::LATEX
                 auto tex_header_file = pdf_file.GetParent();
                 tex_header_file.AddComponent(ai::UnicodeString(L2A::NAMES::tex_header_name_));
 
-                return {{LatexCreationResult::Result::error_tex_code, log_file, tex_file, tex_header_file}, {}};
+                LatexCreationResult latex_creation_result{
+                    LatexCreationResult::Result::error_tex_code, log_file, tex_file, tex_header_file};
+                latex_creation_result.page_times_ =
+                    L2A::UTIL::ReadLatexPageTimes(L2A::UTIL::FilePathAiToStd(log_file));
+                return {latex_creation_result, {}};
             }
         }
         catch (L2A::ERR::Exception& ex)
@@ -244,7 +285,22 @@ std::pair<L2A::LATEX::LatexCreationResult, std::vector<ai::FilePath>> L2A::LATEX
         // into the individual pages with ghost script.
         try
         {
-            pdf_files = L2A::LATEX::SplitPdfPages(pdf_file, (unsigned int)properties.size());
+            L2A::UTIL::MetricsTimer split_timer("split_pages");
+            const std::vector<ai::FilePath> page_files =
+                L2A::LATEX::SplitPdfPages(pdf_file, (unsigned int)page_plan.compile_items_.size());
+            compile_metrics.record_.split_time_ = split_timer.Stop();
+
+            // Each item gets the page of its code and the time the LaTeX engine spent on it.
+            ai::FilePath log_file = pdf_file.GetParent();
+            log_file.AddComponent(pdf_file.GetFileNameNoExt() + ".log");
+            page_times = L2A::UTIL::ReadLatexPageTimes(L2A::UTIL::FilePathAiToStd(log_file));
+            pdf_files.reserve(properties.size());
+            compile_times.reserve(properties.size());
+            for (const auto& i_page : page_plan.compile_index_)
+            {
+                pdf_files.push_back(page_files[i_page]);
+                compile_times.push_back(i_page < page_times.size() ? page_times[i_page] : -1.0);
+            }
         }
         catch (L2A::ERR::Exception& ex)
         {
@@ -257,26 +313,51 @@ std::pair<L2A::LATEX::LatexCreationResult, std::vector<ai::FilePath>> L2A::LATEX
     }
 
     // Everything worked fine
-    return {{LatexCreationResult::Result::ok}, pdf_files};
+    LatexCreationResult latex_creation_result{LatexCreationResult::Result::ok};
+    latex_creation_result.compile_digest_ = compile_digest;
+    latex_creation_result.page_times_ = std::move(page_times);
+    latex_creation_result.compile_times_ = std::move(compile_times);
+    compile_metrics.record_.is_ok_ = true;
+    return {latex_creation_result, pdf_files};
 }
 
 /**
  *
  */
-bool L2A::LATEX::CreateLatexDocument(const ai::UnicodeString& latex_code, ai::FilePath& pdf_file)
+bool L2A::LATEX::CreateLatexDocument(
+    const ai::UnicodeString& latex_code, ai::FilePath& pdf_file, L2A::UTIL::CompileRecord* compile_record)
 {
+    L2A::UTIL::MetricsTimer write_timer("write_latex_files");
+
     // Get the directory where the items shall be created
     ai::FilePath tex_directory = L2A::UTIL::GetTemporaryDirectory();
     tex_directory.AddComponent(ai::UnicodeString(L2A::NAMES::create_pdf_tex_name_base_));
 
-    // Make sure the directory exists and is empty
-    L2A::UTIL::ClearDirectory(tex_directory, false);
+    // Remove the files from the last compilation. The header and the local packages are kept, so they only have to be
+    // written if they changed.
+    L2A::UTIL::CreateDirectoryL2A(tex_directory);
+    std::set<std::filesystem::path> kept_names = {std::filesystem::u8path(L2A::NAMES::tex_header_name_)};
+    for (const auto& package : ResolveHeader(GetHeaderPath()).local_packages_)
+        kept_names.insert(*package.relative_path_.begin());
+    for (const auto& entry : std::filesystem::directory_iterator(L2A::UTIL::FilePathAiToStd(tex_directory)))
+    {
+        if (kept_names.find(entry.path().filename()) != kept_names.end()) continue;
+        std::error_code error_code;
+        std::filesystem::remove_all(entry.path(), error_code);
+        if (error_code.value() != 0) l2a_error("The item \"" + entry.path().string() + "\" could not be deleted!");
+    }
 
     // Create the latex files
     const ai::FilePath tex_file = WriteLatexFiles(latex_code, tex_directory);
+    const double write_time = write_timer.Stop();
+    if (compile_record != nullptr) compile_record->write_time_ = write_time;
 
     // Compile the latex file
-    return CompileLatexDocument(tex_file, pdf_file);
+    L2A::UTIL::MetricsTimer latex_timer("latex_engine");
+    const bool is_compiled = CompileLatexDocument(tex_file, pdf_file);
+    const double latex_time = latex_timer.Stop();
+    if (compile_record != nullptr) compile_record->latex_time_ = latex_time;
+    return is_compiled;
 }
 
 /**
@@ -284,6 +365,8 @@ bool L2A::LATEX::CreateLatexDocument(const ai::UnicodeString& latex_code, ai::Fi
  */
 bool L2A::LATEX::CompileLatexDocument(const ai::FilePath& tex_file, ai::FilePath& pdf_file)
 {
+    L2A::UTIL::TraceScope trace_scope("LatexEngine");
+
     // Get the pdf file name
     pdf_file = tex_file.GetParent();
     pdf_file.AddComponent(tex_file.GetFileNameNoExt() + ".pdf");
@@ -312,11 +395,71 @@ bool L2A::LATEX::CompileLatexDocument(const ai::FilePath& tex_file, ai::FilePath
         return false;
 }
 
+/**
+ * \brief Get the header resolver for the LaTeX headers. The resolver keeps the resolved headers of all documents
+ * during the session.
+ */
+static L2A::UTIL::HeaderResolver& GetLatexHeaderResolver()
+{
+    static L2A::UTIL::HeaderResolver header_resolver;
+    return header_resolver;
+}
+
+/**
+ * \brief Get the resolved header of the current document. If there is no header yet, the default header that will be
+ * created when the items are compiled is resolved, so the result is the same as after the header is created.
+ */
+static L2A::UTIL::ResolvedHeader GetDocumentHeader()
+{
+    const ai::FilePath header_path = L2A::LATEX::GetHeaderPath(false);
+    if (L2A::UTIL::IsFile(header_path)) return L2A::LATEX::ResolveHeader(header_path);
+    return GetLatexHeaderResolver().ResolveText(L2A::UTIL::StringAiToStd(L2A::LATEX::GetDefaultHeader()),
+        L2A::UTIL::FilePathAiToStd(header_path.GetParent()));
+}
+
+/**
+ *
+ */
+L2A::UTIL::BackgroundCompileJob L2A::LATEX::CreateBackgroundCompileJob(
+    const std::vector<L2A::UTIL::RedoPlanItem>& items, const ai::FilePath& directory)
+{
+    L2A::UTIL::BackgroundCompileJob job;
+    job.directory_ = L2A::UTIL::FilePathAiToStd(directory);
+    job.document_path_ = L2A::UTIL::FilePathAiToStd(L2A::UTIL::GetDocumentPath());
+
+    // The digest and the header of the job are taken from the same resolved header, so the pages match the digest.
+    const L2A::UTIL::ResolvedHeader resolved_header = GetDocumentHeader();
+    job.compile_digest_ = L2A::UTIL::StringAiToStd(
+        GetCompileDigest(resolved_header.digest_, L2A::Global().latex_engine_, L2A::Global().latex_command_options_));
+
+    // Each unique item that is not up to date is one page in the document.
+    const L2A::UTIL::RedoPlan plan = L2A::UTIL::CreateRedoPlan(items);
+    for (const auto& i_item : plan.compile_items_) job.pages_.push_back(items[i_item]);
+
+    job.header_name_ = L2A::NAMES::tex_header_name_;
+    job.header_text_ = resolved_header.text_;
+    job.local_packages_ = resolved_header.local_packages_;
+
+    // The commands are created for the files in the compile directory.
+    ai::FilePath tex_file = directory;
+    tex_file.AddComponent(ai::UnicodeString(L2A::NAMES::create_pdf_tex_name_));
+    ai::FilePath pdf_file = directory;
+    pdf_file.AddComponent(tex_file.GetFileNameNoExt() + ".pdf");
+    job.tex_name_ = L2A::UTIL::StringAiToStd(tex_file.GetFileName());
+    job.tex_text_ = L2A::UTIL::GetLatexDocumentText(
+        L2A::UTIL::GetLatexPagesCode(items, plan.compile_items_), L2A::NAMES::tex_header_name_);
+    job.latex_command_ = L2A::UTIL::StringAiToStd(GetLatexCompileCommand(tex_file));
+    job.split_command_ = L2A::UTIL::StringAiToStd(GetSplitPdfPagesCommand(pdf_file, L2A::Global().gs_command_));
+    return job;
+}
+
 /**
  *
  */
 ai::FilePath L2A::LATEX::WriteLatexFiles(const ai::UnicodeString& latex_code, const ai::FilePath& tex_folder)
 {
+    L2A::UTIL::TraceScope trace_scope("WriteLatexFiles");
+
     // Make sure the directory exists.
     L2A::UTIL::CreateDirectoryL2A(tex_folder);
 
@@ -326,10 +469,17 @@ ai::FilePath L2A::LATEX::WriteLatexFiles(const ai::UnicodeString& latex_code, co
     tex_header_file.AddComponent(ai::UnicodeString(L2A::NAMES::tex_header_name_));
     tex_file.AddComponent(ai::UnicodeString(L2A::NAMES::create_pdf_tex_name_));
 
-    // Create the header in the temp directory.
-    ai::UnicodeString header_string =
-        L2A::UTIL::StringStdToAi(L2A::LATEX::GetHeaderWithIncludedInputs(GetHeaderPath()));
-    L2A::UTIL::WriteFileUTF8(tex_header_file, header_string, true);
+    // Create the header and the local packages in the temp directory. They are only written if they changed since
+    // the last compilation.
+    const std::filesystem::path tex_folder_std = L2A::UTIL::FilePathAiToStd(tex_folder);
+    const auto& resolved_header = ResolveHeader(GetHeaderPath());
+    L2A::UTIL::WriteFileIfChanged(L2A::UTIL::FilePathAiToStd(tex_header_file), resolved_header.text_);
+    for (const auto& package : resolved_header.local_packages_)
+    {
+        const std::filesystem::path package_path = tex_folder_std / package.relative_path_;
+        std::filesystem::create_directories(package_path.parent_path());
+        L2A::UTIL::WriteFileIfChanged(package_path, package.text_);
+    }
 
     // Creates the LaTeX file.
     L2A::UTIL::WriteFileUTF8(tex_file, GetLatexString(latex_code), true);
@@ -366,45 +516,66 @@ ai::FilePath L2A::LATEX::GetHeaderPath(const bool create_default_if_not_exist)
 /**
  *
  */
-std::string L2A::LATEX::GetHeaderWithIncludedInputs(const ai::FilePath& header_path)
+const L2A::UTIL::ResolvedHeader& L2A::LATEX::ResolveHeader(const ai::FilePath& header_path)
 {
-    // Get the full path here, so relative directories will be resolved.
-    auto header_path_full = L2A::UTIL::GetFullFilePath(header_path);
-    auto header_dir = header_path_full.GetParent();
-    auto header_text = L2A::UTIL::ReadFileUTF8(header_path_full);
-    std::string header_string = L2A::UTIL::StringAiToStd(header_text);
-
-    // Regex string to find inputs in the header.
-    std::regex re_input("\\\\(input) *\\{.*\\}");
-
-    // Loop over inputs.
-    auto input_begin = std::sregex_iterator(header_string.begin(), header_string.end(), re_input);
-    auto input_end = std::sregex_iterator();
-    std::string return_header("");
-    long long int last_pos = 0;
-    for (std::sregex_iterator i = input_begin; i != input_end; ++i)
-    {
-        std::smatch match = *i;
-        return_header += header_string.substr(last_pos, match.position() - last_pos);
-
-        // Get the path of the input_file.
-        std::smatch brackets_match;
-        std::regex re_brackets("\\{.*\\}");
-        auto input_string = header_string.substr(match.position(), match.length());
-        std::regex_search(input_string, brackets_match, re_brackets);
-        std::string input_path_string = brackets_match.str(0);
-        input_path_string = input_path_string.substr(1, input_path_string.length() - 2);
-        auto input_header_path = header_dir;
-        input_header_path.AddComponent(ai::UnicodeString(input_path_string));
-        if (L2A::UTIL::IsFile(input_header_path))
-            return_header += GetHeaderWithIncludedInputs(input_header_path);
-        else
-            return_header += input_path_string;
+    L2A::UTIL::TraceScope trace_scope("ResolveHeader");
 
-        last_pos = match.position() + match.length();
+    const auto& resolved_header = GetLatexHeaderResolver().Resolve(L2A::UTIL::FilePathAiToStd(header_path));
+    if (!resolved_header.cycle_.empty())
+    {
+        ai::UnicodeString cycle_string;
+        for (const auto& cycle_file : resolved_header.cycle_)
+            cycle_string += "\n" + L2A::UTIL::FilePathStdToAi(cycle_file).GetFullPath();
+        l2a_error("The header '" + header_path.GetFullPath() + "' contains a cycle of inputs:" + cycle_string);
     }
-    return_header += header_string.substr(last_pos, header_string.length());
-    return return_header;
+    return resolved_header;
+}
+
+/**
+ *
+ */
+std::string L2A::LATEX::GetHeaderWithIncludedInputs(const ai::FilePath& header_path)
+{
+    return ResolveHeader(header_path).text_;
+}
+
+/**
+ *
+ */
+const L2A::UTIL::HeaderResolverStatistics& L2A::LATEX::GetHeaderResolverStatistics()
+{
+    return GetLatexHeaderResolver().GetStatistics();
+}
+
+/**
+ *
+ */
+ai::UnicodeString L2A::LATEX::GetCompileDigest(const std::string& header_string,
+    const ai::UnicodeString& latex_engine, const ai::UnicodeString& latex_command_options)
+{
+    // The version of the digest has to be increased if the way the items are compiled changes in a way that is not
+    // covered by the template.
+    static const char* compile_digest_version = "1";
+
+    ai::UnicodeString digest_input(compile_digest_version);
+    digest_input += "\n";
+    digest_input += ai::UnicodeString(L2A_LATEX_ITEM_);
+    digest_input += "\n";
+    digest_input += latex_engine;
+    digest_input += "\n";
+    digest_input += latex_command_options;
+    digest_input += "\n";
+    digest_input += L2A::UTIL::StringStdToAi(header_string);
+    return L2A::UTIL::StringHash(digest_input);
+}
+
+/**
+ *
+ */
+ai::UnicodeString L2A::LATEX::GetCompileDigest()
+{
+    return GetCompileDigest(
+        GetDocumentHeader().digest_, L2A::Global().latex_engine_, L2A::Global().latex_command_options_);
 }
 
 /**
@@ -638,3 +809,49 @@ bool L2A::LATEX::CheckLatexCommand(const ai::FilePath& path_latex)
         return false;
     }
 }
+
+/**
+ * \brief Call a command and return the first non empty line of its output. If the command fails, an empty string is
+ * returned.
+ */
+static ai::UnicodeString GetVersionOutputLine(const ai::UnicodeString& command)
+{
+    try
+    {
+        const auto command_result = L2A::UTIL::ExecuteCommandLine(command);
+        if (command_result.exit_status_ != 0) return ai::UnicodeString("");
+
+        std::istringstream output(L2A::UTIL::StringAiToStd(command_result.output_));
+        std::string line;
+        while (std::getline(output, line))
+        {
+            while (!line.empty() && (line.back() == '\r' || line.back() == ' ')) line.pop_back();
+            if (!line.empty()) return L2A::UTIL::StringStdToAi(line);
+        }
+    }
+    catch (...)
+    {
+    }
+    return ai::UnicodeString("");
+}
+
+/**
+ *
+ */
+ai::UnicodeString L2A::LATEX::GetLatexEngineVersion()
+{
+    const auto& global = L2A::Global();
+    const std::string command = L2A::UTIL::GetLatexEngineCommand(
+        L2A::UTIL::FilePathAiToStd(global.latex_bin_path_), L2A::UTIL::StringAiToStd(global.latex_engine_));
+    return GetVersionOutputLine(L2A::UTIL::StringStdToAi(command + " -version"));
+}
+
+/**
+ *
+ */
+ai::UnicodeString L2A::LATEX::GetGhostscriptVersion()
+{
+    const ai::UnicodeString& gs_command = L2A::Global().gs_command_;
+    if (gs_command == ai::UnicodeString("")) return ai::UnicodeString("");
+    return GetVersionOutputLine("\"" + gs_command + "\" --version");
+}
@@ -34,6 +34,7 @@
 #include "IllustratorSDK.h"
 
 #include "l2a_error.h"
+#include "l2a_latex_syntax.h"
 #include "l2a_names.h"
 
 
@@ -41,6 +42,14 @@ namespace L2A
 {
     // Forward declarations
     class Property;
+    namespace UTIL
+    {
+        struct BackgroundCompileJob;
+        struct CompileRecord;
+        struct HeaderResolverStatistics;
+        struct RedoPlanItem;
+        struct ResolvedHeader;
+    }  // namespace UTIL
 
     namespace LATEX
     {
@@ -58,6 +67,8 @@ namespace L2A
                 ok,
                 //! The latex command succeeded, but no file was created
                 error_tex_code,
+                //! The latex code has a syntax error, the latex command was not called
+                error_syntax,
                 //! The creation of the latex document failed
                 error_tex,
                 //! The split with ghostscript failed
@@ -77,6 +88,22 @@ namespace L2A
 
             //! Path to the tex header
             ai::FilePath tex_header_file_;
+
+            //! Digest of the header, engine and options the items were compiled with, see GetCompileDigest.
+            ai::UnicodeString compile_digest_;
+
+            //! Time in seconds the LaTeX engine spent on each page of the document, as written to the log file. If
+            //! the compilation failed, this contains the pages that were finished before the error.
+            std::vector<double> page_times_;
+
+            //! Time in seconds the LaTeX engine spent on the page of each item, negative if it is not known.
+            std::vector<double> compile_times_;
+
+            //! Syntax error found before the compilation.
+            L2A::UTIL::LatexSyntaxError syntax_error_;
+
+            //! Index of the item with the syntax error.
+            size_t syntax_error_item_ = 0;
         };
 
         /**
@@ -99,6 +126,12 @@ namespace L2A
         std::vector<ai::FilePath> SplitPdfPages(
             const ai::FilePath& pdf_file, const unsigned int& n_pages, const ai::UnicodeString& gs_command);
 
+        /**
+         * \brief Get the ghostscript command that splits up a pdf document into the files "<pdf name>_<page>.pdf". The
+         * command has to be executed in the directory of the pdf file.
+         */
+        ai::UnicodeString GetSplitPdfPagesCommand(const ai::FilePath& pdf_file, const ai::UnicodeString& gs_command);
+
         /**
          * \brief Create a latex document for a latex code string
          * @param (in/out) property Property containing the item property that should be converted. If everything is
@@ -110,7 +143,8 @@ namespace L2A
         /**
          * \brief Create a latex document for a latex code string
          * @param (in/out) properties Vector containing all item properties that should be converted. If everything
-         * is successful the pdf contents are stored in the properties.
+         * is successful the pdf contents are stored in the properties. If the syntax check is enabled, the code of the
+         * items is checked before the latex command is called.
          * @return Result of the latex creation function
          */
         std::pair<LatexCreationResult, std::vector<ai::FilePath>> CreateLatexItems(
@@ -120,9 +154,12 @@ namespace L2A
          * \brief Create a latex document for a latex code string.
          * @param (in) Latex_code String with the full latex code to be compiled.
          * @param (out) Path of the created pdf file.
+         * @param (out) compile_record Optional record where the time for writing the files and for the LaTeX engine
+         * is stored.
          * @return True if creation was successful.
          */
-        bool CreateLatexDocument(const ai::UnicodeString& latex_code, ai::FilePath& pdf_file);
+        bool CreateLatexDocument(const ai::UnicodeString& latex_code, ai::FilePath& pdf_file,
+            L2A::UTIL::CompileRecord* compile_record = nullptr);
 
         /**
          * \brief Actually compile the latex document.
@@ -132,6 +169,14 @@ namespace L2A
          */
         bool CompileLatexDocument(const ai::FilePath& tex_file, ai::FilePath& pdf_file);
 
+        /**
+         * \brief Create a job to compile the items that are not up to date in the background.
+         * @param items Items of the current document.
+         * @param directory Directory where the background compilation is done.
+         */
+        L2A::UTIL::BackgroundCompileJob CreateBackgroundCompileJob(
+            const std::vector<L2A::UTIL::RedoPlanItem>& items, const ai::FilePath& directory);
+
         /**
          * \brief Create all the files that are needed to create a latex document.
          * @return Path to the main latex document.
@@ -149,11 +194,36 @@ namespace L2A
          */
         ai::FilePath GetHeaderPath(const bool create_default_if_not_exist = true);
 
+        /**
+         * \brief Get the resolved header with all its dependencies. The result is cached as long as none of the files
+         * the header depends on changes. An error is thrown if the inputs of the header contain a cycle.
+         */
+        const L2A::UTIL::ResolvedHeader& ResolveHeader(const ai::FilePath& header_path);
+
         /**
          * \brief Get the header as a string, where all inputs are resolved.
          */
         std::string GetHeaderWithIncludedInputs(const ai::FilePath& header_path);
 
+        /**
+         * \brief Get the statistics of the header resolver.
+         */
+        const L2A::UTIL::HeaderResolverStatistics& GetHeaderResolverStatistics();
+
+        /**
+         * \brief Get a digest of everything apart from the LaTeX code of the items that influences the created pdf
+         * files, i.e., the resolved header, the LaTeX engine, the command options and the template of the LaTeX
+         * document.
+         */
+        ai::UnicodeString GetCompileDigest(const std::string& header_string, const ai::UnicodeString& latex_engine,
+            const ai::UnicodeString& latex_command_options);
+
+        /**
+         * \brief Get the compile digest for the header of the current document and the current options. The digest of
+         * the resolved header is used, so changes in local packages are also covered.
+         */
+        ai::UnicodeString GetCompileDigest();
+
         /**
          * \brief Search the path to ghostscript on the system.
          */
@@ -185,6 +255,18 @@ namespace L2A
          * \brief Check that the stored LaTeX command is correct.
          */
         bool CheckLatexCommand(const ai::FilePath& path_latex);
+
+        /**
+         * \brief Get the first line of the version output of the LaTeX engine set in the options. If the engine can
+         * not be called, an empty string is returned.
+         */
+        ai::UnicodeString GetLatexEngineVersion();
+
+        /**
+         * \brief Get the version of the Ghostscript command set in the options. If Ghostscript can not be called, an
+         * empty string is returned.
+         */
+        ai::UnicodeString GetGhostscriptVersion();
     }  // namespace LATEX
 }  // namespace L2A
 
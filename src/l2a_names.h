@@ -46,6 +46,9 @@ namespace L2A
         //! Postfix to the document name for the pdf items.
         static const char* pdf_item_post_fix_ = "_LaTeX2AI_";
 
+        //! Name of the manifest of the pdf items in the L2A directory.
+        static const char* links_manifest_name_ = "LaTeX2AI_manifest.txt";
+
         //! Name for the item in ai.
         static const char* ai_item_name_ = "LaTeX2AI";
 
@@ -55,6 +58,15 @@ namespace L2A
             "LaTeX2AI_item"
             ".tex";
 
+        //! Name of the trace file of the item pipeline in the application data directory.
+        static const char* trace_file_name_ = "LaTeX2AI_trace.json";
+
+        //! Name of the directory in the application data directory, where the diagnostics report is written to.
+        static const char* report_directory_name_ = "LaTeX2AI_report";
+
+        //! Name of the directory in the temporary directory, where items are compiled in the background.
+        static const char* background_compile_directory_name_ = "LaTeX2AI_background";
+
         /**
          * \brief Get the name of a pdf for an item of the current document.
          */
@@ -39,8 +39,13 @@
 #include "l2a_ai_functions.h"
 #include "l2a_constants.h"
 #include "l2a_error.h"
+#include "l2a_file_system.h"
 #include "l2a_global.h"
 #include "l2a_item.h"
+#include "l2a_latex.h"
+#include "l2a_links_folder.h"
+#include "l2a_names.h"
+#include "l2a_string_functions.h"
 
 
 /*
@@ -74,8 +79,14 @@ L2APlugin::L2APlugin(SPPluginRef pluginRef)
       notify_document_save_as_(nullptr),
       notify_active_doc_view_title_changed_(nullptr),
       notify_CSXS_plugplug_setup_complete_(nullptr),
+      notifier_timer_(nullptr),
+      links_maintenance_timer_(nullptr),
+      header_watcher_timer_(nullptr),
       resource_manager_handle_(nullptr),
-      ui_manager_(nullptr)
+      ui_manager_(nullptr),
+      links_maintenance_(nullptr),
+      background_compile_(nullptr),
+      staged_compile_(nullptr)
 {
     // Set the name that of this plugin in Illustrator.
     strncpy(fPluginName, L2A_PLUGIN_NAME, kMaxStringLength);
@@ -100,33 +111,21 @@ ASErr L2APlugin::Notify(AINotifierMessage* message)
     {
         if (message->notifier == notify_selection_changed_)
         {
-            // Selection of art items changed in the document.
-
-            // Invalidate the entire document view bounds.
-            annotator_->InvalAnnotation();
-
-            // If the annotator is active, update the item vector.
-            annotator_->ArtSelectionChanged();
-
-            // Check if there is a single isolated l2a item.
-            AIArtHandle placed_item;
-            if (L2A::AI::GetSingleIsolationItem(placed_item))
-            {
-                if (!IsActiveDocumentCloudDocumentWithWarning())
-                {
-                    // Change the item
-                    ui_manager_->GetItemForm().OpenEditItemForm(placed_item);
-                }
-            }
+            // Selection of art items changed in the document. Bursts of these notifications are merged and processed
+            // once in the next timer call.
+            PostNotification(L2A::UTIL::NotifierEvent::selection_changed);
         }
-        else if (message->notifier == notify_active_doc_view_title_changed_ ||
-                 message->notifier == notify_document_save_ || message->notifier == notify_document_save_as_)
+        else if (message->notifier == notify_active_doc_view_title_changed_)
         {
-            if (!L2A::AI::IsActiveDocumentCloudDocument())
-            {
-                L2A::AI::UndoActivate();
-                L2A::CheckItemDataStructure();
-            }
+            // The title also changes when only the view of the same document is changed, e.g., the zoom level. The
+            // document check skips documents that did not change since their last check.
+            PostNotification(L2A::UTIL::NotifierEvent::document_changed, GetActiveDocumentKey());
+            ActivateHeaderWatcher();
+        }
+        else if (message->notifier == notify_document_save_ || message->notifier == notify_document_save_as_)
+        {
+            // The check has to be done before the document is saved, so it can not be delayed.
+            CheckActiveDocument();
         }
         else if (message->notifier == notify_CSXS_plugplug_setup_complete_)
         {
@@ -143,6 +142,30 @@ ASErr L2APlugin::Notify(AINotifierMessage* message)
     return error;
 }
 
+/*
+ */
+ASErr L2APlugin::GoTimer(AITimerMessage* message)
+{
+    ASErr error = kNoErr;
+
+    try
+    {
+        if (message->timer == notifier_timer_)
+            ProcessNotifications();
+        else if (message->timer == links_maintenance_timer_)
+            ProcessLinksMaintenanceResults();
+        else if (message->timer == header_watcher_timer_)
+            ProcessHeaderWatcher();
+    }
+    catch (L2A::ERR::Exception&)
+    {
+        sAIUser->MessageAlert(ai::UnicodeString("L2APlugin::GoTimer Error caught."));
+        error = 1;
+    }
+
+    return error;
+}
+
 /*
  */
 ASErr L2APlugin::Message(char* caller, char* selector, void* message)
@@ -241,6 +264,10 @@ ASErr L2APlugin::StartupPlugin(SPInterfaceMessage* message)
         // Lock the plug-in as we register callbacks in PlugPlug Setup
         // TODO check if this is needed
         ui_manager_ = std::make_unique<L2A::UI::Manager>();
+        links_maintenance_ = std::make_unique<L2A::UTIL::LinksMaintenanceWorker>(L2A::NAMES::pdf_item_post_fix_,
+            L2A::NAMES::links_manifest_name_, L2A::CONSTANTS::links_maintenance_bytes_per_second_,
+            L2A::CONSTANTS::links_maintenance_files_per_second_);
+        background_compile_ = std::make_unique<L2A::UTIL::BackgroundCompileWorker>();
         error = Plugin::LockPlugin(true);
         aisdk::check_ai_error(error);
     }
@@ -273,6 +300,16 @@ ASErr L2APlugin::ShutdownPlugin(SPInterfaceMessage* message)
         // Remove the UI event listeners
         ui_manager_->RemoveEventListeners();
 
+        // Stop the links maintenance, the queued jobs are done again with the next document check. Stopping waits
+        // at most for the current file of the worker.
+        if (links_maintenance_ != nullptr) links_maintenance_->Stop();
+        links_maintenance_ = nullptr;
+
+        // Stop the background compilation, a running LaTeX or ghostscript call of the worker is killed.
+        if (background_compile_ != nullptr) background_compile_->Stop();
+        background_compile_ = nullptr;
+        staged_compile_ = nullptr;
+
         // Dereference the annotator and the ui manager -> the objects will be delete here, otherwise we would have a
         // memory leak later
         annotator_ = nullptr;
@@ -454,6 +491,27 @@ ASErr L2APlugin::AddNotifier(SPInterfaceMessage* message)
         result = sAINotifier->AddNotifier(message->d.self, L2A_PLUGIN_NAME, kAICSXSPlugPlugSetupCompleteNotifier,
             &notify_CSXS_plugplug_setup_complete_);
         aisdk::check_ai_error(result);
+
+        // The timer that processes the merged notifications is called once per tick, and only active if there are
+        // pending notifications.
+        result = sAITimer->AddTimer(message->d.self, L2A_PLUGIN_NAME " Notifier", 1, &notifier_timer_);
+        aisdk::check_ai_error(result);
+        result = sAITimer->SetTimerActive(notifier_timer_, false);
+        aisdk::check_ai_error(result);
+
+        // The timer for the results of the links maintenance is only active while the worker has jobs.
+        result = sAITimer->AddTimer(
+            message->d.self, L2A_PLUGIN_NAME " Links Maintenance", 30, &links_maintenance_timer_);
+        aisdk::check_ai_error(result);
+        result = sAITimer->SetTimerActive(links_maintenance_timer_, false);
+        aisdk::check_ai_error(result);
+
+        // The header watcher polls the files of the header once per second. It is only active while a document is
+        // open and the option is set.
+        result = sAITimer->AddTimer(message->d.self, L2A_PLUGIN_NAME " Header Watcher", 60, &header_watcher_timer_);
+        aisdk::check_ai_error(result);
+        result = sAITimer->SetTimerActive(header_watcher_timer_, false);
+        aisdk::check_ai_error(result);
     }
     catch (ai::Error& ex)
     {
@@ -506,6 +564,9 @@ ASErr L2APlugin::SelectTool(AIToolMessage* message)
     {
         // Test the LaTeX2AI framework.
         L2A::TEST::TestFramework();
+
+        // Run the benchmarks.
+        L2A::TEST::BenchmarkMain();
     }
 #endif
 
@@ -579,3 +640,237 @@ ASErr L2APlugin::PostStartupPlugin()
     result = sAIUser->CreateCursorResourceMgr(fPluginRef, &resource_manager_handle_);
     return result;
 }
+
+/*
+ */
+void L2APlugin::PostNotification(const L2A::UTIL::NotifierEvent event, const std::string& document_key)
+{
+    if (!notifier_coalescer_.HasPending())
+    {
+        AIErr error = sAITimer->SetTimerActive(notifier_timer_, true);
+        l2a_check_ai_error(error);
+    }
+    notifier_coalescer_.Post(event, document_key);
+}
+
+/*
+ */
+void L2APlugin::ProcessNotifications()
+{
+    AIErr error = sAITimer->SetTimerActive(notifier_timer_, false);
+    l2a_check_ai_error(error);
+
+    const auto pending_events = notifier_coalescer_.TakePending();
+
+    // The document could have been closed since the notifications were received.
+    if (L2A::AI::GetDocumentCount() == 0) return;
+
+    if (pending_events.selection_changed_)
+    {
+        // If the annotator is active, update the item vector and invalidate the parts of the view where items
+        // changed.
+        annotator_->ArtSelectionChanged();
+
+        // Check if there is a single isolated l2a item.
+        AIArtHandle placed_item;
+        if (L2A::AI::GetSingleIsolationItem(placed_item))
+        {
+            if (!IsActiveDocumentCloudDocumentWithWarning())
+            {
+                // Change the item
+                ui_manager_->GetItemForm().OpenEditItemForm(placed_item);
+            }
+        }
+    }
+
+    if (pending_events.check_document_) CheckActiveDocument();
+}
+
+/*
+ */
+std::string L2APlugin::GetActiveDocumentKey() const
+{
+    if (L2A::AI::GetDocumentCount() == 0) return "";
+
+    // The handle alone is not unique, as it can be reused for a document that is opened after another one was closed.
+    AIDocumentHandle document = nullptr;
+    AIErr error = sAIDocument->GetDocument(&document);
+    l2a_check_ai_error(error);
+    return std::to_string((size_t)document) + ":" +
+           L2A::UTIL::StringAiToStd(L2A::UTIL::GetDocumentPath(false).GetFullPath());
+}
+
+/*
+ */
+L2A::UTIL::DocumentFingerprint L2APlugin::GetActiveDocumentFingerprint() const
+{
+    L2A::UTIL::DocumentFingerprint fingerprint;
+    fingerprint.document_key_ = GetActiveDocumentKey();
+    fingerprint.art_time_stamp_ = L2A::AI::GetGlobalArtTimeStamp();
+    const ai::FilePath document_path = L2A::UTIL::GetDocumentPath(false);
+    if (L2A::UTIL::IsFile(document_path))
+        fingerprint.links_write_time_ =
+            L2A::UTIL::GetLastWriteTime(L2A::UTIL::FilePathAiToStd(L2A::UTIL::GetPdfFileDirectory()));
+    return fingerprint;
+}
+
+/*
+ */
+void L2APlugin::CheckActiveDocument()
+{
+    if (L2A::AI::IsActiveDocumentCloudDocument()) return;
+
+    // Nothing relevant for LaTeX2AI changed since the last check of this document.
+    if (document_check_memo_.SkipCheck(GetActiveDocumentFingerprint())) return;
+
+    L2A::AI::UndoActivate();
+    L2A::CheckItemDataStructure();
+    L2A::WritePipelineTrace();
+
+    // The check itself can change the art and the links folder, therefore the fingerprint is taken after the check.
+    document_check_memo_.SetChecked(GetActiveDocumentFingerprint());
+}
+
+/*
+ */
+void L2APlugin::PostLinksMaintenanceJob(const L2A::UTIL::LinksMaintenanceJob& job)
+{
+    if (links_maintenance_ == nullptr) return;
+    links_maintenance_->Post(job);
+    AIErr error = sAITimer->SetTimerActive(links_maintenance_timer_, true);
+    l2a_check_ai_error(error);
+}
+
+/*
+ */
+L2A::UTIL::LinksMaintenanceStatistics L2APlugin::GetLinksMaintenanceStatistics() const
+{
+    if (links_maintenance_ == nullptr) return L2A::UTIL::LinksMaintenanceStatistics();
+    return links_maintenance_->GetStatistics();
+}
+
+/*
+ */
+void L2APlugin::ProcessLinksMaintenanceResults()
+{
+    if (links_maintenance_ == nullptr) return;
+    if (links_maintenance_->IsIdle() && !links_maintenance_->HasResults())
+    {
+        AIErr error = sAITimer->SetTimerActive(links_maintenance_timer_, false);
+        l2a_check_ai_error(error);
+    }
+
+    for (const auto& result : links_maintenance_->TakeResults())
+    {
+        // Removed files are no longer valid in the manifest.
+        if (!result.removed_files_.empty())
+        {
+            L2A::UTIL::LinksManifest manifest(result.links_directory_ / L2A::NAMES::links_manifest_name_);
+            for (const auto& file_name : result.removed_files_) manifest.Remove(file_name);
+            manifest.Write();
+        }
+
+        if (result.repair_files_.empty()) continue;
+
+        // The pdf files can only be written from the items of the active document. For other documents the check is
+        // done again, when they are activated.
+        bool is_active_document = L2A::AI::GetDocumentCount() > 0 && !L2A::AI::IsActiveDocumentCloudDocument() &&
+                                  L2A::UTIL::IsFile(L2A::UTIL::GetDocumentPath(false));
+        if (is_active_document)
+            is_active_document =
+                L2A::UTIL::FilePathAiToStd(L2A::UTIL::GetPdfFileDirectory()) == result.links_directory_;
+        if (is_active_document)
+        {
+            L2A::AI::UndoActivate();
+            L2A::RepairItemPDFFiles(result.repair_files_);
+        }
+        else
+            document_check_memo_.Clear();
+    }
+}
+
+/*
+ */
+L2A::UTIL::BackgroundCompileStatistics L2APlugin::GetBackgroundCompileStatistics() const
+{
+    if (background_compile_ == nullptr) return L2A::UTIL::BackgroundCompileStatistics();
+    return background_compile_->GetStatistics();
+}
+
+/*
+ */
+void L2APlugin::ActivateHeaderWatcher()
+{
+    if (!L2A::Global().watch_header_ || L2A::AI::GetDocumentCount() == 0) return;
+    AIErr error = sAITimer->SetTimerActive(header_watcher_timer_, true);
+    l2a_check_ai_error(error);
+}
+
+/*
+ */
+void L2APlugin::ProcessHeaderWatcher()
+{
+    if (background_compile_ == nullptr) return;
+
+    // Stage the pages of a finished background compilation.
+    if (background_compile_->HasResult())
+    {
+        auto result = background_compile_->TakeResult();
+        if (result->is_ok_) staged_compile_ = std::move(result);
+    }
+
+    // Without a document or the option there is nothing to watch until a document is activated again.
+    if (!L2A::Global().watch_header_ || L2A::AI::GetDocumentCount() == 0)
+    {
+        AIErr error = sAITimer->SetTimerActive(header_watcher_timer_, false);
+        l2a_check_ai_error(error);
+    }
+
+    // Only saved documents have a header.
+    if (!L2A::Global().watch_header_ || L2A::AI::GetDocumentCount() == 0 ||
+        L2A::AI::IsActiveDocumentCloudDocument() || !L2A::UTIL::IsFile(L2A::UTIL::GetDocumentPath(false)))
+    {
+        header_watcher_.Clear();
+        watched_header_path_.clear();
+        return;
+    }
+
+    // If another document is active, changes of its header before this point are not compiled in the background.
+    const ai::FilePath header_path = L2A::LATEX::GetHeaderPath(false);
+    const std::filesystem::path header_path_std = L2A::UTIL::FilePathAiToStd(header_path);
+    if (header_path_std != watched_header_path_)
+    {
+        watched_header_path_ = header_path_std;
+        WatchHeader(header_path);
+        return;
+    }
+    if (!header_watcher_.Poll()) return;
+
+    // The changed header can depend on other files.
+    WatchHeader(header_path);
+
+    // Compile the stale items in the background, the pages of a previous compilation are outdated.
+    staged_compile_ = nullptr;
+    std::vector<AIArtHandle> items;
+    L2A::AI::GetDocumentItems(items, L2A::AI::SelectionState::all);
+    ai::FilePath directory = L2A::UTIL::GetTemporaryDirectory();
+    directory.AddComponent(ai::UnicodeString(L2A::NAMES::background_compile_directory_name_));
+    const auto job = L2A::LATEX::CreateBackgroundCompileJob(L2A::GetRedoPlanItems(items), directory);
+    if (!job.pages_.empty()) background_compile_->Post(job);
+}
+
+/*
+ */
+void L2APlugin::WatchHeader(const ai::FilePath& header_path)
+{
+    try
+    {
+        header_watcher_.Watch(L2A::LATEX::ResolveHeader(header_path).dependencies_);
+    }
+    catch (L2A::ERR::Exception&)
+    {
+        // The inputs of the header contain a cycle, the user was already informed about it. Only the header itself is
+        // watched until it changes.
+        header_watcher_.Watch({L2A::UTIL::GetHeaderDependency(L2A::UTIL::FilePathAiToStd(header_path))});
+    }
+}
@@ -34,6 +34,11 @@
 #include "Plugin.hpp"
 
 #include "l2a_annotator.h"
+#include "l2a_background_compile.h"
+#include "l2a_document_fingerprint.h"
+#include "l2a_header_resolver.h"
+#include "l2a_links_maintenance.h"
+#include "l2a_notifier_coalescer.h"
 #include "l2a_ui_manager.h"
 
 
@@ -87,12 +92,56 @@ class L2APlugin : public Plugin
      */
     virtual ASErr Notify(AINotifierMessage* message);
 
+    /**
+     * \brief Is called by the timers of the plugin.
+     */
+    virtual ASErr GoTimer(AITimerMessage* message);
+
    public:
     /**
      * \brief Return a reference to the UI manager
      */
     L2A::UI::Manager& GetUiManager() { return *ui_manager_; }
 
+    /**
+     * \brief Return the statistics of the received and processed notifications.
+     */
+    const L2A::UTIL::NotifierStatistics& GetNotifierStatistics() const { return notifier_coalescer_.GetStatistics(); }
+
+    /**
+     * \brief Return the statistics of the performed and skipped document checks.
+     */
+    const L2A::UTIL::DocumentCheckStatistics& GetDocumentCheckStatistics() const
+    {
+        return document_check_memo_.GetStatistics();
+    }
+
+    /**
+     * \brief Add a job for the background links maintenance and activate the timer that processes its results.
+     */
+    void PostLinksMaintenanceJob(const L2A::UTIL::LinksMaintenanceJob& job);
+
+    /**
+     * \brief Return the statistics of the background links maintenance.
+     */
+    L2A::UTIL::LinksMaintenanceStatistics GetLinksMaintenanceStatistics() const;
+
+    /**
+     * \brief Activate the timer of the header watcher, if the header is watched and a document is open. The timer
+     * deactivates itself once there is no document left or the option is turned off.
+     */
+    void ActivateHeaderWatcher();
+
+    /**
+     * \brief Return the pages of the last background compilation, or nullptr if there are none.
+     */
+    const L2A::UTIL::BackgroundCompileResult* GetStagedCompile() const { return staged_compile_.get(); }
+
+    /**
+     * \brief Return the statistics of the background compilation.
+     */
+    L2A::UTIL::BackgroundCompileStatistics GetBackgroundCompileStatistics() const;
+
    protected:
     /**
      * \brief Set a link to this plugin in the global object
@@ -179,6 +228,46 @@ class L2APlugin : public Plugin
      */
     ASErr PostStartupPlugin();
 
+    /**
+     * \brief Add a notification to the coalescer and activate the timer that processes the notifications.
+     */
+    void PostNotification(const L2A::UTIL::NotifierEvent event, const std::string& document_key = "");
+
+    /**
+     * \brief Process the merged notifications.
+     */
+    void ProcessNotifications();
+
+    /**
+     * \brief Get a key that identifies the active document. If no document is open, an empty string is returned.
+     */
+    std::string GetActiveDocumentKey() const;
+
+    /**
+     * \brief Get the fingerprint of the active document.
+     */
+    L2A::UTIL::DocumentFingerprint GetActiveDocumentFingerprint() const;
+
+    /**
+     * \brief Check the item data structure of the active document, if it changed since the last check.
+     */
+    void CheckActiveDocument();
+
+    /**
+     * \brief Process the results of the background links maintenance on the main thread.
+     */
+    void ProcessLinksMaintenanceResults();
+
+    /**
+     * \brief Check if the header of the active document changed and compile the stale items in the background.
+     */
+    void ProcessHeaderWatcher();
+
+    /**
+     * \brief Watch the files the given header depends on.
+     */
+    void WatchHeader(const ai::FilePath& header_path);
+
    private:
     //! Store handle for each tool of the plugin
     std::vector<AIToolHandle> tool_handles_;
@@ -194,6 +283,27 @@ class L2APlugin : public Plugin
     //! Handle for plug plug actions
     AINotifierHandle notify_CSXS_plugplug_setup_complete_;
 
+    //! Handle for the timer that processes the merged notifications.
+    AITimerHandle notifier_timer_;
+
+    //! Object to merge bursts of notifications.
+    L2A::UTIL::NotifierCoalescer notifier_coalescer_;
+
+    //! Handle for the timer that processes the results of the links maintenance.
+    AITimerHandle links_maintenance_timer_;
+
+    //! Handle for the timer that watches the header of the active document.
+    AITimerHandle header_watcher_timer_;
+
+    //! Watcher for the files of the header of the active document.
+    L2A::UTIL::HeaderWatcher header_watcher_;
+
+    //! Path to the watched header.
+    std::filesystem::path watched_header_path_;
+
+    //! Fingerprints of the checked documents.
+    L2A::UTIL::DocumentCheckMemo document_check_memo_;
+
     //! Handle for the resource manager added by this plug-in used for setting cursor
     AIResourceManagerHandle resource_manager_handle_;
 
@@ -202,6 +312,15 @@ class L2APlugin : public Plugin
 
     //! User Interface manager
     std::unique_ptr<L2A::UI::Manager> ui_manager_;
+
+    //! Background worker for the links folders.
+    std::unique_ptr<L2A::UTIL::LinksMaintenanceWorker> links_maintenance_;
+
+    //! Background worker to compile the items after the header changed.
+    std::unique_ptr<L2A::UTIL::BackgroundCompileWorker> background_compile_;
+
+    //! Pages of the last background compilation, they are used when the items are redone.
+    std::unique_ptr<L2A::UTIL::BackgroundCompileResult> staged_compile_;
 };
 
 #endif  // L2A_PLUGIN_H_
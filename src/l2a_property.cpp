@@ -39,6 +39,8 @@
 #include "l2a_string_functions.h"
 #include "l2a_utils.h"
 
+#include <algorithm>
+
 /**
  *
  */
@@ -69,6 +71,8 @@ void L2A::Property::DefaultPropertyValues()
     pdf_file_encoded_ = ai::UnicodeString("");
     pdf_file_hash_ = ai::UnicodeString("");
     pdf_file_hash_method_ = HashMethod::none;
+    compile_digest_ = ai::UnicodeString("");
+    compile_time_ = -1.0;
 }
 
 /**
@@ -102,6 +106,19 @@ void L2A::Property::SetFromParameterList(const L2A::UTIL::ParameterList& propert
     cursor_position_ = property_parameter_list.GetSubList(ai::UnicodeString("latex"))
                            ->GetIntOption(ai::UnicodeString("cursor_position"));
 
+    // Digest of the header and options the item was compiled with, this does not exist for older items.
+    const auto latex_sub_list = property_parameter_list.GetSubList(ai::UnicodeString("latex"));
+    if (latex_sub_list->OptionExists(ai::UnicodeString("compile_digest")))
+        compile_digest_ = latex_sub_list->GetStringOption(ai::UnicodeString("compile_digest"));
+    else
+        compile_digest_ = ai::UnicodeString("");
+
+    // Time of the last compilation in microseconds, this does not exist for older items.
+    if (latex_sub_list->OptionExists(ai::UnicodeString("compile_time_us")))
+        compile_time_ = latex_sub_list->GetIntOption(ai::UnicodeString("compile_time_us")) * 1e-6;
+    else
+        compile_time_ = -1.0;
+
     if (property_parameter_list.SubListExists(ai::UnicodeString("pdf_file_contents")))
     {
         const std::shared_ptr<const L2A::UTIL::ParameterList>& pdf_sub_list =
@@ -169,6 +186,13 @@ L2A::UTIL::ParameterList L2A::Property::ToParameterList(const bool write_pdf_con
     // Cursor position.
     tex_sub_list->SetOption(ai::UnicodeString("cursor_position"), cursor_position_);
 
+    // Digest of the header and options.
+    if (!compile_digest_.empty()) tex_sub_list->SetOption(ai::UnicodeString("compile_digest"), compile_digest_);
+
+    // Time of the last compilation in microseconds.
+    if (compile_time_ >= 0.0)
+        tex_sub_list->SetOption(ai::UnicodeString("compile_time_us"), (int)std::min(compile_time_ * 1e6, 2e9));
+
     if (write_pdf_content && !pdf_file_hash_.empty())
     {
         // Add the encoded pdf file to the parameter list.
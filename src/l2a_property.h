@@ -296,6 +296,36 @@ namespace L2A
          */
         const semver::version& GetVersion() const { return version_; }
 
+        /**
+         * \brief Get the digest of the header, engine and options the pdf file was compiled with. Items created with
+         * older versions of LaTeX2AI do not have a digest.
+         */
+        const ai::UnicodeString& GetCompileDigest() const { return compile_digest_; }
+
+        /**
+         * \brief Set the digest of the header, engine and options the pdf file was compiled with.
+         */
+        void SetCompileDigest(const ai::UnicodeString& compile_digest) { compile_digest_ = compile_digest; }
+
+        /**
+         * \brief Check if the item was compiled with a different header, engine or options than the given ones.
+         */
+        bool IsStale(const ai::UnicodeString& current_compile_digest) const
+        {
+            return compile_digest_.empty() || compile_digest_ != current_compile_digest;
+        }
+
+        /**
+         * \brief Get the time in seconds the LaTeX engine spent on the page of this item in the last compilation. A
+         * negative value is returned if the time is not known.
+         */
+        double GetCompileTime() const { return compile_time_; }
+
+        /**
+         * \brief Set the time in seconds the LaTeX engine spent on the page of this item.
+         */
+        void SetCompileTime(const double compile_time) { compile_time_ = compile_time; }
+
        private:
         //! Horizontal and Vertical alignment of the text.
         TextAlignHorizontal text_align_horizontal_;
@@ -316,6 +346,12 @@ namespace L2A
         //! Method used to get the file hash.
         HashMethod pdf_file_hash_method_;
 
+        //! Digest of the header, engine and options the pdf file was compiled with.
+        ai::UnicodeString compile_digest_;
+
+        //! Time in seconds the LaTeX engine spent on the page of this item, negative if it is not known.
+        double compile_time_;
+
         //! Version used to created this property
         //! This version will not be saved when the item is written to text, but rather the current version will be
         //! saved. This means that all compatibility issues have to be resoled in the time between reading and writing
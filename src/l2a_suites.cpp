@@ -59,6 +59,7 @@ extern "C"
     AIPathSuite* sAIPath = nullptr;
     AIPathStyleSuite* sAIPathStyle = nullptr;
     AILayerSuite* sAILayer = nullptr;
+    AITimerSuite* sAITimer = nullptr;
 }
 
 ImportSuite gImportSuites[] = {kAIToolSuite, kAIToolVersion, &sAITool, kAIUnicodeStringSuite, kAIUnicodeStringVersion,
@@ -101,5 +102,7 @@ ImportSuite gImportSuites[] = {kAIToolSuite, kAIToolVersion, &sAITool, kAIUnicod
     kAIPathStyleSuite, kAIPathStyleSuiteVersion, &sAIPathStyle,
     //
     kAILayerSuite, kAILayerSuiteVersion, &sAILayer,
+    //
+    kAITimerSuite, kAITimerSuiteVersion, &sAITimer,
 
     nullptr, 0, nullptr};
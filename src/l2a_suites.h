@@ -38,6 +38,7 @@
 #include "AIDocumentList.h"
 #include "AIIsolationMode.h"
 #include "AIStringFormatUtils.h"
+#include "AITimer.h"
 #include "AITransformArt.h"
 #include "Suites.hpp"
 
@@ -65,5 +66,6 @@ extern "C" AIActionManagerSuite* sAIActionManager;
 extern "C" AIPathSuite* sAIPath;
 extern "C" AIPathStyleSuite* sAIPathStyle;
 extern "C" AILayerSuite* sAILayer;
+extern "C" AITimerSuite* sAITimer;
 
 #endif  // L2A_SUITES_H_
@@ -169,6 +169,24 @@ ASErr L2A::UI::Debug::SendData()
         debug_parameter_list->SetOption(ai::UnicodeString("action"), ai::UnicodeString("redo_items"));
     else
         l2a_error("Got unknown action type");
+
+    // Time spent on the pages that were finished before the error, in milliseconds.
+    const auto& page_times = latex_creation_result_.page_times_;
+    size_t n_timed_pages = 0;
+    size_t slowest_page = 0;
+    for (size_t i_page = 0; i_page < page_times.size(); i_page++)
+    {
+        if (page_times[i_page] < 0.0) continue;
+        n_timed_pages++;
+        if (page_times[i_page] > page_times[slowest_page] || page_times[slowest_page] < 0.0) slowest_page = i_page;
+    }
+    debug_parameter_list->SetOption(ai::UnicodeString("n_timed_pages"), (unsigned int)n_timed_pages);
+    if (n_timed_pages > 0)
+    {
+        debug_parameter_list->SetOption(ai::UnicodeString("slowest_page"), (unsigned int)(slowest_page + 1));
+        debug_parameter_list->SetOption(
+            ai::UnicodeString("slowest_page_ms"), (int)(page_times[slowest_page] * 1e3 + 0.5));
+    }
     SendDataWrapper(debug_parameter_list, EVENT_TYPE_UPDATE);
 
     return kNoErr;
@@ -34,9 +34,11 @@
 #include "l2a_ai_functions.h"
 #include "l2a_global.h"
 #include "l2a_latex.h"
+#include "l2a_latex_syntax.h"
 #include "l2a_parameter_list.h"
 #include "l2a_plugin.h"
 #include "l2a_string_functions.h"
+#include "l2a_trace.h"
 
 
 /**
@@ -49,6 +51,8 @@ const std::string L2A::UI::Item::EVENT_TYPE_READY = L2A::UI::Item::EVENT_TYPE_BA
 const std::string L2A::UI::Item::EVENT_TYPE_OK = L2A::UI::Item::EVENT_TYPE_BASE + ".ok";
 const std::string L2A::UI::Item::EVENT_TYPE_UPDATE = L2A::UI::Item::EVENT_TYPE_BASE + ".update";
 const std::string L2A::UI::Item::EVENT_TYPE_SET_CLOSE_ON_FOCUS = L2A::UI::Item::EVENT_TYPE_BASE + ".set_close_on_focus";
+const std::string L2A::UI::Item::EVENT_TYPE_CHECK_SYNTAX = L2A::UI::Item::EVENT_TYPE_BASE + ".check_syntax";
+const std::string L2A::UI::Item::EVENT_TYPE_SYNTAX = L2A::UI::Item::EVENT_TYPE_BASE + ".syntax";
 
 
 /**
@@ -58,8 +62,9 @@ L2A::UI::Item::Item() : FormBase(FORM_NAME, FORM_ID.c_str(), EVENT_TYPE_BASE)
 {
     // If we don't do this this way, we get a compiler error
     std::vector<EventListenerData> event_listener_data = {
-        {EVENT_TYPE_READY, CallbackHandler<Item, &Item::CallbackFormReady>()},  //
-        {EVENT_TYPE_OK, CallbackHandler<Item, &Item::CallbackOk>()}             //
+        {EVENT_TYPE_READY, CallbackHandler<Item, &Item::CallbackFormReady>()},          //
+        {EVENT_TYPE_OK, CallbackHandler<Item, &Item::CallbackOk>()},                    //
+        {EVENT_TYPE_CHECK_SYNTAX, CallbackHandler<Item, &Item::CallbackCheckSyntax>()}  //
     };
     event_listener_data_ = std::move(event_listener_data);
 }
@@ -132,6 +137,27 @@ void L2A::UI::Item::CallbackOk(const csxs::event::Event* const eventParam)
     {
         l2a_error("Got unexpected ActionType");
     }
+    L2A::WritePipelineTrace();
+}
+
+/**
+ *
+ */
+void L2A::UI::Item::CallbackCheckSyntax(const csxs::event::Event* const eventParam)
+{
+    if (!L2A::Global().check_latex_syntax_)
+    {
+        SendSyntaxCheck(nullptr, false);
+        return;
+    }
+
+    L2A::UTIL::ParameterList form_return_data(L2A::UTIL::StringStdToAi(eventParam->data));
+    const ai::UnicodeString latex_code = form_return_data.GetSubList(ai::UnicodeString("l2a_item"))
+                                             ->GetSubList(ai::UnicodeString("latex"))
+                                             ->GetMainOption();
+    L2A::UTIL::LatexSyntaxError syntax_error;
+    const bool is_ok = L2A::UTIL::CheckLatexSyntax(L2A::UTIL::StringAiToStd(latex_code), syntax_error);
+    SendSyntaxCheck(is_ok ? nullptr : &syntax_error, false);
 }
 
 /**
@@ -139,6 +165,8 @@ void L2A::UI::Item::CallbackOk(const csxs::event::Event* const eventParam)
  */
 void L2A::UI::Item::CreateNewItem(const L2A::UTIL::ParameterList& item_data_from_form)
 {
+    L2A::UTIL::TraceScope trace_scope("CreateItem");
+
     L2A::AI::SetUndoText(
         ai::UnicodeString("Undo Create LaTeX2AI Item"), ai::UnicodeString("Undo Create LaTeX2AI Item"));
 
@@ -147,6 +175,8 @@ void L2A::UI::Item::CreateNewItem(const L2A::UTIL::ParameterList& item_data_from
     if (latex_create_result.result_ == L2A::LATEX::LatexCreationResult::Result::ok)
     {
         // Create the new item
+        property_.SetCompileDigest(latex_create_result.compile_digest_);
+        property_.SetCompileTime(latex_create_result.compile_times_[0]);
         L2A::Item(new_item_insertion_point_, property_, pdf_file);
 
         // Everything worked fine, we can close the form now
@@ -159,6 +189,11 @@ void L2A::UI::Item::CreateNewItem(const L2A::UTIL::ParameterList& item_data_from
         L2A::GlobalPluginMutable().GetUiManager().GetDebugForm().OpenDebugForm(
             Debug::Action::create_item, latex_create_result);
     }
+    else if (latex_create_result.result_ == L2A::LATEX::LatexCreationResult::Result::error_syntax)
+    {
+        // The form stays open, so the user can fix the code
+        SendSyntaxCheck(&latex_create_result.syntax_error_, true);
+    }
     else
     {
         // Ensure the form is closed on unexpected errors as well
@@ -171,6 +206,8 @@ void L2A::UI::Item::CreateNewItem(const L2A::UTIL::ParameterList& item_data_from
  */
 void L2A::UI::Item::EditItem(const ai::UnicodeString& return_value, const L2A::UTIL::ParameterList& item_data_from_form)
 {
+    L2A::UTIL::TraceScope trace_scope("EditItem");
+
     L2A::AI::SetUndoText(
         ai::UnicodeString("Undo Change LaTeX2AI Item"), ai::UnicodeString("Redo Change LaTeX2AI Item"));
 
@@ -190,6 +227,11 @@ void L2A::UI::Item::EditItem(const ai::UnicodeString& return_value, const L2A::U
             Debug::Action::edit_item, change_item_result.latex_creation_result_);
         return;
     }
+    else if (change_item_result.result_ == L2A::ItemChangeResult::Result::syntax_error)
+    {
+        SendSyntaxCheck(&change_item_result.latex_creation_result_.syntax_error_, true);
+        return;
+    }
 }
 
 /**
@@ -211,11 +253,12 @@ ASErr L2A::UI::Item::SendData()
     {
         ai::UnicodeString key_boundary_box("boundary_box_state");
         form_parameter_list->SetOption(key_latex, true);
-        if (change_item_->IsDiamond())
+        const auto geometry = change_item_->GetGeometry();
+        if (geometry.IsDiamond())
         {
             form_parameter_list->SetOption(key_boundary_box, ai::UnicodeString("diamond"));
         }
-        else if (change_item_->IsStretched())
+        else if (geometry.IsStretched())
         {
             form_parameter_list->SetOption(key_boundary_box, ai::UnicodeString("stretched"));
         }
@@ -248,3 +291,22 @@ void L2A::UI::Item::SetCloseOnFocus(const bool value)
     form_parameter_list->SetOption(ai::UnicodeString("close_on_focus"), value);
     SendDataWrapper(form_parameter_list, EVENT_TYPE_SET_CLOSE_ON_FOCUS);
 }
+
+/**
+ *
+ */
+void L2A::UI::Item::SendSyntaxCheck(const L2A::UTIL::LatexSyntaxError* syntax_error, const bool select_error)
+{
+    auto form_parameter_list = std::make_shared<L2A::UTIL::ParameterList>();
+    if (syntax_error != nullptr)
+    {
+        form_parameter_list->SetOption(ai::UnicodeString("syntax_error"),
+            L2A::UTIL::StringStdToAi(L2A::UTIL::GetLatexSyntaxErrorText(*syntax_error)));
+        form_parameter_list->SetOption(
+            ai::UnicodeString("syntax_error_position"), (int)syntax_error->character_offset_);
+    }
+    else
+        form_parameter_list->SetOption(ai::UnicodeString("syntax_error"), ai::UnicodeString(""));
+    form_parameter_list->SetOption(ai::UnicodeString("select_error"), select_error);
+    SendDataWrapper(form_parameter_list, EVENT_TYPE_SYNTAX);
+}
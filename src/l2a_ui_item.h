@@ -49,6 +49,8 @@ namespace L2A::UI
         static const std::string EVENT_TYPE_OK;
         static const std::string EVENT_TYPE_UPDATE;
         static const std::string EVENT_TYPE_SET_CLOSE_ON_FOCUS;
+        static const std::string EVENT_TYPE_CHECK_SYNTAX;
+        static const std::string EVENT_TYPE_SYNTAX;
 
        public:
         /**
@@ -83,6 +85,11 @@ namespace L2A::UI
          */
         void CallbackOk(const csxs::event::Event* const eventParam);
 
+        /**
+         * @brief Callback when the LaTeX code in the form changed, the code is checked for syntax errors
+         */
+        void CallbackCheckSyntax(const csxs::event::Event* const eventParam);
+
         /**
          * @brief Compile the data from the form to a new L2A item
          */
@@ -103,6 +110,13 @@ namespace L2A::UI
          */
         void SetCloseOnFocus(const bool value);
 
+        /**
+         * \brief Send the result of the syntax check to the form.
+         * @param syntax_error Error in the LaTeX code, or nullptr if the code has no error.
+         * @param select_error If the cursor in the form is set to the position of the error.
+         */
+        void SendSyntaxCheck(const L2A::UTIL::LatexSyntaxError* syntax_error, const bool select_error);
+
         /**
          * @brief Define what the current action of the form is
          */
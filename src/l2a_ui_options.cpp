@@ -33,12 +33,19 @@
 
 #include "l2a_ai_functions.h"
 #include "l2a_constants.h"
+#include "l2a_document_footprint.h"
 #include "l2a_execute.h"
 #include "l2a_file_system.h"
 #include "l2a_global.h"
 #include "l2a_latex.h"
+#include "l2a_names.h"
 #include "l2a_parameter_list.h"
+#include "l2a_plugin.h"
 #include "l2a_string_functions.h"
+#include "l2a_trace.h"
+
+#include <filesystem>
+#include <sstream>
 
 /**
  * \brief Set the names for item forms
@@ -56,6 +63,9 @@ const std::string L2A::UI::Options::EVENT_TYPE_SELECT_LATEX_BIN = L2A::UI::Optio
 const std::string L2A::UI::Options::EVENT_TYPE_OPEN_HEADER = L2A::UI::Options::EVENT_TYPE_BASE + ".open_header";
 const std::string L2A::UI::Options::EVENT_TYPE_CREATE_DEFAULT_HEADER =
     L2A::UI::Options::EVENT_TYPE_BASE + ".create_default_header";
+const std::string L2A::UI::Options::EVENT_TYPE_SHOW_DIAGNOSTICS =
+    L2A::UI::Options::EVENT_TYPE_BASE + ".show_diagnostics";
+const std::string L2A::UI::Options::EVENT_TYPE_WRITE_REPORT = L2A::UI::Options::EVENT_TYPE_BASE + ".write_report";
 
 /**
  *
@@ -64,13 +74,15 @@ L2A::UI::Options::Options() : FormBase(FORM_NAME, FORM_ID.c_str(), EVENT_TYPE_BA
 {
     // If we don't do this this way, we get a compiler error
     std::vector<EventListenerData> event_listener_data = {
-        {EVENT_TYPE_READY, CallbackHandler<Options, &Options::CallbackFormReady>()},                           //
-        {EVENT_TYPE_SAVE, CallbackHandler<Options, &Options::CallbackSave>()},                                 //
-        {EVENT_TYPE_GET_DEFAULT_VALUES, CallbackHandler<Options, &Options::CallbackGetDefaultValues>()},       //
-        {EVENT_TYPE_SELECT_GHOST_SCRIPT, CallbackHandler<Options, &Options::CallbackSelectGhostScript>()},     //
-        {EVENT_TYPE_SELECT_LATEX_BIN, CallbackHandler<Options, &Options::CallbackSelectLatex>()},              //
-        {EVENT_TYPE_OPEN_HEADER, CallbackHandler<Options, &Options::CallbackOpenHeader>()},                    //
-        {EVENT_TYPE_CREATE_DEFAULT_HEADER, CallbackHandler<Options, &Options::CallbackCreateDefaultHeader>()}  //
+        {EVENT_TYPE_READY, CallbackHandler<Options, &Options::CallbackFormReady>()},                            //
+        {EVENT_TYPE_SAVE, CallbackHandler<Options, &Options::CallbackSave>()},                                  //
+        {EVENT_TYPE_GET_DEFAULT_VALUES, CallbackHandler<Options, &Options::CallbackGetDefaultValues>()},        //
+        {EVENT_TYPE_SELECT_GHOST_SCRIPT, CallbackHandler<Options, &Options::CallbackSelectGhostScript>()},      //
+        {EVENT_TYPE_SELECT_LATEX_BIN, CallbackHandler<Options, &Options::CallbackSelectLatex>()},               //
+        {EVENT_TYPE_OPEN_HEADER, CallbackHandler<Options, &Options::CallbackOpenHeader>()},                     //
+        {EVENT_TYPE_CREATE_DEFAULT_HEADER, CallbackHandler<Options, &Options::CallbackCreateDefaultHeader>()},  //
+        {EVENT_TYPE_SHOW_DIAGNOSTICS, CallbackHandler<Options, &Options::CallbackShowDiagnostics>()},           //
+        {EVENT_TYPE_WRITE_REPORT, CallbackHandler<Options, &Options::CallbackWriteReport>()}                    //
     };
     event_listener_data_ = std::move(event_listener_data);
 }
@@ -137,12 +149,19 @@ void L2A::UI::Options::CallbackSave(const csxs::event::Event* const eventParam)
     global_mutable.latex_command_options_ = options_form->GetStringOption(ai::UnicodeString("latex_command_options"));
     global_mutable.latex_bin_path_ = ai::FilePath(options_form->GetStringOption(ai::UnicodeString("latex_bin_path")));
     global_mutable.gs_command_ = options_form->GetStringOption(ai::UnicodeString("gs_command"));
+    global_mutable.watch_header_ = options_form->GetIntOption(ai::UnicodeString("watch_header")) == 1;
+    global_mutable.trace_pipeline_ = options_form->GetIntOption(ai::UnicodeString("trace_pipeline")) == 1;
+    L2A::UTIL::GetTraceBuffer().SetEnabled(global_mutable.trace_pipeline_);
     global_mutable.item_ui_finish_on_enter_ =
         options_form->GetIntOption(ai::UnicodeString("item_ui_finish_on_enter")) == 1;
+    global_mutable.check_latex_syntax_ = options_form->GetIntOption(ai::UnicodeString("check_latex_syntax")) == 1;
     global_mutable.warning_boundary_boxes_ =
         options_form->GetIntOption(ai::UnicodeString("warning_boundary_boxes")) == 1;
     global_mutable.warning_ai_not_saved_ = options_form->GetIntOption(ai::UnicodeString("warning_ai_not_saved")) == 1;
 
+    // If the header is watched now, the timer of the watcher has to run.
+    L2A::GlobalPluginMutable().ActivateHeaderWatcher();
+
     CloseForm();
 }
 
@@ -258,6 +277,81 @@ void L2A::UI::Options::CallbackCreateDefaultHeader(const csxs::event::Event* con
     SendData(form_parameter_list);
 }
 
+/**
+ *
+ */
+void L2A::UI::Options::CallbackShowDiagnostics(const csxs::event::Event* const eventParam)
+{
+    // We need to activate the app context here, because otherwise functions like the GetDocumentName will not work
+    auto app_context = L2A::GlobalPluginAppContext();
+
+    auto form_parameter_list = std::make_shared<L2A::UTIL::ParameterList>();
+    auto diagnostics = form_parameter_list->SetSubList(ai::UnicodeString("diagnostics"));
+    L2A::UTIL::DocumentFootprint footprint;
+    const bool has_document = GetDocumentFootprint(footprint);
+    diagnostics->SetMainOption(L2A::UTIL::StringStdToAi(
+        GetDiagnosticsText(L2A::UTIL::GetMetrics().GetSnapshot(), has_document ? &footprint : nullptr)));
+    SendData(form_parameter_list);
+}
+
+/**
+ *
+ */
+void L2A::UI::Options::CallbackWriteReport(const csxs::event::Event* const eventParam)
+{
+    // We need to activate the app context here, because otherwise functions like the GetDocumentName will not work
+    auto app_context = L2A::GlobalPluginAppContext();
+
+    // The report of the last call is replaced
+    ai::FilePath report_directory = L2A::UTIL::GetApplicationDataDirectory();
+    report_directory.AddComponent(ai::UnicodeString(L2A::NAMES::report_directory_name_));
+    L2A::UTIL::RemoveDirectoryAI(report_directory, false);
+    L2A::UTIL::CreateDirectoryL2A(report_directory);
+    const auto add_report_file = [&report_directory](const char* name)
+    {
+        ai::FilePath path = report_directory;
+        path.AddComponent(ai::UnicodeString(name));
+        return path;
+    };
+
+    // Diagnostics, footprint of the active document and options
+    const L2A::UTIL::MetricsSnapshot snapshot = L2A::UTIL::GetMetrics().GetSnapshot();
+    L2A::UTIL::DocumentFootprint footprint;
+    const bool has_document = GetDocumentFootprint(footprint);
+    L2A::UTIL::WriteFileUTF8(add_report_file("report.txt"),
+        L2A::UTIL::StringStdToAi(GetDiagnosticsText(snapshot, has_document ? &footprint : nullptr)), true);
+    if (has_document)
+        L2A::UTIL::WriteFileUTF8(add_report_file("document_footprint.json"),
+            L2A::UTIL::StringStdToAi(L2A::UTIL::GetDocumentFootprintJson(footprint)), true);
+    L2A::UTIL::WriteFileUTF8(
+        add_report_file("metrics.json"), L2A::UTIL::StringStdToAi(L2A::UTIL::GetMetricsJson(snapshot)), true);
+    L2A::UTIL::WriteFileUTF8(add_report_file("options.xml"), L2A::Global().ToString(), true);
+
+    // Trace of the item pipeline, if it is recorded
+    const L2A::UTIL::TraceBuffer& trace_buffer = L2A::UTIL::GetTraceBuffer();
+    if (trace_buffer.IsEnabled())
+        L2A::UTIL::WriteChromeTrace(
+            trace_buffer, L2A::UTIL::FilePathAiToStd(add_report_file(L2A::NAMES::trace_file_name_)));
+
+    // Input and log of the last compilation
+    ai::FilePath tex_directory = L2A::UTIL::GetTemporaryDirectory();
+    tex_directory.AddComponent(ai::UnicodeString(L2A::NAMES::create_pdf_tex_name_base_));
+    const std::filesystem::path tex_directory_std = L2A::UTIL::FilePathAiToStd(tex_directory);
+    if (std::filesystem::is_directory(tex_directory_std))
+    {
+        for (const auto& entry : std::filesystem::directory_iterator(tex_directory_std))
+        {
+            const std::filesystem::path extension = entry.path().extension();
+            if (entry.is_regular_file() && (extension == ".tex" || extension == ".log"))
+                std::filesystem::copy_file(entry.path(),
+                    L2A::UTIL::FilePathAiToStd(report_directory) / entry.path().filename(),
+                    std::filesystem::copy_options::overwrite_existing);
+        }
+    }
+
+    L2A::UTIL::OpenFolder(report_directory);
+}
+
 /**
  *
  */
@@ -306,3 +400,40 @@ void L2A::UI::Options::SetHeaderData(const std::shared_ptr<L2A::UTIL::ParameterL
         header_parameter_list->SetOption(document_state_option_name, ai::UnicodeString("no_documents"));
     }
 }
+
+/**
+ *
+ */
+std::string L2A::UI::Options::GetDiagnosticsText(
+    const L2A::UTIL::MetricsSnapshot& snapshot, const L2A::UTIL::DocumentFootprint* footprint) const
+{
+    std::ostringstream text;
+    text << "LaTeX2AI " << L2A_VERSION_STRING_ << " (" << L2A_VERSION_GIT_SHA_HEAD_ << ")\n";
+
+    // The versions are queried each time, so a changed path in the options is reflected directly
+    const auto& global = L2A::Global();
+    const std::string latex_version = L2A::UTIL::StringAiToStd(L2A::LATEX::GetLatexEngineVersion());
+    const std::string gs_version = L2A::UTIL::StringAiToStd(L2A::LATEX::GetGhostscriptVersion());
+    text << "LaTeX engine (" << L2A::UTIL::StringAiToStd(global.latex_engine_)
+         << "): " << (latex_version.empty() ? "not found" : latex_version) << "\n";
+    text << "Ghostscript: " << (gs_version.empty() ? "not found" : gs_version) << "\n";
+
+    // Size of the active document
+    if (footprint != nullptr)
+        text << L2A::UTIL::GetDocumentFootprintText(*footprint);
+    else
+        text << "Document items: no opened document\n";
+
+    text << "\n" << L2A::UTIL::GetMetricsText(snapshot);
+    return text.str();
+}
+
+/**
+ *
+ */
+bool L2A::UI::Options::GetDocumentFootprint(L2A::UTIL::DocumentFootprint& footprint) const
+{
+    if (L2A::AI::GetDocumentCount() == 0) return false;
+    footprint = L2A::UTIL::AnalyzeDocumentFootprint(L2A::AI::Document(), std::string(L2A::NAMES::ai_item_name_));
+    return true;
+}
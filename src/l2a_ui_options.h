@@ -29,6 +29,8 @@
 #ifndef L2A_UI_OPTIONS_H_
 #define L2A_UI_OPTIONS_H_
 
+#include "l2a_document_footprint.h"
+#include "l2a_metrics.h"
 #include "l2a_ui_base.h"
 
 namespace L2A::UI
@@ -51,6 +53,8 @@ namespace L2A::UI
         static const std::string EVENT_TYPE_SELECT_LATEX_BIN;
         static const std::string EVENT_TYPE_OPEN_HEADER;
         static const std::string EVENT_TYPE_CREATE_DEFAULT_HEADER;
+        static const std::string EVENT_TYPE_SHOW_DIAGNOSTICS;
+        static const std::string EVENT_TYPE_WRITE_REPORT;
 
        public:
         /**
@@ -108,6 +112,17 @@ namespace L2A::UI
          */
         void CallbackCreateDefaultHeader(const csxs::event::Event* const eventParam);
 
+        /**
+         * @brief Callback to send the diagnostics, i.e., tool versions, document size and metrics, to the form
+         */
+        void CallbackShowDiagnostics(const csxs::event::Event* const eventParam);
+
+        /**
+         * @brief Callback to write a report with the diagnostics, options and last compilation to the application data
+         * directory
+         */
+        void CallbackWriteReport(const csxs::event::Event* const eventParam);
+
        private:
         /**
          * @brief Convert callback data to parameter list
@@ -119,6 +134,17 @@ namespace L2A::UI
          * @brief Set the header data in the parameter list that will be sent to the form
          */
         void SetHeaderData(const std::shared_ptr<L2A::UTIL::ParameterList> form_parameter_list);
+
+        /**
+         * @brief Analyze the data stored in the items of the active document. Return false if there is no document.
+         */
+        bool GetDocumentFootprint(L2A::UTIL::DocumentFootprint& footprint) const;
+
+        /**
+         * @brief Get the text with the tool versions, the footprint of the active document (if any) and the metrics
+         */
+        std::string GetDiagnosticsText(
+            const L2A::UTIL::MetricsSnapshot& snapshot, const L2A::UTIL::DocumentFootprint* footprint) const;
     };
 }  // namespace L2A::UI
 #endif
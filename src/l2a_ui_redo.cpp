@@ -32,10 +32,39 @@
 #include "l2a_ui_redo.h"
 
 #include "l2a_ai_functions.h"
+#include "l2a_background_compile.h"
 #include "l2a_global.h"
 #include "l2a_parameter_list.h"
 #include "l2a_string_functions.h"
 
+#include <map>
+
+
+/**
+ * \brief Add the numbers and the expected LaTeX time of a redo plan to the parameter list for the form.
+ */
+void SetRedoPlanOptions(L2A::UTIL::ParameterList& parameter_list, const ai::UnicodeString& items,
+    const std::vector<L2A::UTIL::RedoPlanItem>& plan_items)
+{
+    const L2A::UTIL::RedoPlan plan = L2A::UTIL::CreateRedoPlan(plan_items);
+    const ai::UnicodeString key_base = ai::UnicodeString("plan_") + items;
+    parameter_list.SetOption(key_base + ai::UnicodeString("_skipped"), (unsigned int)plan.n_skipped_);
+    parameter_list.SetOption(key_base + ai::UnicodeString("_deduplicated"), (unsigned int)plan.n_deduplicated_);
+    parameter_list.SetOption(key_base + ai::UnicodeString("_compiled"), (unsigned int)plan.compile_items_.size());
+
+    // The times are given in milliseconds, the slowest item is shown with its code.
+    const L2A::UTIL::RedoPlanTime plan_time = L2A::UTIL::GetRedoPlanTime(plan_items, plan);
+    parameter_list.SetOption(key_base + ai::UnicodeString("_time_ms"), (int)(plan_time.compile_time_ * 1e3 + 0.5));
+    parameter_list.SetOption(key_base + ai::UnicodeString("_time_unknown"), (unsigned int)plan_time.n_unknown_);
+    if (plan_time.slowest_item_ != L2A::UTIL::RedoPlan::skip)
+    {
+        const auto& slowest_item = plan_items[plan_time.slowest_item_];
+        parameter_list.SetOption(
+            key_base + ai::UnicodeString("_slowest_ms"), (int)(slowest_item.compile_time_ * 1e3 + 0.5));
+        parameter_list.SetOption(
+            key_base + ai::UnicodeString("_slowest_code"), L2A::UTIL::StringStdToAi(slowest_item.latex_code_));
+    }
+}
 
 /**
  * \brief Set the names for item forms
@@ -51,7 +80,8 @@ const std::string L2A::UI::Redo::EVENT_TYPE_UPDATE = L2A::UI::Redo::EVENT_TYPE_B
 /**
  *
  */
-L2A::UI::Redo::Redo() : FormBase(FORM_NAME, FORM_ID.c_str(), EVENT_TYPE_BASE), all_items_(), selected_items_()
+L2A::UI::Redo::Redo()
+    : FormBase(FORM_NAME, FORM_ID.c_str(), EVENT_TYPE_BASE), all_items_(), selected_items_(), stale_items_()
 {
     // If we don't do this this way, we get a compiler error
     std::vector<EventListenerData> event_listener_data = {
@@ -68,6 +98,7 @@ void L2A::UI::Redo::ResetFormData()
 {
     all_items_.clear();
     selected_items_.clear();
+    stale_items_.clear();
 }
 
 /**
@@ -100,6 +131,7 @@ void L2A::UI::Redo::CallbackOk(const csxs::event::Event* const eventParam)
     const auto& sub_form = form_return_data.GetSubList(ai::UnicodeString("l2a_redo"));
     const auto action_type = sub_form->GetStringOption(ai::UnicodeString("action_type"));
     const auto items = sub_form->GetStringOption(ai::UnicodeString("items"));
+    const bool force_recompile = sub_form->GetIntOption(ai::UnicodeString("force_recompile")) == 1;
 
     L2A::RedoItemsOption redo_options;
     if (action_type == "latex")
@@ -110,11 +142,14 @@ void L2A::UI::Redo::CallbackOk(const csxs::event::Event* const eventParam)
         l2a_error("Unexpected return value in redo items");
 
     if (items == "all")
-        L2A::RedoItems(all_items_, redo_options);
+        L2A::RedoItems(all_items_, redo_options, force_recompile);
     else if (items == "selected")
-        L2A::RedoItems(selected_items_, redo_options);
+        L2A::RedoItems(selected_items_, redo_options, force_recompile);
+    else if (items == "stale")
+        L2A::RedoItems(stale_items_, redo_options, force_recompile);
     else
         l2a_error("Unexpected return value in redo items");
+    L2A::WritePipelineTrace();
 
     CloseForm();
 }
@@ -133,12 +168,52 @@ ASErr L2A::UI::Redo::SendData()
     L2A::AI::GetDocumentItems(all_items_, L2A::AI::SelectionState::all);
     L2A::AI::GetDocumentItems(selected_items_, L2A::AI::SelectionState::selected);
 
+    // Get the items that have to be compiled again. The selected items are a subset of all items, so the item data
+    // only has to be loaded once.
+    auto all_plan_items = L2A::GetRedoPlanItems(all_items_);
+    std::map<AIArtHandle, size_t> all_item_index;
+    std::vector<L2A::UTIL::RedoPlanItem> selected_plan_items;
+    std::vector<L2A::UTIL::RedoPlanItem> stale_plan_items;
+    stale_items_.clear();
+    for (size_t i_item = 0; i_item < all_items_.size(); i_item++)
+    {
+        all_item_index[all_items_[i_item]] = i_item;
+        if (!all_plan_items[i_item].is_up_to_date_)
+        {
+            stale_items_.push_back(all_items_[i_item]);
+            stale_plan_items.push_back(all_plan_items[i_item]);
+        }
+    }
+    for (const auto& item : selected_items_)
+    {
+        const auto it = all_item_index.find(item);
+        if (it != all_item_index.end()) selected_plan_items.push_back(all_plan_items[it->second]);
+    }
+
     // Add number of items to parameter list for form
     auto redo_all_parameter_list = std::make_shared<L2A::UTIL::ParameterList>();
     const unsigned int n_all_items = (unsigned int)all_items_.size();
     const unsigned int n_selected_items = (unsigned int)selected_items_.size();
+    const unsigned int n_stale_items = (unsigned int)stale_items_.size();
+    unsigned int n_staged_items = 0;
+    const auto* staged_compile = L2A::GetStagedCompile();
+    if (staged_compile != nullptr)
+        for (const auto& plan_item : stale_plan_items)
+            if (staged_compile->FindPage(plan_item) != nullptr) n_staged_items++;
     redo_all_parameter_list->SetOption(ai::UnicodeString("n_all_items"), n_all_items);
     redo_all_parameter_list->SetOption(ai::UnicodeString("n_selected_items"), n_selected_items);
+    redo_all_parameter_list->SetOption(ai::UnicodeString("n_stale_items"), n_stale_items);
+    redo_all_parameter_list->SetOption(ai::UnicodeString("n_staged_items"), n_staged_items);
+
+    // Add the plans for recompiling the items, with and without the items that are up to date.
+    SetRedoPlanOptions(*redo_all_parameter_list, ai::UnicodeString("all"), all_plan_items);
+    SetRedoPlanOptions(*redo_all_parameter_list, ai::UnicodeString("selected"), selected_plan_items);
+    SetRedoPlanOptions(*redo_all_parameter_list, ai::UnicodeString("stale"), stale_plan_items);
+    for (auto& plan_item : all_plan_items) plan_item.is_up_to_date_ = false;
+    for (auto& plan_item : selected_plan_items) plan_item.is_up_to_date_ = false;
+    SetRedoPlanOptions(*redo_all_parameter_list, ai::UnicodeString("all_force"), all_plan_items);
+    SetRedoPlanOptions(*redo_all_parameter_list, ai::UnicodeString("selected_force"), selected_plan_items);
+    SetRedoPlanOptions(*redo_all_parameter_list, ai::UnicodeString("stale_force"), stale_plan_items);
 
     SendDataWrapper(redo_all_parameter_list, EVENT_TYPE_UPDATE);
 
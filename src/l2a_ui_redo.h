@@ -86,6 +86,9 @@ namespace L2A::UI
 
         //! Vector with all selected LaTeX2AI items
         std::vector<AIArtHandle> selected_items_;
+
+        //! Vector with all LaTeX2AI items that were compiled with a different header or options
+        std::vector<AIArtHandle> stale_items_;
     };
 }  // namespace L2A::UI
 #endif
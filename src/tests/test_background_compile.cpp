@@ -0,0 +1,204 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Test the background compile worker.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_background_compile.h"
+#include "testing_utlity.h"
+
+#include "l2a_background_compile.h"
+#include "l2a_file_system.h"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+
+/**
+ * \brief Write a text to a file.
+ */
+void WriteBackgroundCompileTestFile(const std::filesystem::path& path, const std::string& text)
+{
+    std::ofstream file(path, std::ios::trunc);
+    file << text;
+}
+
+/**
+ * \brief Get a job for the background compile test. The commands are interpreted by the command function of the test.
+ */
+L2A::UTIL::BackgroundCompileJob GetBackgroundCompileTestJob(
+    const std::filesystem::path& directory, const std::string& latex_command, const size_t n_pages)
+{
+    L2A::UTIL::BackgroundCompileJob job;
+    job.directory_ = directory;
+    job.document_path_ = directory / "document.ai";
+    job.compile_digest_ = latex_command;
+    job.header_name_ = "header.tex";
+    job.header_text_ = "\\documentclass{article}";
+    job.local_packages_.push_back({directory / "local.sty", "local.sty", "\\def\\a{a}"});
+    job.tex_name_ = "item.tex";
+    job.tex_text_ = "\\input{header}";
+    job.latex_command_ = latex_command;
+    job.split_command_ = "split " + std::to_string(n_pages);
+    for (size_t i_page = 0; i_page < n_pages; i_page++)
+        job.pages_.push_back({"code " + std::to_string(i_page), i_page % 2 == 0, false});
+    return job;
+}
+
+/**
+ *
+ */
+void L2A::TEST::TestBackgroundCompile(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("TestBackgroundCompile"));
+
+    const std::filesystem::path directory =
+        L2A::UTIL::FilePathAiToStd(L2A::UTIL::GetTemporaryDirectory()) / "background_compile_test";
+    std::filesystem::remove_all(directory);
+
+    // The commands create the files that LaTeX and ghostscript would create, the log only contains the time of the
+    // second page. The command "block" waits until it is released by the test.
+    std::atomic<bool> is_blocked(false);
+    std::atomic<bool> release(false);
+    auto run_command = [&](const std::string& command, const std::filesystem::path& working_directory)
+    {
+        if (command == "block")
+        {
+            is_blocked = true;
+            while (!release) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (command == "latex" || command == "block")
+        {
+            if (std::filesystem::is_regular_file(working_directory / "header.tex") &&
+                std::filesystem::is_regular_file(working_directory / "local.sty"))
+                WriteBackgroundCompileTestFile(working_directory / "item.pdf", "pdf");
+            WriteBackgroundCompileTestFile(working_directory / "item.log", "LaTeX2AI page time: 2 131072\n");
+            return 0;
+        }
+        else if (command.rfind("split ", 0) == 0)
+        {
+            const int n_pages = std::stoi(command.substr(6));
+            for (int i_page = 1; i_page <= n_pages; i_page++)
+                WriteBackgroundCompileTestFile(
+                    working_directory / ("item_" + std::to_string(i_page) + ".pdf"), "page " + std::to_string(i_page));
+            return 0;
+        }
+        return 1;
+    };
+
+    {
+        L2A::UTIL::BackgroundCompileWorker worker(run_command);
+        ut.CompareInt(true, worker.IsIdle());
+        ut.CompareInt(false, worker.HasResult());
+
+        // Compile a document with three pages.
+        worker.Post(GetBackgroundCompileTestJob(directory, "latex", 3));
+        worker.Flush();
+        ut.CompareInt(true, worker.IsIdle());
+        ut.CompareInt(true, worker.HasResult());
+        auto result = worker.TakeResult();
+        ut.CompareInt(false, worker.HasResult());
+        ut.CompareInt(true, result->is_ok_);
+        ut.CompareInt(3, (int)result->page_files_.size());
+        ut.CompareStr(ai::UnicodeString(result->compile_digest_), ai::UnicodeString("latex"));
+        const std::filesystem::path* page = result->FindPage({"code 1", false, false});
+        ut.CompareInt(true, page != nullptr);
+        if (page != nullptr)
+            ut.CompareStr(ai::UnicodeString(page->filename().u8string()), ai::UnicodeString("item_2.pdf"));
+        ut.CompareInt(true, result->FindPage({"code 1", true, false}) == nullptr);
+        ut.CompareFloat(2.0, result->GetPageTime({"code 1", false, false}), 1e-10);
+        ut.CompareInt(true, result->GetPageTime({"code 0", true, false}) < 0.0);
+
+        // If no pdf file is created, the job fails.
+        worker.Post(GetBackgroundCompileTestJob(directory, "error", 2));
+        worker.Flush();
+        result = worker.TakeResult();
+        ut.CompareInt(false, result->is_ok_);
+        ut.CompareInt(0, (int)result->page_files_.size());
+
+        // The result of a running job is discarded if a new job is posted.
+        worker.Post(GetBackgroundCompileTestJob(directory, "block", 2));
+        while (!is_blocked) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        worker.Post(GetBackgroundCompileTestJob(directory, "latex", 4));
+        release = true;
+        worker.Flush();
+        result = worker.TakeResult();
+        ut.CompareInt(true, result->is_ok_);
+        ut.CompareInt(4, (int)result->page_files_.size());
+
+        const auto statistics = worker.GetStatistics();
+        ut.CompareInt(3, (int)statistics.n_jobs_);
+        ut.CompareInt(1, (int)statistics.n_failed_jobs_);
+        ut.CompareInt(1, (int)statistics.n_superseded_jobs_);
+        ut.CompareInt(7, (int)statistics.n_pages_);
+
+        // After the worker is stopped, no more jobs are accepted.
+        worker.Stop();
+        worker.Post(GetBackgroundCompileTestJob(directory, "latex", 1));
+        ut.CompareInt(true, worker.IsIdle());
+        ut.CompareInt(false, worker.HasResult());
+    }
+
+#ifndef WIN_ENV
+    {
+        // The commands of the background process are run by the shell in the working directory.
+        std::filesystem::create_directories(directory);
+        WriteBackgroundCompileTestFile(directory / "marker", "marker");
+        L2A::UTIL::BackgroundProcess process;
+        ut.CompareInt(3, process.Run("exit 3", directory));
+        ut.CompareInt(0, process.Run("test -f marker", directory));
+
+        // A running command is killed when the process is stopped, later commands are not started.
+        std::atomic<int> exit_code(0);
+        const auto start = std::chrono::steady_clock::now();
+        std::thread thread([&] { exit_code = process.Run("sleep 30", directory); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        process.Stop();
+        thread.join();
+        ut.CompareInt(-1, exit_code);
+        ut.CompareInt(true, std::chrono::steady_clock::now() - start < std::chrono::seconds(10));
+        ut.CompareInt(-1, process.Run("exit 0", directory));
+    }
+
+    {
+        // Stopping the worker does not wait for the running command.
+        L2A::UTIL::BackgroundCompileWorker worker;
+        const auto start = std::chrono::steady_clock::now();
+        worker.Post(GetBackgroundCompileTestJob(directory, "sleep 30", 1));
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        worker.Stop();
+        ut.CompareInt(true, std::chrono::steady_clock::now() - start < std::chrono::seconds(10));
+        ut.CompareInt(false, worker.HasResult());
+    }
+#endif
+
+    std::filesystem::remove_all(directory);
+}
@@ -35,6 +35,7 @@
 #include "testing_utlity.h"
 
 #include "l2a_file_system.h"
+#include "l2a_links_folder.h"
 #include "l2a_string_functions.h"
 
 
@@ -91,13 +92,19 @@ void TestBase64EnAndDecoding(L2A::TEST::UTIL::UnitTest& ut)
     std::string encoded_file = L2A::UTIL::encode_file_base64(temp_file);
 
     // Save the encoded string to file.
-    L2A::UTIL::decode_file_base64(temp_file_out, L2A::UTIL::StringStdToAi(encoded_file));
+    const std::uint64_t content_hash =
+        L2A::UTIL::decode_file_base64(temp_file_out, L2A::UTIL::StringStdToAi(encoded_file));
 
     // Load the created file.
     ai::UnicodeString text_from_file = L2A::UTIL::ReadFileUTF8(temp_file_out);
 
     // Compare values.
     ut.CompareStr(text_from_file, ai::UnicodeString(L2A::TEST::UTIL::test_string_4_));
+
+    // The returned hash is the one of the written file.
+    std::uint64_t file_content_hash = 0;
+    ut.CompareInt(true, L2A::UTIL::GetFileContentHash(L2A::UTIL::FilePathAiToStd(temp_file_out), file_content_hash));
+    ut.CompareInt(true, content_hash == file_content_hash);
 }
 
 /**
@@ -111,3 +118,31 @@ void L2A::TEST::TestBase64(L2A::TEST::UTIL::UnitTest& ut)
     TestBase64Unit(ut);
     TestBase64EnAndDecoding(ut);
 }
+
+/**
+ *
+ */
+void L2A::TEST::BenchmarkBase64(L2A::TEST::UTIL::UnitTest& ut, L2A::TEST::UTIL::Benchmark& benchmark)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("BenchmarkBase64"));
+
+    // Data with the size of a large pdf item.
+    std::string data(1 << 20, ' ');
+    for (size_t i = 0; i < data.size(); i++) data[i] = (char)((i * 7919) >> 3);
+
+    const size_t n_operations = 20;
+    std::string encoded;
+    L2A::TEST::UTIL::Timer timer;
+    for (size_t i = 0; i < n_operations; i++) encoded = base64::encode(data.c_str(), data.size());
+    timer.Stop();
+    benchmark.AddResult(ai::UnicodeString("base64 encode (1 MB)"), n_operations, timer);
+
+    std::vector<char> decoded;
+    timer.Reset();
+    for (size_t i = 0; i < n_operations; i++) decoded = base64::decode(encoded);
+    timer.Stop();
+    benchmark.AddResult(ai::UnicodeString("base64 decode (1 MB)"), n_operations, timer);
+
+    ut.CompareInt(true, std::string(decoded.data(), decoded.size()) == data);
+}
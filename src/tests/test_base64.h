@@ -39,6 +39,7 @@ namespace L2A
         namespace UTIL
         {
             class UnitTest;
+            class Benchmark;
         }
     }  // namespace TEST
 }  // namespace L2A
@@ -52,6 +53,11 @@ namespace L2A
          * \brief Test the functionality of the base 64 encoding.
          */
         void TestBase64(L2A::TEST::UTIL::UnitTest& ut);
+
+        /**
+         * \brief Benchmark the base 64 encoding and decoding.
+         */
+        void BenchmarkBase64(L2A::TEST::UTIL::UnitTest& ut, L2A::TEST::UTIL::Benchmark& benchmark);
     }  // namespace TEST
 }  // namespace L2A
 
@@ -0,0 +1,225 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Test the portable functions to create and compile the LaTeX document of items.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_compile_core.h"
+#include "testing_utlity.h"
+
+#include "l2a_compile_core.h"
+
+
+/**
+ *
+ */
+void L2A::TEST::TestCompileCore(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("TestCompileCore"));
+
+    {
+        // CRC64 hash, the same as stored in the items.
+        ut.CompareStr(ai::UnicodeString("6c40df5f0b497347"), ai::UnicodeString(L2A::UTIL::GetStringHash("123456789")));
+        ut.CompareStr(ai::UnicodeString("0"), ai::UnicodeString(L2A::UTIL::GetStringHash("")));
+    }
+
+    {
+        // Document with a page for each of the given items.
+        const std::vector<L2A::UTIL::RedoPlanItem> items = {{"$a$", false}, {"$b$", true}, {"$c$", false}};
+        const std::string pages_code = L2A::UTIL::GetLatexPagesCode(items, {2, 1});
+        ut.CompareStr(ai::UnicodeString("\n\n\\LaTeXtoAI{$c$}\n\n\\LaTeXtoAIbase{$b$}\n\n"),
+            ai::UnicodeString(pages_code));
+
+        const std::string text = L2A::UTIL::GetLatexDocumentText(pages_code, "header.tex");
+        ut.CompareInt(true, text.find("\\input{header.tex}") != std::string::npos);
+        ut.CompareInt(true, text.find("\\begin{document}\n" + pages_code + "\n\\end{document}") != std::string::npos);
+        ut.CompareInt(true, text.find("{tex_header_name}") == std::string::npos);
+        ut.CompareInt(true, text.find("{latex_code}") == std::string::npos);
+
+        // Placeholders in the code of an item are not replaced.
+        const std::string placeholder_text = L2A::UTIL::GetLatexDocumentText("{tex_header_name}", "header.tex");
+        ut.CompareInt(true, placeholder_text.find("\\begin{document}\n{tex_header_name}\n") != std::string::npos);
+    }
+
+    {
+        // Commands to compile and split the document.
+        const std::filesystem::path tex_file = std::filesystem::path("dir") / "item.tex";
+        ut.CompareStr(ai::UnicodeString("pdflatex -opt \"" + tex_file.u8string() + "\""),
+            ai::UnicodeString(L2A::UTIL::GetLatexCompileCommand("", "pdflatex", "-opt", tex_file)));
+#ifdef WIN_ENV
+        const std::filesystem::path exe_path = std::filesystem::path("bin") / "lualatex.exe";
+#else
+        const std::filesystem::path exe_path = std::filesystem::path("bin") / "lualatex";
+#endif
+        ut.CompareStr(ai::UnicodeString("\"" + exe_path.u8string() + "\" -opt \"" + tex_file.u8string() + "\""),
+            ai::UnicodeString(L2A::UTIL::GetLatexCompileCommand("bin", "lualatex", "-opt", tex_file)));
+        ut.CompareStr(ai::UnicodeString("\"" + exe_path.u8string() + "\""),
+            ai::UnicodeString(L2A::UTIL::GetLatexEngineCommand("bin", "lualatex")));
+        ut.CompareStr(ai::UnicodeString("xelatex"), ai::UnicodeString(L2A::UTIL::GetLatexEngineCommand("", "xelatex")));
+        ut.CompareStr(ai::UnicodeString("\"gs\" -sDEVICE=pdfwrite -o item_%d.pdf item.pdf"),
+            ai::UnicodeString(L2A::UTIL::GetSplitPdfPagesCommand(std::filesystem::path("dir") / "item.pdf", "gs")));
+    }
+
+    {
+        // Time of the pages written to the log. Only lines starting with the prefix are read, pages without a time
+        // get a negative value.
+        const std::string log_text =
+            "This is pdfTeX\nLaTeX2AI page time: 1 32768\r\n(./header.tex)\nLaTeX2AI page time: 3 65536\n"
+            "Overfull LaTeX2AI page time: 2 100\nLaTeX2AI page time: 4 x\nLaTeX2AI page time: 5 0";
+        const std::vector<double> page_times = L2A::UTIL::ReadLatexPageTimes(log_text);
+        ut.CompareInt(5, (int)page_times.size());
+        ut.CompareFloat(0.5, page_times[0], 1e-10);
+        ut.CompareInt(true, page_times[1] < 0.0);
+        ut.CompareFloat(1.0, page_times[2], 1e-10);
+        ut.CompareInt(true, page_times[3] < 0.0);
+        ut.CompareFloat(0.0, page_times[4], 1e-10);
+        ut.CompareInt(0, (int)L2A::UTIL::ReadLatexPageTimes(std::string("No pages")).size());
+        ut.CompareInt(0, (int)L2A::UTIL::ReadLatexPageTimes(std::filesystem::path("missing.log")).size());
+    }
+
+    {
+        // Items stored as XML.
+        const std::string baseline_xml =
+            "<LaTeX2AI_item text_align_horizontal=\"left\" text_align_vertical=\"baseline\">"
+            "<latex cursor_position=\"1\">$a &lt; b$</latex></LaTeX2AI_item>";
+        L2A::UTIL::RedoPlanItem item;
+        ut.CompareInt(true, L2A::UTIL::ReadItemXML(baseline_xml, item));
+        ut.CompareStr(ai::UnicodeString("$a < b$"), ai::UnicodeString(item.latex_code_));
+        ut.CompareInt(true, item.is_baseline_);
+        ut.CompareInt(true, item.compile_time_ < 0.0);
+
+        const std::string timed_xml =
+            "<LaTeX2AI_item text_align_vertical=\"top\"><latex compile_time_us=\"250000\">$a$</latex></LaTeX2AI_item>";
+        ut.CompareInt(true, L2A::UTIL::ReadItemXML(timed_xml, item));
+        ut.CompareFloat(0.25, item.compile_time_, 1e-10);
+
+        const std::string empty_xml =
+            "<LaTeX2AI_item text_align_vertical=\"top\"><latex cursor_position=\"0\"/></LaTeX2AI_item>";
+        ut.CompareInt(true, L2A::UTIL::ReadItemXML(empty_xml, item));
+        ut.CompareStr(ai::UnicodeString(""), ai::UnicodeString(item.latex_code_));
+        ut.CompareInt(false, item.is_baseline_);
+
+        // Invalid items.
+        ut.CompareInt(false, L2A::UTIL::ReadItemXML("<LaTeX2AI_options><latex>$a$</latex></LaTeX2AI_options>", item));
+        ut.CompareInt(false, L2A::UTIL::ReadItemXML("<LaTeX2AI_item text_align_vertical=\"top\"/>", item));
+        ut.CompareInt(false, L2A::UTIL::ReadItemXML("<LaTeX2AI_item><latex>", item));
+
+        // Data for the redo plan, the item is only up to date if it has pdf contents with the current digest.
+        const std::string compiled_xml =
+            "<LaTeX2AI_item text_align_vertical=\"baseline\"><latex compile_digest=\"D1\" compile_time_us=\"500000\">"
+            "$a &lt; b$</latex><pdf_file_contents hash=\"A1\" hash_method=\"crc64\">data &lt;</pdf_file_contents>"
+            "</LaTeX2AI_item>";
+        ut.CompareInt(true, L2A::UTIL::ReadItemRedoPlanItem(compiled_xml, "D1", item));
+        ut.CompareStr(ai::UnicodeString("$a < b$"), ai::UnicodeString(item.latex_code_));
+        ut.CompareInt(true, item.is_baseline_);
+        ut.CompareInt(true, item.is_up_to_date_);
+        ut.CompareFloat(0.5, item.compile_time_, 1e-10);
+        ut.CompareInt(true, L2A::UTIL::ReadItemRedoPlanItem(compiled_xml, "D2", item));
+        ut.CompareInt(false, item.is_up_to_date_);
+        ut.CompareInt(true, L2A::UTIL::ReadItemRedoPlanItem(compiled_xml, "", item));
+        ut.CompareInt(false, item.is_up_to_date_);
+        ut.CompareInt(true,
+            L2A::UTIL::ReadItemRedoPlanItem(
+                "<LaTeX2AI_item><latex compile_digest=\"D1\">$a$</latex></LaTeX2AI_item>", "D1", item));
+        ut.CompareInt(false, item.is_up_to_date_);
+        ut.CompareInt(true,
+            L2A::UTIL::ReadItemRedoPlanItem("<LaTeX2AI_item><latex compile_digest=\"D1\">$a$</latex>"
+                                            "<pdf_file_contents hash=\"A1\"/></LaTeX2AI_item>",
+                "D1", item));
+        ut.CompareInt(true, item.is_up_to_date_);
+
+        // Items with an empty pdf element are not up to date.
+        ut.CompareInt(true,
+            L2A::UTIL::ReadItemRedoPlanItem("<LaTeX2AI_item><latex compile_digest=\"D1\">$a$</latex>"
+                                            "<pdf_file_contents/></LaTeX2AI_item>",
+                "D1", item));
+        ut.CompareInt(false, item.is_up_to_date_);
+        ut.CompareInt(true,
+            L2A::UTIL::ReadItemRedoPlanItem("<LaTeX2AI_item><latex compile_digest=\"D1\">$a$</latex>"
+                                            "<pdf_file_contents hash=\"\"></pdf_file_contents></LaTeX2AI_item>",
+                "D1", item));
+        ut.CompareInt(false, item.is_up_to_date_);
+        ut.CompareInt(true,
+            L2A::UTIL::ReadItemRedoPlanItem("<LaTeX2AI_item><latex compile_digest=\"D1\">$a$</latex>"
+                                            "<pdf_file_contents>data</pdf_file_contents></LaTeX2AI_item>",
+                "D1", item));
+        ut.CompareInt(true, item.is_up_to_date_);
+        ut.CompareInt(false, L2A::UTIL::ReadItemRedoPlanItem("<LaTeX2AI_item><latex>", "D1", item));
+
+        // Hash of the pdf contents.
+        std::string hash;
+        ut.CompareInt(true,
+            L2A::UTIL::ReadItemPDFFileHash("<LaTeX2AI_item><latex>$a$</latex><pdf_file_contents hash=\"A1\" "
+                                           "hash_method=\"crc64\">data</pdf_file_contents></LaTeX2AI_item>",
+                hash));
+        ut.CompareStr(ai::UnicodeString("A1"), ai::UnicodeString(hash));
+        ut.CompareInt(false, L2A::UTIL::ReadItemPDFFileHash(baseline_xml, hash));
+
+        // Contents of the pdf file, the hash of items from older versions is computed from the contents.
+        std::string encoded_contents;
+        bool is_legacy_hash = true;
+        ut.CompareInt(true,
+            L2A::UTIL::ReadItemPDFFile("<LaTeX2AI_item><latex>$a$</latex><pdf_file_contents hash=\"A1\" "
+                                       "hash_method=\"crc64\">data</pdf_file_contents></LaTeX2AI_item>",
+                encoded_contents, hash, is_legacy_hash));
+        ut.CompareStr(ai::UnicodeString("data"), ai::UnicodeString(encoded_contents));
+        ut.CompareStr(ai::UnicodeString("A1"), ai::UnicodeString(hash));
+        ut.CompareInt(false, is_legacy_hash);
+        ut.CompareInt(true,
+            L2A::UTIL::ReadItemPDFFile("<LaTeX2AI_item><latex>$a$</latex><pdf_file_contents hash=\"A1\">"
+                                       "123456789</pdf_file_contents></LaTeX2AI_item>",
+                encoded_contents, hash, is_legacy_hash));
+        ut.CompareStr(ai::UnicodeString("6c40df5f0b497347"), ai::UnicodeString(hash));
+        ut.CompareInt(true, is_legacy_hash);
+        ut.CompareInt(true, L2A::UTIL::ReadItemPDFFile(baseline_xml, encoded_contents, hash, is_legacy_hash));
+        ut.CompareInt(true, encoded_contents.empty());
+        ut.CompareInt(
+            false, L2A::UTIL::ReadItemPDFFile("<LaTeX2AI_item><latex>", encoded_contents, hash, is_legacy_hash));
+    }
+
+    {
+        // Items in the text of a document, other elements with the same prefix are skipped.
+        const std::string item_a = "<LaTeX2AI_item><latex>$a$</latex></LaTeX2AI_item>";
+        const std::string item_b = "<LaTeX2AI_item text_align_vertical=\"top\"><latex>$b$</latex></LaTeX2AI_item>";
+        const auto items = L2A::UTIL::FindItemXML("%%binary<LaTeX2AI_items>" + item_a + ")\\r(" + item_b +
+                                                  "<LaTeX2AI_item><latex>$c$</latex>");
+        ut.CompareInt(2, (int)items.size());
+        ut.CompareStr(ai::UnicodeString(item_a), ai::UnicodeString(items[0]));
+        ut.CompareStr(ai::UnicodeString(item_b), ai::UnicodeString(items[1]));
+        ut.CompareInt(0, (int)L2A::UTIL::FindItemXML("no items").size());
+    }
+
+    {
+        // Compressed private data of an Illustrator file.
+        ut.CompareInt(1, L2A::UTIL::IsCompressedIllustratorData("%AI9_PrivateDataBegin\r%AI12_CompressedDataxyz"));
+        ut.CompareInt(1, L2A::UTIL::IsCompressedIllustratorData("%AI9_PrivateDataBegin\n%AI24_ZStandard_Data("));
+        ut.CompareInt(0, L2A::UTIL::IsCompressedIllustratorData("%AI9_PrivateDataBegin\r%AI5_BeginLayer"));
+        ut.CompareInt(0, L2A::UTIL::IsCompressedIllustratorData("<latex>_CompressedData</latex>"));
+    }
+}
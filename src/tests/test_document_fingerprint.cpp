@@ -0,0 +1,83 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Test the document fingerprints.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_document_fingerprint.h"
+#include "testing_utlity.h"
+
+#include "l2a_document_fingerprint.h"
+#include "l2a_file_system.h"
+
+#include <fstream>
+
+
+/**
+ *
+ */
+void L2A::TEST::TestDocumentFingerprint(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("TestDocumentFingerprint"));
+
+    L2A::UTIL::DocumentCheckMemo memo;
+    const L2A::UTIL::DocumentFingerprint fingerprint_a = {"doc_a", 10, 100};
+    const L2A::UTIL::DocumentFingerprint fingerprint_b = {"doc_b", 10, 200};
+
+    // Documents that were not checked yet are always checked.
+    ut.CompareInt(false, memo.SkipCheck(fingerprint_a));
+    memo.SetChecked(fingerprint_a);
+    ut.CompareInt(true, memo.SkipCheck(fingerprint_a));
+    ut.CompareInt(false, memo.SkipCheck(fingerprint_b));
+    memo.SetChecked(fingerprint_b);
+
+    // Switching between the checked documents does not trigger a check.
+    ut.CompareInt(true, memo.SkipCheck(fingerprint_a));
+    ut.CompareInt(true, memo.SkipCheck(fingerprint_b));
+
+    // Changed art or links folder.
+    ut.CompareInt(false, memo.SkipCheck({"doc_a", 11, 100}));
+    ut.CompareInt(false, memo.SkipCheck({"doc_a", 10, 101}));
+
+    memo.Clear();
+    ut.CompareInt(false, memo.SkipCheck(fingerprint_a));
+
+    const auto& statistics = memo.GetStatistics();
+    ut.CompareInt(2, (int)statistics.n_performed_);
+    ut.CompareInt(3, (int)statistics.n_skipped_);
+
+    // Write times of existing and missing paths.
+    const std::filesystem::path directory =
+        L2A::UTIL::FilePathAiToStd(L2A::UTIL::GetTemporaryDirectory()) / "document_fingerprint_test";
+    std::filesystem::remove_all(directory);
+    ut.CompareInt(0, (int)L2A::UTIL::GetLastWriteTime(directory));
+    std::filesystem::create_directories(directory);
+    ut.CompareInt(true, L2A::UTIL::GetLastWriteTime(directory) != 0);
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,142 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+/**
+ * \brief Test the analysis of the document footprint.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_document_footprint.h"
+#include "testing_utlity.h"
+
+#include "l2a_compile_core.h"
+#include "l2a_document_footprint.h"
+#include "l2a_document_model.h"
+
+
+/**
+ *
+ */
+void TestDocumentFootprintNotes(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Two items with the same pdf file, one with a legacy hash, one without pdf file and a note that can not be read.
+    const std::vector<std::string> notes = {
+        "<LaTeX2AI_item><latex>a</latex><pdf_file_contents hash=\"h1\" hash_method=\"crc64\">AAAAAAAA"
+        "</pdf_file_contents></LaTeX2AI_item>",
+        "<LaTeX2AI_item><latex>a</latex><pdf_file_contents hash=\"h1\" hash_method=\"crc64\">AAAAAAAA"
+        "</pdf_file_contents></LaTeX2AI_item>",
+        "<LaTeX2AI_item><latex>b</latex><pdf_file_contents hash=\"old\">QUJD</pdf_file_contents></LaTeX2AI_item>",
+        "<LaTeX2AI_item><latex>c</latex></LaTeX2AI_item>", "not a note"};
+    const L2A::UTIL::DocumentFootprint footprint = L2A::UTIL::AnalyzeDocumentFootprint(notes);
+
+    ut.CompareInt(5, (int)footprint.n_items_);
+    ut.CompareInt(1, (int)footprint.n_items_without_payload_);
+    ut.CompareInt(1, (int)footprint.n_invalid_notes_);
+    size_t note_size = 0;
+    for (const auto& note : notes) note_size += note.size();
+    ut.CompareInt((int)note_size, (int)footprint.note_size_);
+    ut.CompareInt((int)notes[0].size(), (int)footprint.max_note_size_);
+    ut.CompareInt(20, (int)footprint.payload_size_);
+    ut.CompareInt(8, (int)footprint.max_payload_size_);
+    ut.CompareInt(3, (int)footprint.payload_size_buckets_[0]);
+
+    ut.CompareInt(1, (int)footprint.duplicates_.size());
+    ut.CompareStr(ai::UnicodeString("h1"), ai::UnicodeString(footprint.duplicates_[0].hash_));
+    ut.CompareInt(2, (int)footprint.duplicates_[0].n_items_);
+    ut.CompareInt(8, (int)footprint.duplicates_[0].payload_size_);
+    ut.CompareInt(1, (int)footprint.legacy_hash_items_.size());
+    ut.CompareInt(2, (int)footprint.legacy_hash_items_[0]);
+    ut.CompareInt(8, (int)footprint.deduplication_savings_);
+
+    // Six zero bytes have no entropy, the three different bytes of "ABC" can not be compressed.
+    ut.CompareInt(0, (int)L2A::UTIL::EstimateCompressedEncodedSize("AAAAAAAA"));
+    ut.CompareInt(4, (int)L2A::UTIL::EstimateCompressedEncodedSize("QUJD"));
+    ut.CompareInt(0, (int)L2A::UTIL::EstimateCompressedEncodedSize(""));
+    ut.CompareInt(8, (int)footprint.compression_savings_);
+
+    const std::string json = L2A::UTIL::GetDocumentFootprintJson(footprint);
+    ut.CompareInt(true, json.find("\"legacy_hash_items\": [\n        2\n    ]") != std::string::npos);
+    ut.CompareInt(true, json.find("\"hash\": \"h1\"") != std::string::npos);
+    ut.CompareStr(ai::UnicodeString("Document items: 5 (1 without pdf data)\n"
+                                    "Notes: 0 kB (largest 0 kB)\n"
+                                    "Embedded pdf data: 0 kB\n"
+                                    "Duplicate pdf files: 1 in 2 items, storing them once would save 0 kB\n"
+                                    "Compressing the pdf data would save about 0 kB\n"
+                                    "Items with legacy hash: 1\n"),
+        ai::UnicodeString(L2A::UTIL::GetDocumentFootprintText(footprint)));
+}
+
+/**
+ *
+ */
+void TestDocumentFootprintSyntheticDocument(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // 100 items with 10 different pdf files of 3000 bytes, every 25th item has a legacy hash.
+    L2A::UTIL::SyntheticDocumentOptions options;
+    options.n_items_ = 100;
+    options.n_other_items_ = 0;
+    options.n_codes_ = 10;
+    options.payload_size_ = 3000;
+    options.legacy_hash_interval_ = 25;
+    L2A::UTIL::FakeDocument document;
+    L2A::UTIL::CreateSyntheticDocument(document, options);
+
+    const L2A::UTIL::DocumentFootprint footprint =
+        L2A::UTIL::AnalyzeDocumentFootprint(document, options.item_name_);
+    ut.CompareInt(100, (int)footprint.n_items_);
+    ut.CompareInt(0, (int)footprint.n_items_without_payload_);
+    ut.CompareInt(0, (int)footprint.n_invalid_notes_);
+    ut.CompareInt(300000, (int)footprint.payload_size_);
+    ut.CompareInt(100, (int)footprint.payload_size_buckets_[2]);
+    ut.CompareInt(10, (int)footprint.duplicates_.size());
+    for (const auto& duplicate : footprint.duplicates_) ut.CompareInt(10, (int)duplicate.n_items_);
+    ut.CompareInt(4, (int)footprint.legacy_hash_items_.size());
+    ut.CompareInt(75, (int)footprint.legacy_hash_items_.back());
+    ut.CompareInt(270000, (int)footprint.deduplication_savings_);
+
+    // The synthetic pdf files are random data, so almost nothing can be saved by compressing them.
+    ut.CompareInt(true, footprint.compression_savings_ < 1500);
+
+    // The linked file of each item is named after the hash of its pdf file.
+    std::vector<AIArtHandle> items;
+    L2A::UTIL::GetDocumentItems(document, items, L2A::UTIL::ArtSelection::all, options.item_name_);
+    std::string hash;
+    L2A::UTIL::ReadItemPDFFileHash(document.GetNote(items[1]), hash);
+    ut.CompareStr(ai::UnicodeString("document_LaTeX2AI_" + hash + ".pdf"),
+        ai::UnicodeString(document.GetPlacedItemPath(items[1]).filename().u8string()));
+}
+
+/**
+ *
+ */
+void L2A::TEST::TestDocumentFootprint(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("TestDocumentFootprint"));
+
+    // Call the individual tests
+    TestDocumentFootprintNotes(ut);
+    TestDocumentFootprintSyntheticDocument(ut);
+}
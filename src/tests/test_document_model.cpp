@@ -0,0 +1,224 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Test the document model and the document level functions.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_document_model.h"
+#include "testing_utlity.h"
+
+#include "l2a_compile_core.h"
+#include "l2a_constants.h"
+#include "l2a_document_model.h"
+#include "l2a_file_system.h"
+#include "l2a_links_folder.h"
+
+#include <cmath>
+#include <fstream>
+
+
+/**
+ *
+ */
+void TestDocumentModelFakeDocument(L2A::TEST::UTIL::UnitTest& ut)
+{
+    L2A::UTIL::FakeDocument document;
+    L2A::UTIL::FakeArt art;
+    art.name_ = "LaTeX2AI";
+    art.note_ = "note";
+    art.is_selected_ = true;
+    const AIArtHandle item_0 = document.AddArt(art);
+    art.name_ = "LaTeX2AI_copy";
+    art.is_selected_ = false;
+    art.is_locked_ = true;
+    const AIArtHandle item_1 = document.AddArt(art);
+    art.name_ = "image";
+    const AIArtHandle item_2 = document.AddArt(art);
+    ut.CompareInt(3, (int)document.Size());
+
+    // Only placed items whose name starts with the item name are LaTeX2AI items.
+    std::vector<AIArtHandle> items;
+    L2A::UTIL::GetDocumentItems(document, items, L2A::UTIL::ArtSelection::all, "LaTeX2AI");
+    ut.CompareInt(2, (int)items.size());
+    ut.CompareInt(true, items[0] == item_0 && items[1] == item_1);
+    L2A::UTIL::GetDocumentItems(document, items, L2A::UTIL::ArtSelection::selected, "LaTeX2AI");
+    ut.CompareInt(1, (int)items.size());
+    L2A::UTIL::GetDocumentItems(document, items, L2A::UTIL::ArtSelection::deselected, "LaTeX2AI");
+    ut.CompareInt(1, (int)items.size());
+    ut.CompareInt(true, items[0] == item_1);
+
+    // Each query of the document is counted.
+    ut.CompareInt(9, (int)document.GetCallCount());
+    document.ResetCallCount();
+    bool is_hidden;
+    bool is_locked;
+    document.GetIsHiddenLocked(item_1, is_hidden, is_locked);
+    ut.CompareInt(false, is_hidden);
+    ut.CompareInt(true, is_locked);
+    ut.CompareStr(ai::UnicodeString("note"), ai::UnicodeString(document.GetNote(item_2)));
+    ut.CompareInt(2, (int)document.GetCallCount());
+
+    // The data of the items can be changed.
+    document.GetArtMutable(item_2).name_ = "LaTeX2AI";
+    L2A::UTIL::GetDocumentItems(document, items, L2A::UTIL::ArtSelection::all, "LaTeX2AI");
+    ut.CompareInt(3, (int)items.size());
+}
+
+/**
+ *
+ */
+void TestDocumentModelSyntheticDocument(L2A::TEST::UTIL::UnitTest& ut)
+{
+    L2A::UTIL::SyntheticDocumentOptions options;
+    options.n_items_ = 100;
+    options.n_other_items_ = 7;
+    options.n_codes_ = 40;
+    L2A::UTIL::FakeDocument document;
+    L2A::UTIL::CreateSyntheticDocument(document, options);
+    ut.CompareInt(107, (int)document.Size());
+
+    std::vector<AIArtHandle> items;
+    L2A::UTIL::GetDocumentItems(document, items, L2A::UTIL::ArtSelection::all, options.item_name_);
+    ut.CompareInt(100, (int)items.size());
+
+    // The notes can be read and the items with the same code are compiled once.
+    std::vector<L2A::UTIL::RedoPlanItem> plan_items(items.size());
+    int n_read = 0;
+    for (size_t i_item = 0; i_item < items.size(); i_item++)
+        n_read += L2A::UTIL::ReadItemXML(document.GetNote(items[i_item]), plan_items[i_item]);
+    ut.CompareInt(100, n_read);
+    ut.CompareInt(40, (int)L2A::UTIL::CreateRedoPlan(plan_items).compile_items_.size());
+
+    // The items are linked to the pdf file of their hash.
+    std::string hash;
+    ut.CompareInt(true, L2A::UTIL::ReadItemPDFFileHash(document.GetNote(items[0]), hash));
+    ut.CompareStr(ai::UnicodeString(L2A::UTIL::GetStringHash(plan_items[0].latex_code_)), ai::UnicodeString(hash));
+    ut.CompareStr(ai::UnicodeString("document_LaTeX2AI_" + hash + ".pdf"),
+        ai::UnicodeString(document.GetPlacedItemPath(items[0]).filename().u8string()));
+
+    // The geometry of the rotated items is consistent with their bounds.
+    int n_rotated = 0;
+    int n_valid = 0;
+    for (const auto& item : items)
+    {
+        const auto geometry = document.GetGeometry(item);
+        n_rotated += geometry.IsRotated();
+        const auto points = L2A::UTIL::GetPlacementPoints(geometry);
+        const auto state = L2A::UTIL::CreateDrawnItemState(item, geometry, points, false, false);
+        const AIRealRect& bounds = geometry.GetBounds();
+        n_valid += !geometry.IsDiamond() && !geometry.IsStretched() &&
+                   std::abs(bounds.left - state.bounds_.left) < L2A::CONSTANTS::eps_pos_ &&
+                   std::abs(bounds.top - state.bounds_.top) < L2A::CONSTANTS::eps_pos_ &&
+                   std::abs(bounds.right - state.bounds_.right) < L2A::CONSTANTS::eps_pos_ &&
+                   std::abs(bounds.bottom - state.bounds_.bottom) < L2A::CONSTANTS::eps_pos_;
+    }
+    ut.CompareInt(100, n_valid);
+    ut.CompareInt(true, n_rotated > 0);
+}
+
+/**
+ *
+ */
+void TestDocumentModelItemState(L2A::TEST::UTIL::UnitTest& ut)
+{
+    const AIRealMatrix matrix = {1.0, 0.0, 0.0, -1.0, 0.0, 0.0};
+    const AIRealRect bounds = {10.0, 30.0, 50.0, 20.0};
+    const AIRealRect placed_bounding_box = {0.0, 10.0, 40.0, 0.0};
+    const L2A::UTIL::GeometrySnapshot geometry(matrix, bounds, placed_bounding_box);
+
+    // The points are ordered row by row from the top left to the bottom right.
+    const auto points = L2A::UTIL::GetPlacementPoints(geometry);
+    ut.CompareFloat(10.0, points[0].h, L2A::CONSTANTS::eps_pos_);
+    ut.CompareFloat(30.0, points[0].v, L2A::CONSTANTS::eps_pos_);
+    ut.CompareFloat(30.0, points[1].h, L2A::CONSTANTS::eps_pos_);
+    ut.CompareFloat(25.0, points[4].v, L2A::CONSTANTS::eps_pos_);
+    ut.CompareFloat(50.0, points[8].h, L2A::CONSTANTS::eps_pos_);
+    ut.CompareFloat(20.0, points[8].v, L2A::CONSTANTS::eps_pos_);
+
+    const AIArtHandle item = (AIArtHandle)1;
+    const auto state = L2A::UTIL::CreateDrawnItemState(item, geometry, points, false, true);
+    ut.CompareInt(true, state.art_ == item);
+    ut.CompareRect(bounds, state.bounds_);
+    ut.CompareInt(22, (int)state.values_.size());
+    ut.CompareFloat(1.0, state.values_[21], L2A::CONSTANTS::eps_pos_);
+
+    // A changed flag changes the drawn state.
+    const auto hidden_state = L2A::UTIL::CreateDrawnItemState(item, geometry, points, true, true);
+    ut.CompareInt(1, (int)L2A::UTIL::GetChangedBounds({state}, {hidden_state}, L2A::CONSTANTS::eps_pos_, 10).size());
+}
+
+/**
+ *
+ */
+void TestDocumentModelLinksPlan(L2A::TEST::UTIL::UnitTest& ut)
+{
+    const std::filesystem::path directory =
+        L2A::UTIL::FilePathAiToStd(L2A::UTIL::GetTemporaryDirectory()) / "document_model_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    std::ofstream(directory / "a.pdf") << "pdf contents a";
+    std::ofstream(directory / "b.pdf") << "pdf contents b";
+
+    L2A::UTIL::LinksManifest manifest(directory / "manifest.txt");
+    manifest.Update("a.pdf", "hash_a");
+    manifest.Update("b.pdf", "hash_b");
+
+    // Files that are not valid are written and relinked, items that are linked to a different file are relinked.
+    const std::vector<L2A::UTIL::ItemLinkState> items = {{"a.pdf", "hash_a", true}, {"b.pdf", "hash_b", false},
+        {"b.pdf", "hash_other", true}, {"c.pdf", "hash_c", true}, {"a.pdf", "hash_a", true}};
+    const L2A::UTIL::ItemLinksPlan plan = L2A::UTIL::CreateItemLinksPlan(manifest, items);
+    ut.CompareInt(2, (int)plan.write_items_.size());
+    ut.CompareInt(true, plan.write_items_ == std::vector<size_t>({2, 3}));
+    ut.CompareInt(true, plan.relink_items_ == std::vector<size_t>({1, 2, 3}));
+    ut.CompareInt(5, (int)plan.used_pdf_files_.size());
+    ut.CompareStr(ai::UnicodeString("c.pdf"), ai::UnicodeString(plan.used_pdf_files_[3]));
+
+    // Copies of the same item share one pdf file, it is only written once but all copies are relinked.
+    const std::vector<L2A::UTIL::ItemLinkState> copies = {{"d.pdf", "hash_d", false}, {"d.pdf", "hash_d", true},
+        {"a.pdf", "hash_a", true}, {"d.pdf", "hash_d", false}};
+    const L2A::UTIL::ItemLinksPlan copies_plan = L2A::UTIL::CreateItemLinksPlan(manifest, copies);
+    ut.CompareInt(true, copies_plan.write_items_ == std::vector<size_t>({0}));
+    ut.CompareInt(true, copies_plan.relink_items_ == std::vector<size_t>({0, 1, 3}));
+
+    std::filesystem::remove_all(directory);
+}
+
+/**
+ *
+ */
+void L2A::TEST::TestDocumentModel(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("TestDocumentModel"));
+
+    // Call the individual tests
+    TestDocumentModelFakeDocument(ut);
+    TestDocumentModelSyntheticDocument(ut);
+    TestDocumentModelItemState(ut);
+    TestDocumentModelLinksPlan(ut);
+}
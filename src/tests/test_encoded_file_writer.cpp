@@ -0,0 +1,150 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Test the parallel writing of encoded files.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_encoded_file_writer.h"
+#include "testing_utlity.h"
+
+#include "base64.h"
+
+#include "l2a_encoded_file_writer.h"
+#include "l2a_file_system.h"
+#include "l2a_links_folder.h"
+
+#include <fstream>
+#include <iterator>
+#include <random>
+
+
+/**
+ * \brief Create encoded files with random contents in a directory.
+ */
+std::vector<L2A::UTIL::EncodedFileWrite> CreateEncodedTestFiles(const std::filesystem::path& directory,
+    const size_t n_files, const size_t file_size, std::vector<std::string>& contents)
+{
+    std::mt19937 random_generator(2);
+    std::uniform_int_distribution<int> distribution(0, 255);
+
+    std::vector<L2A::UTIL::EncodedFileWrite> files(n_files);
+    contents.resize(n_files);
+    for (size_t i_file = 0; i_file < n_files; i_file++)
+    {
+        contents[i_file].resize(file_size + i_file % 7);
+        for (auto& character : contents[i_file]) character = (char)distribution(random_generator);
+        files[i_file].path_ = directory / ("file_LaTeX2AI_" + std::to_string(i_file) + ".pdf");
+        files[i_file].encoded_contents_ = base64::encode(contents[i_file].c_str(), contents[i_file].size());
+    }
+    return files;
+}
+
+/**
+ * \brief Check if the files are written with the expected contents.
+ */
+bool CheckEncodedTestFiles(
+    const std::vector<L2A::UTIL::EncodedFileWrite>& files, const std::vector<std::string>& contents)
+{
+    for (size_t i_file = 0; i_file < files.size(); i_file++)
+    {
+        std::ifstream file(files[i_file].path_, std::ios::binary);
+        const std::string file_contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (!files[i_file].is_written_ || file_contents != contents[i_file]) return false;
+        if (files[i_file].content_hash_ != L2A::UTIL::GetDataContentHash(file_contents.data(), file_contents.size()))
+            return false;
+    }
+    return true;
+}
+
+/**
+ *
+ */
+void L2A::TEST::TestEncodedFileWriter(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("TestEncodedFileWriter"));
+
+    const std::filesystem::path directory =
+        L2A::UTIL::FilePathAiToStd(L2A::UTIL::GetTemporaryDirectory()) / "encoded_file_writer_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    // The result has to be the same for a single and for multiple threads.
+    std::vector<std::string> contents;
+    for (const unsigned int n_threads : {1u, 4u})
+    {
+        auto files = CreateEncodedTestFiles(directory, 50, 1000, contents);
+        L2A::UTIL::WriteEncodedFiles(files, n_threads);
+        ut.CompareInt(true, CheckEncodedTestFiles(files, contents));
+    }
+
+    // Files that can not be written are reported and do not stop the other files.
+    auto files = CreateEncodedTestFiles(directory, 10, 100, contents);
+    files[3].encoded_contents_.clear();
+    files[7].path_ = directory / "missing_directory" / "file.pdf";
+    L2A::UTIL::WriteEncodedFiles(files, 3);
+    ut.CompareInt(false, files[3].is_written_);
+    ut.CompareInt(false, files[7].is_written_);
+    ut.CompareInt(false, std::filesystem::exists(files[7].path_));
+    files.erase(files.begin() + 7);
+    files.erase(files.begin() + 3);
+    contents.erase(contents.begin() + 7);
+    contents.erase(contents.begin() + 3);
+    ut.CompareInt(true, CheckEncodedTestFiles(files, contents));
+
+    std::filesystem::remove_all(directory);
+}
+
+/**
+ *
+ */
+void L2A::TEST::BenchmarkEncodedFileWriter(L2A::TEST::UTIL::UnitTest& ut, L2A::TEST::UTIL::Benchmark& benchmark)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("BenchmarkEncodedFileWriter"));
+
+    // Repair of a document with 5000 items, where all pdf files are missing.
+    const std::filesystem::path directory =
+        L2A::UTIL::FilePathAiToStd(L2A::UTIL::GetTemporaryDirectory()) / "encoded_file_writer_benchmark";
+    std::vector<std::string> contents;
+    for (const unsigned int n_threads_benchmark : {1u, 2u, 4u, 8u})
+    {
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        auto files = CreateEncodedTestFiles(directory, 5000, 20000, contents);
+
+        L2A::TEST::UTIL::Timer timer;
+        L2A::UTIL::WriteEncodedFiles(files, n_threads_benchmark);
+        timer.Stop();
+        benchmark.AddResult(ai::UnicodeString("WriteEncodedFiles (5000 files, " +
+                                              std::to_string(n_threads_benchmark) + " threads)"),
+            files.size(), timer);
+        ut.CompareInt(true, CheckEncodedTestFiles(files, contents));
+    }
+    std::filesystem::remove_all(directory);
+}
@@ -37,6 +37,8 @@
 #include "l2a_file_system.h"
 #include "l2a_string_functions.h"
 
+#include <fstream>
+
 
 /**
  *
@@ -185,3 +187,36 @@ void L2A::TEST::TestFileSystem(L2A::TEST::UTIL::UnitTest& ut)
     // Test the execute function with unicode strings
     TestExecute(ut);
 }
+
+/**
+ *
+ */
+void L2A::TEST::BenchmarkFileSystem(L2A::TEST::UTIL::UnitTest& ut, L2A::TEST::UTIL::Benchmark& benchmark)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("BenchmarkFileSystem"));
+
+    // Directory with the split pages of a large compilation and as many other files.
+    ai::FilePath directory = L2A::UTIL::GetTemporaryDirectory();
+    directory.AddComponent(ai::UnicodeString("find_files_benchmark"));
+    const std::filesystem::path directory_std = L2A::UTIL::FilePathAiToStd(directory);
+    std::filesystem::remove_all(directory_std);
+    std::filesystem::create_directories(directory_std);
+    const size_t n_pages = 5000;
+    for (size_t i = 1; i <= n_pages; i++)
+    {
+        std::ofstream(directory_std / ("LaTeX2AI_item_" + std::to_string(i) + ".pdf")) << i;
+        std::ofstream(directory_std / ("document_LaTeX2AI_" + std::to_string(i) + ".pdf")) << i;
+    }
+
+    const size_t n_operations = 5;
+    size_t n_found = 0;
+    L2A::TEST::UTIL::Timer timer;
+    for (size_t i = 0; i < n_operations; i++)
+        n_found += L2A::UTIL::FindFilesInFolder(directory, ai::UnicodeString("LaTeX2AI_item_[0-9]+\\.pdf$")).size();
+    timer.Stop();
+    benchmark.AddResult(ai::UnicodeString("FindFilesInFolder (10k files)"), n_operations, timer);
+    ut.CompareInt((int)(n_operations * n_pages), (int)n_found);
+
+    std::filesystem::remove_all(directory_std);
+}
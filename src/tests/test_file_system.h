@@ -39,6 +39,7 @@ namespace L2A
         namespace UTIL
         {
             class UnitTest;
+            class Benchmark;
         }
     }  // namespace TEST
 }  // namespace L2A
@@ -52,6 +53,11 @@ namespace L2A
          * \brief Test the functionality of the file system functions.
          */
         void TestFileSystem(L2A::TEST::UTIL::UnitTest& ut);
+
+        /**
+         * \brief Benchmark searching files in a large directory.
+         */
+        void BenchmarkFileSystem(L2A::TEST::UTIL::UnitTest& ut, L2A::TEST::UTIL::Benchmark& benchmark);
     }  // namespace TEST
 }  // namespace L2A
 
@@ -377,7 +377,7 @@ void L2A::TEST::TestFramework(L2A::TEST::UTIL::UnitTest& ut)
             for (const auto& placed_item : placed_items)
             {
                 L2A::Item l2a_item(placed_item);
-                ut.CompareInt(abs(l2a_item.GetAngle() - 3.14159265358979323846 * (196.9 - 360) / 180.0) <
+                ut.CompareInt(abs(l2a_item.GetGeometry().GetAngle() - 3.14159265358979323846 * (196.9 - 360) / 180.0) <
                                   L2A::CONSTANTS::eps_angle_,
                     true);
             }
@@ -634,6 +634,21 @@ void L2A::TEST::TestFramework(L2A::TEST::UTIL::UnitTest& ut)
                 // Check if the positions fit to the reference solutions
                 CompareItemPosition(ut, l2a_item, reference_solution[i_item]);
             }
+
+            // Check that the transformation to the view used by the annotator gives the same results as the suite
+            // functions. The suite functions return integer values, therefore the tolerance is one pixel.
+            const AIRealMatrix artwork_to_view = L2A::AI::GetArtworkToViewTransformation();
+            for (const auto& art_item : art_items)
+            {
+                L2A::Item l2a_item(art_item);
+                for (const auto& point : l2a_item.GetPosition({kTopLeft, kMidMid, kBotRight}))
+                {
+                    const AIPoint view_point_suite = L2A::AI::ArtworkPointToViewPoint(point);
+                    const AIRealPoint view_point = L2A::UTIL::MATH::TransformPoint(artwork_to_view, point);
+                    ut.CompareFloat((AIReal)view_point_suite.h, view_point.h, (AIReal)1.0 + L2A::CONSTANTS::eps_pos_);
+                    ut.CompareFloat((AIReal)view_point_suite.v, view_point.v, (AIReal)1.0 + L2A::CONSTANTS::eps_pos_);
+                }
+            }
         }
     }
     catch (...)
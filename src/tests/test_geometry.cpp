@@ -0,0 +1,151 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Test the geometry functions.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_geometry.h"
+#include "testing_utlity.h"
+
+#include "l2a_constants.h"
+#include "l2a_geometry.h"
+
+
+/**
+ * \brief Get the placed matrix of an item that is rotated by an angle (in this convention the placed matrix of an
+ * item that is not transformed has d = -1).
+ */
+AIRealMatrix GetRotatedPlacedMatrix(const AIReal angle)
+{
+    return AIRealMatrix{cos(angle), -sin(angle), -sin(angle), -cos(angle), 0.0, 0.0};
+}
+
+/**
+ * \brief Compare the position of a point on the item.
+ */
+void ComparePosition(L2A::TEST::UTIL::UnitTest& ut, const L2A::UTIL::GeometrySnapshot& geometry,
+    const AIReal (&pos_fac)[2], const AIRealPoint& reference)
+{
+    const AIRealPoint position = geometry.GetPosition(pos_fac);
+    ut.CompareFloat(reference.h, position.h, L2A::CONSTANTS::eps_pos_);
+    ut.CompareFloat(reference.v, position.v, L2A::CONSTANTS::eps_pos_);
+}
+
+/**
+ *
+ */
+void TestGeometryDefault(L2A::TEST::UTIL::UnitTest& ut)
+{
+    const AIRealRect bounds = {100.0, 220.0, 110.0, 200.0};
+    const AIRealRect placed_bounding_box = {0.0, 20.0, 10.0, 0.0};
+    const L2A::UTIL::GeometrySnapshot geometry(AIRealMatrix{1.0, 0.0, 0.0, -1.0, 100.0, 200.0}, bounds,
+        placed_bounding_box);
+
+    ut.CompareFloat(0.0, geometry.GetAngle(0), L2A::CONSTANTS::eps_angle_);
+    ut.CompareFloat(0.5 * 3.14159265358979323846, geometry.GetAngle(1), L2A::CONSTANTS::eps_angle_);
+    ut.CompareFloat(1.0, geometry.GetStretch(0), L2A::CONSTANTS::eps_strech_);
+    ut.CompareFloat(1.0, geometry.GetStretch(1), L2A::CONSTANTS::eps_strech_);
+    ut.CompareInt(false, geometry.IsRotated());
+    ut.CompareInt(false, geometry.IsDiamond());
+    ut.CompareInt(false, geometry.IsStretched());
+    ut.CompareRect(bounds, geometry.GetBounds());
+    ut.CompareRect(placed_bounding_box, geometry.GetPlacedBoundingBox());
+
+    ComparePosition(ut, geometry, {0.0, 0.0}, {100.0, 200.0});
+    ComparePosition(ut, geometry, {0.5, 0.5}, {105.0, 210.0});
+    ComparePosition(ut, geometry, {1.0, 1.0}, {110.0, 220.0});
+}
+
+/**
+ *
+ */
+void TestGeometryRotated(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Item with a width of 10 and a height of 5 that is rotated by 90 degrees.
+    const AIReal angle = 0.5 * 3.14159265358979323846;
+    const L2A::UTIL::GeometrySnapshot geometry(
+        GetRotatedPlacedMatrix(angle), {100.0, 210.0, 105.0, 200.0}, {0.0, 5.0, 10.0, 0.0});
+
+    ut.CompareFloat(angle, geometry.GetAngle(0), L2A::CONSTANTS::eps_angle_);
+    ut.CompareFloat(2.0 * angle, geometry.GetAngle(1), L2A::CONSTANTS::eps_angle_);
+    ut.CompareInt(true, geometry.IsRotated());
+    ut.CompareInt(false, geometry.IsDiamond());
+    ut.CompareInt(false, geometry.IsStretched());
+
+    // The bottom left corner of the text is at the bottom right of the bounds.
+    ComparePosition(ut, geometry, {0.0, 0.0}, {105.0, 200.0});
+    ComparePosition(ut, geometry, {1.0, 0.0}, {105.0, 210.0});
+    ComparePosition(ut, geometry, {0.0, 1.0}, {100.0, 200.0});
+    ComparePosition(ut, geometry, {1.0, 1.0}, {100.0, 210.0});
+    ComparePosition(ut, geometry, {0.5, 0.5}, {102.5, 205.0});
+}
+
+/**
+ *
+ */
+void TestGeometryStretchedDiamond(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Item that is stretched in the first direction.
+    {
+        const L2A::UTIL::GeometrySnapshot geometry(
+            AIRealMatrix{2.0, 0.0, 0.0, -1.0, 0.0, 0.0}, {0.0, 5.0, 20.0, 0.0}, {0.0, 5.0, 10.0, 0.0});
+        ut.CompareFloat(2.0, geometry.GetStretch(0), L2A::CONSTANTS::eps_strech_);
+        ut.CompareFloat(1.0, geometry.GetStretch(1), L2A::CONSTANTS::eps_strech_);
+        ut.CompareInt(false, geometry.IsRotated());
+        ut.CompareInt(false, geometry.IsDiamond());
+        ut.CompareInt(true, geometry.IsStretched());
+        ComparePosition(ut, geometry, {1.0, 0.5}, {20.0, 2.5});
+    }
+
+    // Item that is sheared, i.e., the edges are not perpendicular.
+    {
+        const L2A::UTIL::GeometrySnapshot geometry(
+            AIRealMatrix{1.0, 0.0, 1.0, -1.0, 0.0, 0.0}, {0.0, 5.0, 15.0, 0.0}, {0.0, 5.0, 10.0, 0.0});
+        ut.CompareInt(false, geometry.IsRotated());
+        ut.CompareInt(true, geometry.IsDiamond());
+        ut.CompareInt(true, geometry.IsStretched());
+        ComparePosition(ut, geometry, {0.0, 0.0}, {0.0, 0.0});
+        ComparePosition(ut, geometry, {1.0, 0.0}, {10.0, 0.0});
+        ComparePosition(ut, geometry, {0.0, 1.0}, {5.0, 5.0});
+        ComparePosition(ut, geometry, {1.0, 1.0}, {15.0, 5.0});
+    }
+}
+
+/**
+ *
+ */
+void L2A::TEST::TestGeometry(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("TestGeometry"));
+
+    // Call the individual tests
+    TestGeometryDefault(ut);
+    TestGeometryRotated(ut);
+    TestGeometryStretchedDiamond(ut);
+}
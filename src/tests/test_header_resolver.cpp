@@ -0,0 +1,252 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Test the header resolver.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_header_resolver.h"
+#include "testing_utlity.h"
+
+#include "l2a_file_system.h"
+#include "l2a_header_resolver.h"
+#include "l2a_redo_plan.h"
+
+#include <fstream>
+#include <stdexcept>
+
+
+/**
+ * \brief Write a text to a file.
+ */
+void WriteHeaderResolverTestFile(const std::filesystem::path& path, const std::string& text)
+{
+    std::ofstream file(path, std::ios::trunc);
+    file << text;
+}
+
+/**
+ *
+ */
+void L2A::TEST::TestHeaderResolver(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("TestHeaderResolver"));
+
+    // Create a header with inputs, an include, a missing input, a commented input and a local package.
+    const std::filesystem::path directory =
+        L2A::UTIL::FilePathAiToStd(L2A::UTIL::GetTemporaryDirectory()) / "header_resolver_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory / "sub");
+    const std::filesystem::path header_path = directory / "header.tex";
+    WriteHeaderResolverTestFile(header_path,
+        "\\documentclass{article}\n"
+        "\\usepackage[option]{amsmath, local}\n"
+        "\\input{sub/macros}\n"
+        "\\include {chapter}\n"
+        "\\input{missing}\n"
+        "% \\input{sub/macros}\n"
+        "\\% \\input{sub/macros.tex}\n");
+    WriteHeaderResolverTestFile(directory / "sub" / "macros.tex", "\\newcommand{\\a}{a}\n\\input{nested}");
+    WriteHeaderResolverTestFile(directory / "sub" / "nested.tex", "\\newcommand{\\b}{b}");
+    WriteHeaderResolverTestFile(directory / "chapter.tex", "\\newcommand{\\c}{c}");
+    WriteHeaderResolverTestFile(directory / "local.sty", "\\RequirePackage{local}\n\\input{package_input}");
+    WriteHeaderResolverTestFile(directory / "package_input.tex", "\\newcommand{\\d}{d}");
+
+    L2A::UTIL::HeaderResolver resolver;
+    std::string digest;
+    {
+        const auto& resolved = resolver.Resolve(header_path);
+        ut.CompareStr(ai::UnicodeString(resolved.text_),
+            ai::UnicodeString("\\documentclass{article}\n"
+                              "\\usepackage[option]{amsmath, local}\n"
+                              "\\newcommand{\\a}{a}\n\\newcommand{\\b}{b}\n"
+                              "\\newcommand{\\c}{c}\n"
+                              "\\input{missing}\n"
+                              "% \\input{sub/macros}\n"
+                              "\\% \\newcommand{\\a}{a}\n\\newcommand{\\b}{b}\n"));
+        ut.CompareInt(0, (int)resolved.cycle_.size());
+        ut.CompareInt(1, (int)resolved.local_packages_.size());
+        ut.CompareStr(ai::UnicodeString(resolved.local_packages_[0].relative_path_.u8string()),
+            ai::UnicodeString("local.sty"));
+
+        // The header, amsmath.sty, local.sty, package_input.tex, sub/macros.tex, sub/nested.tex, chapter.tex,
+        // missing.tex and missing.
+        ut.CompareInt(9, (int)resolved.dependencies_.size());
+        digest = resolved.digest_;
+    }
+
+    // As long as nothing changes, the cached header is returned.
+    ut.CompareStr(ai::UnicodeString(resolver.Resolve(header_path).digest_), ai::UnicodeString(digest));
+    ut.CompareStr(ai::UnicodeString(resolver.Resolve(directory / "sub" / ".." / "header.tex").digest_),
+        ai::UnicodeString(digest));
+    ut.CompareInt(1, (int)resolver.GetStatistics().n_resolved_);
+    ut.CompareInt(2, (int)resolver.GetStatistics().n_cached_);
+
+    // A change in a nested input, a local package and a previously missing file changes the header.
+    WriteHeaderResolverTestFile(directory / "sub" / "nested.tex", "\\newcommand{\\b}{bb}");
+    const std::string digest_nested = resolver.Resolve(header_path).digest_;
+    ut.CompareInt(false, digest == digest_nested);
+    WriteHeaderResolverTestFile(directory / "package_input.tex", "\\newcommand{\\d}{dd}");
+    const std::string digest_package = resolver.Resolve(header_path).digest_;
+    ut.CompareInt(false, digest_nested == digest_package);
+    WriteHeaderResolverTestFile(directory / "missing.tex", "\\newcommand{\\e}{e}");
+    {
+        const auto& resolved = resolver.Resolve(header_path);
+        ut.CompareInt(false, digest_package == resolved.digest_);
+        ut.CompareInt(true, resolved.text_.find("\\input{missing}") == std::string::npos);
+    }
+    ut.CompareInt(4, (int)resolver.GetStatistics().n_resolved_);
+    ut.CompareInt(2, (int)resolver.GetStatistics().n_cached_);
+
+    // Inputs that form a cycle are detected.
+    WriteHeaderResolverTestFile(directory / "chapter.tex", "\\input{sub/macros}");
+    WriteHeaderResolverTestFile(directory / "sub" / "nested.tex", "\\input{../chapter}");
+    {
+        const auto& resolved = resolver.Resolve(header_path);
+        ut.CompareInt(4, (int)resolved.cycle_.size());
+        ut.CompareStr(ai::UnicodeString(resolved.cycle_.front().filename().u8string()),
+            ai::UnicodeString(resolved.cycle_.back().filename().u8string()));
+    }
+
+    // The watcher reports a change once the files did not change between two polls.
+    {
+        L2A::UTIL::HeaderWatcher watcher;
+        ut.CompareInt(false, watcher.IsWatching());
+        watcher.Watch(resolver.Resolve(header_path).dependencies_);
+        ut.CompareInt(true, watcher.IsWatching());
+        ut.CompareInt(false, watcher.Poll());
+        WriteHeaderResolverTestFile(directory / "missing.tex", "changed");
+        ut.CompareInt(false, watcher.Poll());
+        ut.CompareInt(true, watcher.Poll());
+        ut.CompareInt(false, watcher.Poll());
+        WriteHeaderResolverTestFile(directory / "missing.tex", "changed again");
+        ut.CompareInt(false, watcher.Poll());
+        WriteHeaderResolverTestFile(directory / "missing.tex", "changed for the third time");
+        ut.CompareInt(false, watcher.Poll());
+        ut.CompareInt(true, watcher.Poll());
+        watcher.Clear();
+        ut.CompareInt(false, watcher.IsWatching());
+    }
+
+    // Files are only written if they changed.
+    const std::filesystem::path written_path = directory / "written.tex";
+    ut.CompareInt(true, L2A::UTIL::WriteFileIfChanged(written_path, "text\nline"));
+    ut.CompareInt(false, L2A::UTIL::WriteFileIfChanged(written_path, "text\nline"));
+    ut.CompareInt(true, L2A::UTIL::WriteFileIfChanged(written_path, "text\nline 2"));
+    bool is_write_error = false;
+    try
+    {
+        L2A::UTIL::WriteFileIfChanged(directory / "missing_directory" / "written.tex", "text");
+    }
+    catch (const std::runtime_error&)
+    {
+        is_write_error = true;
+    }
+    ut.CompareInt(true, is_write_error);
+
+    // A document without a header is compiled with the default header, which is created during the compilation. The
+    // digest of the default text has to match the one of the created header, otherwise the items are stale right after
+    // the first compilation.
+    {
+        const std::filesystem::path new_directory = directory / "new_document";
+        std::filesystem::create_directories(new_directory);
+        WriteHeaderResolverTestFile(new_directory / "local.sty", "\\newcommand{\\f}{f}");
+        const std::string default_header = "\\documentclass{article}\n\\usepackage{local}\n\\input{missing}\n";
+        const std::string digest_compile = resolver.ResolveText(default_header, new_directory).digest_;
+
+        WriteHeaderResolverTestFile(new_directory / "header.tex", default_header);
+        L2A::UTIL::RedoPlanItem item;
+        item.latex_code_ = "$a$";
+        item.is_up_to_date_ = digest_compile == resolver.Resolve(new_directory / "header.tex").digest_;
+        const L2A::UTIL::RedoPlan plan = L2A::UTIL::CreateRedoPlan({item});
+        ut.CompareInt(1, (int)plan.n_skipped_);
+        ut.CompareInt(0, (int)plan.compile_items_.size());
+    }
+
+    std::filesystem::remove_all(directory);
+}
+
+/**
+ *
+ */
+void L2A::TEST::BenchmarkHeaderResolver(L2A::TEST::UTIL::UnitTest& ut, L2A::TEST::UTIL::Benchmark& benchmark)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("BenchmarkHeaderResolver"));
+
+    // Header with 4 levels of inputs, each file inputs 3 further files, i.e., 121 files in total.
+    const std::filesystem::path directory =
+        L2A::UTIL::FilePathAiToStd(L2A::UTIL::GetTemporaryDirectory()) / "header_resolver_benchmark";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    std::string macros;
+    for (size_t i = 0; i < 50; i++) macros += "\\newcommand{\\macro" + std::to_string(i) + "}{x}\n";
+    std::vector<std::string> level_names = {"header"};
+    size_t n_files = 1;
+    for (size_t i_level = 0; i_level < 4; i_level++)
+    {
+        std::vector<std::string> next_level_names;
+        for (const auto& name : level_names)
+        {
+            std::string text = macros;
+            for (size_t i_input = 0; i_input < 3; i_input++)
+            {
+                next_level_names.push_back(name + "_" + std::to_string(i_input));
+                text += "\\input{" + next_level_names.back() + "}\n";
+            }
+            WriteHeaderResolverTestFile(directory / (name + ".tex"), text);
+        }
+        level_names = next_level_names;
+        n_files += level_names.size();
+    }
+    for (const auto& name : level_names) WriteHeaderResolverTestFile(directory / (name + ".tex"), macros);
+    const std::filesystem::path header_path = directory / "header.tex";
+
+    const size_t n_operations = 20;
+    size_t n_resolved_files = 0;
+    L2A::TEST::UTIL::Timer timer;
+    for (size_t i = 0; i < n_operations; i++)
+    {
+        L2A::UTIL::HeaderResolver resolver;
+        n_resolved_files += resolver.Resolve(header_path).dependencies_.size();
+    }
+    timer.Stop();
+    benchmark.AddResult(ai::UnicodeString("HeaderResolver resolve (121 nested files)"), n_operations, timer);
+    ut.CompareInt((int)(n_operations * n_files), (int)n_resolved_files);
+
+    const size_t n_cached_operations = 1000;
+    L2A::UTIL::HeaderResolver resolver;
+    resolver.Resolve(header_path);
+    timer.Reset();
+    for (size_t i = 0; i < n_cached_operations; i++) resolver.Resolve(header_path);
+    timer.Stop();
+    benchmark.AddResult(ai::UnicodeString("HeaderResolver cached (121 nested files)"), n_cached_operations, timer);
+    ut.CompareInt((int)n_cached_operations, (int)resolver.GetStatistics().n_cached_);
+
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,121 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Test the invalidation functions.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_invalidation.h"
+#include "testing_utlity.h"
+
+#include "l2a_constants.h"
+#include "l2a_invalidation.h"
+
+
+/**
+ * \brief Create a drawn state for an item with a single point.
+ */
+L2A::UTIL::DrawnItemState CreateDrawnState(const size_t art_id, const AIRealRect& bounds, const AIReal value)
+{
+    return L2A::UTIL::DrawnItemState{(AIArtHandle)(art_id + 1), bounds, {value, 0.0}};
+}
+
+/**
+ *
+ */
+void TestInvalidationRect(L2A::TEST::UTIL::UnitTest& ut)
+{
+    const AIRealRect rect_a = {0.0, 20.0, 10.0, 0.0};
+    const AIRealRect rect_b = {5.0, 30.0, 15.0, 25.0};
+    const AIRealRect rect_union = {0.0, 30.0, 15.0, 0.0};
+    ut.CompareRect(rect_union, L2A::UTIL::GetRectUnion(rect_a, rect_b));
+    ut.CompareFloat(200.0, L2A::UTIL::GetRectArea(rect_a), L2A::CONSTANTS::eps_pos_);
+
+    // View coordinates have top < bottom.
+    const AIRealRect view_rect = {0.0, 0.0, 10.0, 20.0};
+    ut.CompareFloat(200.0, L2A::UTIL::GetRectArea(view_rect), L2A::CONSTANTS::eps_pos_);
+}
+
+/**
+ *
+ */
+void TestInvalidationChangedBounds(L2A::TEST::UTIL::UnitTest& ut)
+{
+    const AIReal eps = L2A::CONSTANTS::eps_pos_;
+    const AIRealRect bounds_0 = {0.0, 10.0, 10.0, 0.0};
+    const AIRealRect bounds_1 = {20.0, 10.0, 30.0, 0.0};
+    const AIRealRect bounds_2 = {40.0, 10.0, 50.0, 0.0};
+    const AIRealRect bounds_1_moved = {20.0, 110.0, 30.0, 100.0};
+    const std::vector<L2A::UTIL::DrawnItemState> old_states = {CreateDrawnState(0, bounds_0, 1.0),
+        CreateDrawnState(1, bounds_1, 1.0), CreateDrawnState(2, bounds_2, 1.0)};
+
+    // Nothing changed, also the order of the items does not matter.
+    {
+        const std::vector<L2A::UTIL::DrawnItemState> new_states = {CreateDrawnState(2, bounds_2, 1.0),
+            CreateDrawnState(0, bounds_0, 1.0), CreateDrawnState(1, bounds_1, 1.0 + 0.1 * eps)};
+        ut.CompareInt(0, (int)L2A::UTIL::GetChangedBounds(old_states, new_states, eps, 10).size());
+    }
+
+    // Moved item, item with a changed drawing state, removed item and added item.
+    {
+        const AIRealRect bounds_3 = {60.0, 10.0, 70.0, 0.0};
+        const std::vector<L2A::UTIL::DrawnItemState> new_states = {CreateDrawnState(0, bounds_0, 2.0),
+            CreateDrawnState(1, bounds_1_moved, 1.0), CreateDrawnState(3, bounds_3, 1.0)};
+        const auto changed_bounds = L2A::UTIL::GetChangedBounds(old_states, new_states, eps, 10);
+        ut.CompareInt(4, (int)changed_bounds.size());
+        if (changed_bounds.size() == 4)
+        {
+            ut.CompareRect(bounds_0, changed_bounds[0]);
+            ut.CompareRect(AIRealRect{20.0, 110.0, 30.0, 0.0}, changed_bounds[1]);
+            ut.CompareRect(bounds_3, changed_bounds[2]);
+            ut.CompareRect(bounds_2, changed_bounds[3]);
+        }
+
+        // Too many rectangles are merged into one.
+        const auto merged_bounds = L2A::UTIL::GetChangedBounds(old_states, new_states, eps, 3);
+        ut.CompareInt(1, (int)merged_bounds.size());
+        if (merged_bounds.size() == 1) ut.CompareRect(AIRealRect{0.0, 110.0, 70.0, 0.0}, merged_bounds[0]);
+    }
+
+    // All items are removed.
+    {
+        const std::vector<L2A::UTIL::DrawnItemState> new_states;
+        ut.CompareInt(3, (int)L2A::UTIL::GetChangedBounds(old_states, new_states, eps, 10).size());
+    }
+}
+
+/**
+ *
+ */
+void L2A::TEST::TestInvalidation(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("TestInvalidation"));
+
+    TestInvalidationRect(ut);
+    TestInvalidationChangedBounds(ut);
+}
@@ -35,6 +35,7 @@
 
 #include "l2a_file_system.h"
 #include "l2a_latex.h"
+#include "l2a_property.h"
 
 
 /**
@@ -61,6 +62,39 @@ void TestLatexBase(L2A::TEST::UTIL::UnitTest& ut, const ai::FilePath& temp_direc
     ut.CompareInt(L2A::UTIL::IsFile(pdf_file), 1);
 }
 
+/**
+ *
+ */
+void TestLatexCompileDigest(L2A::TEST::UTIL::UnitTest& ut)
+{
+    const std::string header("\\documentclass{article}\n\\usepackage{amsmath}\n");
+    const ai::UnicodeString engine("pdflatex");
+    const ai::UnicodeString options("-interaction nonstopmode -halt-on-error");
+    const ai::UnicodeString digest = L2A::LATEX::GetCompileDigest(header, engine, options);
+
+    // The digest only changes if one of the inputs changes.
+    ut.CompareStr(digest, L2A::LATEX::GetCompileDigest(header, engine, options));
+    ut.CompareInt(false, digest == L2A::LATEX::GetCompileDigest(header + "%", engine, options));
+    ut.CompareInt(false, digest == L2A::LATEX::GetCompileDigest(header, ai::UnicodeString("lualatex"), options));
+    ut.CompareInt(false, digest == L2A::LATEX::GetCompileDigest(header, engine, ai::UnicodeString("")));
+
+    // Items without a digest are always stale.
+    L2A::Property property;
+    ut.CompareInt(true, property.IsStale(digest));
+    property.SetCompileDigest(digest);
+    ut.CompareInt(false, property.IsStale(digest));
+    ut.CompareInt(true, property.IsStale(L2A::LATEX::GetCompileDigest(header, engine, ai::UnicodeString(""))));
+
+    // The digest and the compile time are stored with the property.
+    L2A::Property property_from_string;
+    property_from_string.SetFromString(property.ToString());
+    ut.CompareStr(digest, property_from_string.GetCompileDigest());
+    ut.CompareInt(true, property_from_string.GetCompileTime() < 0.0);
+    property.SetCompileTime(0.125);
+    property_from_string.SetFromString(property.ToString());
+    ut.CompareFloat(0.125, property_from_string.GetCompileTime(), 1e-6);
+}
+
 /**
  *
  */
@@ -78,5 +112,8 @@ void L2A::TEST::TestLatex(L2A::TEST::UTIL::UnitTest& ut)
     // Test that we can create a Latex document with a unicode path
     TestLatexBase(ut, temp_directory);
 
+    // Test the digest that is used to find stale items
+    TestLatexCompileDigest(ut);
+
     L2A::UTIL::SetWorkingDirectory(L2A::UTIL::FilePathStdToAi(old_cwd));
 }
@@ -0,0 +1,96 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Test the syntax check of the LaTeX code.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_latex_syntax.h"
+#include "testing_utlity.h"
+
+#include "l2a_latex_syntax.h"
+
+
+/**
+ *
+ */
+void L2A::TEST::TestLatexSyntax(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("TestLatexSyntax"));
+
+    L2A::UTIL::LatexSyntaxError error;
+
+    {
+        // Valid code is not changed by escaped characters, comments, verbatim text or commands with arguments.
+        const std::vector<std::string> valid_codes = {"", "text", "$a^{2}$", "$$\\frac{a}{b}$$", "\\(a\\) \\[b\\]",
+            "\\begin{align}a &= \\left( \\frac12 \\right) \\\\[2pt] b\\end{align}", "\\{ \\} \\$ \\% 50\\%",
+            "a % unmatched { $ in a comment", "\\verb|{$|", "\\begin{verbatim}\\end{align} {\\end{verbatim}",
+            "$\\text{if $x$}$", "$\\sqrt[3]{x} \\frac\\alpha\\beta \\binom{n}{k}$", "\\left\\{ x \\right.",
+            "\\newcommand{\\be}{\\begin{align}}", "$\\frac{a % comment }\n}{b}$"};
+        for (const auto& code : valid_codes)
+            ut.CompareInt(true, L2A::UTIL::CheckLatexSyntax(code, error));
+    }
+
+    {
+        // Errors are found at the offending position.
+        auto check_error = [&](const std::string& code, const size_t offset, const std::string& message)
+        {
+            ut.CompareInt(false, L2A::UTIL::CheckLatexSyntax(code, error));
+            ut.CompareInt((int)offset, (int)error.offset_);
+            ut.CompareStr(ai::UnicodeString(message), ai::UnicodeString(error.message_));
+        };
+        check_error("a {b", 2, "{ is not closed");
+        check_error("a}b", 1, "} has no matching {");
+        check_error("$a + b", 0, "$ is not closed");
+        check_error("$a}$", 2, "Missing $ before }");
+        check_error("$$a$", 3, "Display math has to be closed with $$");
+        check_error("a \\end{align}", 2, "\\end{align} has no matching \\begin{align}");
+        check_error("\\begin{align}a\\end{equation}", 14, "Missing \\end{align} before \\end{equation}");
+        check_error("\\begin{align}a", 0, "\\begin{align} is not closed");
+        check_error("\\begin a", 0, "Missing environment name after \\begin");
+        check_error("$\\left( a$", 9, "Missing \\right before $");
+        check_error("\\(a\\]", 3, "Missing \\) before \\]");
+        check_error("$\\frac{a}{b$", 1, "Missing } in an argument of \\frac");
+        check_error("$\\frac{a}$", 1, "Missing argument of \\frac");
+        check_error("$\\sqrt[3$", 1, "Missing ] in the optional argument of \\sqrt");
+        check_error("\\verb|a", 0, "\\verb is not closed");
+        check_error("\\begin{verbatim}a", 0, "\\begin{verbatim} is not closed");
+        check_error("a\\", 1, "The code must not end with \\");
+    }
+
+    {
+        // Position of the error in lines and characters.
+        ut.CompareInt(false, L2A::UTIL::CheckLatexSyntax("a\n\xc3\xa4 $b", error));
+        ut.CompareInt(5, (int)error.offset_);
+        ut.CompareInt(4, (int)error.character_offset_);
+        ut.CompareInt(2, (int)error.line_);
+        ut.CompareInt(3, (int)error.column_);
+        ut.CompareStr(ai::UnicodeString("Line 2, column 3: $ is not closed"),
+            ai::UnicodeString(L2A::UTIL::GetLatexSyntaxErrorText(error)));
+    }
+}
@@ -0,0 +1,263 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Test the links folder functions.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_links_folder.h"
+#include "testing_utlity.h"
+
+#include "l2a_file_system.h"
+#include "l2a_links_folder.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <random>
+
+
+/**
+ * \brief Check if a string starts with another one, ASCII characters are compared case insensitive.
+ */
+bool StartsWithCaselessASCII(const std::string& string, const std::string& prefix)
+{
+    if (string.size() < prefix.size()) return false;
+    for (size_t i = 0; i < prefix.size(); i++)
+        if (std::tolower((unsigned char)string[i]) != std::tolower((unsigned char)prefix[i])) return false;
+    return true;
+}
+
+/**
+ * \brief Find the unused link files with nested loops over all used files and documents.
+ */
+std::vector<size_t> GetUnusedLinkFilesNested(const std::vector<std::string>& link_file_names,
+    const std::vector<std::string>& used_file_names, const std::vector<std::string>& other_document_prefixes)
+{
+    std::vector<size_t> unused_files;
+    for (size_t i = 0; i < link_file_names.size(); i++)
+    {
+        bool delete_this_file = true;
+        for (const auto& used_file : used_file_names)
+            if (link_file_names[i] == used_file) delete_this_file = false;
+        for (const auto& prefix : other_document_prefixes)
+            if (StartsWithCaselessASCII(link_file_names[i], prefix)) delete_this_file = false;
+        if (delete_this_file) unused_files.push_back(i);
+    }
+    return unused_files;
+}
+
+/**
+ * \brief Create a synthetic listing of a links folder shared by multiple documents.
+ *
+ * For each document n_files_per_document files are created, half of them are used by the current document (the first
+ * one). Additionally, n_orphans files of deleted documents are added.
+ */
+void CreateLinksFolderListing(const size_t n_documents, const size_t n_files_per_document, const size_t n_orphans,
+    std::vector<std::string>& link_file_names, std::vector<std::string>& used_file_names,
+    std::vector<std::string>& other_document_prefixes)
+{
+    link_file_names.clear();
+    used_file_names.clear();
+    other_document_prefixes.clear();
+    for (size_t i_doc = 0; i_doc < n_documents; i_doc++)
+    {
+        const std::string prefix = "figure_" + std::to_string(i_doc) + "_LaTeX2AI_";
+        if (i_doc > 0) other_document_prefixes.push_back(prefix);
+        for (size_t i_file = 0; i_file < n_files_per_document; i_file++)
+        {
+            link_file_names.push_back(prefix + std::to_string(i_file) + ".pdf");
+            if (i_doc == 0 && i_file % 2 == 0) used_file_names.push_back(link_file_names.back());
+        }
+    }
+    for (size_t i_file = 0; i_file < n_orphans; i_file++)
+        link_file_names.push_back("deleted_figure_LaTeX2AI_" + std::to_string(i_file) + ".pdf");
+
+    // Shuffle the listing, so the order is not the same as in the used files.
+    std::mt19937 generator(1);
+    std::shuffle(link_file_names.begin(), link_file_names.end(), generator);
+}
+
+/**
+ *
+ */
+void TestLinksFolderPrefixTrie(L2A::TEST::UTIL::UnitTest& ut)
+{
+    L2A::UTIL::PrefixTrie trie;
+    ut.CompareInt(false, trie.HasPrefixOf("document_LaTeX2AI_001.pdf"));
+
+    trie.Insert("document_LaTeX2AI_");
+    trie.Insert("doc_LaTeX2AI_");
+    ut.CompareInt(true, trie.HasPrefixOf("document_LaTeX2AI_001.pdf"));
+    ut.CompareInt(true, trie.HasPrefixOf("Doc_latex2ai_001.pdf"));
+    ut.CompareInt(true, trie.HasPrefixOf("doc_LaTeX2AI_"));
+    ut.CompareInt(false, trie.HasPrefixOf("doc_LaTeX2AI"));
+    ut.CompareInt(false, trie.HasPrefixOf("docu_LaTeX2AI_001.pdf"));
+    ut.CompareInt(false, trie.HasPrefixOf(""));
+
+    // Non ASCII characters have to match exactly.
+    trie.Insert("\xc3\xa4_LaTeX2AI_");
+    ut.CompareInt(true, trie.HasPrefixOf("\xc3\xa4_LaTeX2AI_001.pdf"));
+    ut.CompareInt(false, trie.HasPrefixOf("\xc3\x84_LaTeX2AI_001.pdf"));
+}
+
+/**
+ *
+ */
+void TestLinksFolderUnusedFiles(L2A::TEST::UTIL::UnitTest& ut)
+{
+    const std::vector<std::string> link_file_names = {"a_LaTeX2AI_001.pdf", "a_LaTeX2AI_002.pdf", "B_LaTeX2AI_001.pdf",
+        "c_LaTeX2AI_001.pdf", "ab_LaTeX2AI_001.pdf"};
+    const std::vector<std::string> used_file_names = {"a_LaTeX2AI_002.pdf"};
+    const std::vector<std::string> other_document_prefixes = {"b_LaTeX2AI_", "a_LaTeX2AI_0"};
+
+    // The file of the current document that is not used anymore is kept, since it shares its name with another
+    // document.
+    std::vector<size_t> unused_files =
+        L2A::UTIL::GetUnusedLinkFiles(link_file_names, used_file_names, other_document_prefixes);
+    ut.CompareInt(2, (int)unused_files.size());
+    if (unused_files.size() == 2)
+    {
+        ut.CompareInt(3, (int)unused_files[0]);
+        ut.CompareInt(4, (int)unused_files[1]);
+    }
+
+    // Compare with the nested search for a larger listing.
+    std::vector<std::string> listing;
+    std::vector<std::string> used;
+    std::vector<std::string> prefixes;
+    CreateLinksFolderListing(10, 20, 30, listing, used, prefixes);
+    unused_files = L2A::UTIL::GetUnusedLinkFiles(listing, used, prefixes);
+    ut.CompareInt(40, (int)unused_files.size());
+    ut.CompareInt(1, unused_files == GetUnusedLinkFilesNested(listing, used, prefixes));
+}
+
+/**
+ * \brief Write a text to a file.
+ */
+void WriteLinksFolderTestFile(const std::filesystem::path& path, const std::string& text)
+{
+    std::ofstream file(path, std::ios::trunc);
+    file << text;
+}
+
+/**
+ *
+ */
+void TestLinksFolderManifest(L2A::TEST::UTIL::UnitTest& ut)
+{
+    const std::filesystem::path directory =
+        L2A::UTIL::FilePathAiToStd(L2A::UTIL::GetTemporaryDirectory()) / "links_manifest_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    const std::filesystem::path manifest_path = directory / "manifest.txt";
+    WriteLinksFolderTestFile(directory / "a.pdf", "pdf contents a");
+    WriteLinksFolderTestFile(directory / "b.pdf", "pdf contents b");
+
+    {
+        // Only files that are added to the manifest are valid.
+        L2A::UTIL::LinksManifest manifest(manifest_path);
+        ut.CompareInt(0, (int)manifest.Size());
+        ut.CompareInt(false, manifest.IsValid("a.pdf", "hash_a"));
+        manifest.Update("a.pdf", "hash_a");
+        manifest.Update("b.pdf", "hash_b");
+        manifest.Update("c.pdf", "hash_c");
+        ut.CompareInt(2, (int)manifest.Size());
+        ut.CompareInt(true, manifest.IsValid("a.pdf", "hash_a"));
+        ut.CompareInt(false, manifest.IsValid("a.pdf", "hash_b"));
+        ut.CompareInt(true, manifest.IsModified());
+        ut.CompareInt(true, manifest.Write());
+        ut.CompareInt(false, manifest.IsModified());
+        ut.CompareInt(false, std::filesystem::exists(directory / "manifest.txt.tmp"));
+    }
+
+    {
+        // Load the written manifest and change one of the files.
+        L2A::UTIL::LinksManifest manifest(manifest_path);
+        ut.CompareInt(2, (int)manifest.Size());
+        ut.CompareInt(true, manifest.IsValid("a.pdf", "hash_a"));
+        ut.CompareInt(true, manifest.IsValid("b.pdf", "hash_b"));
+        WriteLinksFolderTestFile(directory / "b.pdf", "changed pdf contents b");
+        ut.CompareInt(false, manifest.IsValid("b.pdf", "hash_b"));
+        std::filesystem::remove(directory / "a.pdf");
+        ut.CompareInt(false, manifest.IsValid("a.pdf", "hash_a"));
+        manifest.Remove("a.pdf");
+        ut.CompareInt(1, (int)manifest.Size());
+    }
+
+    {
+        // A corrupted manifest results in an empty manifest.
+        WriteLinksFolderTestFile(manifest_path, "not a manifest\nb.pdf\thash_b\t1 2\n");
+        L2A::UTIL::LinksManifest manifest(manifest_path);
+        ut.CompareInt(0, (int)manifest.Size());
+    }
+
+    std::filesystem::remove_all(directory);
+}
+
+/**
+ *
+ */
+void L2A::TEST::TestLinksFolder(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("TestLinksFolder"));
+
+    // Call the individual tests
+    TestLinksFolderPrefixTrie(ut);
+    TestLinksFolderUnusedFiles(ut);
+    TestLinksFolderManifest(ut);
+}
+
+/**
+ *
+ */
+void L2A::TEST::BenchmarkLinksFolder(L2A::TEST::UTIL::UnitTest& ut, L2A::TEST::UTIL::Benchmark& benchmark)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("BenchmarkLinksFolder"));
+
+    // Shared figures folder with 50 documents and 20k PDF files.
+    std::vector<std::string> link_file_names;
+    std::vector<std::string> used_file_names;
+    std::vector<std::string> other_document_prefixes;
+    CreateLinksFolderListing(50, 380, 1000, link_file_names, used_file_names, other_document_prefixes);
+
+    L2A::TEST::UTIL::Timer timer;
+    const auto unused_files = L2A::UTIL::GetUnusedLinkFiles(link_file_names, used_file_names, other_document_prefixes);
+    timer.Stop();
+    benchmark.AddResult(ai::UnicodeString("GetUnusedLinkFiles (50 documents, 20k files)"), 1, timer);
+
+    timer.Reset();
+    const auto unused_files_nested =
+        GetUnusedLinkFilesNested(link_file_names, used_file_names, other_document_prefixes);
+    timer.Stop();
+    benchmark.AddResult(ai::UnicodeString("Nested loop cleanup (50 documents, 20k files)"), 1, timer);
+
+    ut.CompareInt(1000 + 190, (int)unused_files.size());
+    ut.CompareInt(1, unused_files == unused_files_nested);
+}
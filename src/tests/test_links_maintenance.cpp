@@ -0,0 +1,185 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Test the background links maintenance.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_links_maintenance.h"
+#include "testing_utlity.h"
+
+#include "l2a_file_system.h"
+#include "l2a_links_folder.h"
+#include "l2a_links_maintenance.h"
+
+#include <algorithm>
+#include <fstream>
+
+
+/**
+ * \brief Write a text to a file.
+ */
+void WriteLinksMaintenanceTestFile(const std::filesystem::path& path, const std::string& text)
+{
+    std::ofstream file(path, std::ios::trunc | std::ios::binary);
+    file << text;
+}
+
+/**
+ * \brief Get the sorted names of the removed and repaired files from the results of the worker.
+ */
+void GetLinksMaintenanceTestResults(const std::vector<L2A::UTIL::LinksMaintenanceResult>& results,
+    std::vector<std::string>& removed_files, std::vector<std::string>& repair_files)
+{
+    removed_files.clear();
+    repair_files.clear();
+    for (const auto& result : results)
+    {
+        removed_files.insert(removed_files.end(), result.removed_files_.begin(), result.removed_files_.end());
+        repair_files.insert(repair_files.end(), result.repair_files_.begin(), result.repair_files_.end());
+    }
+    std::sort(removed_files.begin(), removed_files.end());
+    std::sort(repair_files.begin(), repair_files.end());
+}
+
+/**
+ *
+ */
+void L2A::TEST::TestLinksMaintenance(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("TestLinksMaintenance"));
+
+    // Create a document folder with two documents and a links folder.
+    const std::filesystem::path directory =
+        L2A::UTIL::FilePathAiToStd(L2A::UTIL::GetTemporaryDirectory()) / "links_maintenance_test";
+    const std::filesystem::path links_directory = directory / "links";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(links_directory);
+    WriteLinksMaintenanceTestFile(directory / "doc.ai", "document");
+    WriteLinksMaintenanceTestFile(directory / "other.ai", "other document");
+    WriteLinksMaintenanceTestFile(links_directory / "doc_LaTeX2AI_001.pdf", "pdf contents 001");
+    WriteLinksMaintenanceTestFile(links_directory / "doc_LaTeX2AI_002.pdf", "pdf contents 002");
+    WriteLinksMaintenanceTestFile(links_directory / "doc_LaTeX2AI_003.pdf", "pdf contents 003");
+    WriteLinksMaintenanceTestFile(links_directory / "doc_LaTeX2AI_004.pdf", "pdf contents 004");
+    WriteLinksMaintenanceTestFile(links_directory / "doc_LaTeX2AI_005.pdf", "pdf contents 005");
+    WriteLinksMaintenanceTestFile(links_directory / "other_LaTeX2AI_001.pdf", "pdf contents other");
+    WriteLinksMaintenanceTestFile(links_directory / "deleted_LaTeX2AI_001.pdf", "pdf contents deleted");
+    WriteLinksMaintenanceTestFile(links_directory / "notes.txt", "not a pdf");
+
+    // Add the files of the document to the manifest.
+    {
+        L2A::UTIL::LinksManifest manifest(links_directory / "manifest.txt");
+        manifest.Update("doc_LaTeX2AI_001.pdf", "hash_001");
+        manifest.Update("doc_LaTeX2AI_002.pdf", "hash_002");
+        manifest.Update("doc_LaTeX2AI_003.pdf", "hash_003");
+        manifest.Write();
+    }
+
+    // Change the contents of the second file without changing the size or the write time, this can not be detected
+    // by the status of the file. Delete the third file.
+    const auto write_time = std::filesystem::last_write_time(links_directory / "doc_LaTeX2AI_002.pdf");
+    WriteLinksMaintenanceTestFile(links_directory / "doc_LaTeX2AI_002.pdf", "pdf contents XXX");
+    std::filesystem::last_write_time(links_directory / "doc_LaTeX2AI_002.pdf", write_time);
+    std::filesystem::remove(links_directory / "doc_LaTeX2AI_003.pdf");
+
+    // The fifth file is newer than the job, it could be used by an item created after the job was posted.
+    L2A::UTIL::LinksMaintenanceJob job;
+    job.links_directory_ = links_directory;
+    job.document_path_ = directory / "doc.ai";
+    job.used_file_names_ = {"doc_LaTeX2AI_001.pdf", "doc_LaTeX2AI_002.pdf", "doc_LaTeX2AI_003.pdf"};
+    job.time_ = std::filesystem::file_time_type::clock::now();
+    std::filesystem::last_write_time(links_directory / "doc_LaTeX2AI_005.pdf", job.time_ + std::chrono::hours(1));
+
+    std::vector<std::string> removed_files;
+    std::vector<std::string> repair_files;
+    {
+        // Use a small budget, flushing the worker has to ignore it.
+        L2A::UTIL::LinksMaintenanceWorker worker("_LaTeX2AI_", "manifest.txt", 1, 1);
+        job.type_ = L2A::UTIL::LinksMaintenanceJob::Type::scrub;
+        worker.Post(job);
+        job.type_ = L2A::UTIL::LinksMaintenanceJob::Type::garbage_collection;
+        worker.Post(job);
+        worker.Flush();
+        ut.CompareInt(true, worker.IsIdle());
+        ut.CompareInt(true, worker.HasResults());
+
+        GetLinksMaintenanceTestResults(worker.TakeResults(), removed_files, repair_files);
+        ut.CompareInt(false, worker.HasResults());
+        ut.CompareInt(2, (int)removed_files.size());
+        if (removed_files.size() == 2)
+        {
+            ut.CompareStr(ai::UnicodeString("deleted_LaTeX2AI_001.pdf"), ai::UnicodeString(removed_files[0]));
+            ut.CompareStr(ai::UnicodeString("doc_LaTeX2AI_004.pdf"), ai::UnicodeString(removed_files[1]));
+        }
+        ut.CompareInt(2, (int)repair_files.size());
+        if (repair_files.size() == 2)
+        {
+            ut.CompareStr(ai::UnicodeString("doc_LaTeX2AI_002.pdf"), ai::UnicodeString(repair_files[0]));
+            ut.CompareStr(ai::UnicodeString("doc_LaTeX2AI_003.pdf"), ai::UnicodeString(repair_files[1]));
+        }
+        ut.CompareInt(true, std::filesystem::exists(links_directory / "doc_LaTeX2AI_001.pdf"));
+        ut.CompareInt(true, std::filesystem::exists(links_directory / "doc_LaTeX2AI_005.pdf"));
+        ut.CompareInt(true, std::filesystem::exists(links_directory / "other_LaTeX2AI_001.pdf"));
+        ut.CompareInt(true, std::filesystem::exists(links_directory / "notes.txt"));
+
+        const auto statistics = worker.GetStatistics();
+        ut.CompareInt(2, (int)statistics.n_jobs_);
+        ut.CompareInt(2, (int)statistics.n_removed_files_);
+        ut.CompareInt(3, (int)statistics.n_scrubbed_files_);
+        ut.CompareInt(2, (int)statistics.n_repair_files_);
+        ut.CompareInt(0, (int)statistics.n_unchanged_files_);
+
+        // A second scrub does not read the file that was verified by the first one.
+        job.type_ = L2A::UTIL::LinksMaintenanceJob::Type::scrub;
+        worker.Post(job);
+        worker.Flush();
+        GetLinksMaintenanceTestResults(worker.TakeResults(), removed_files, repair_files);
+        ut.CompareInt(2, (int)repair_files.size());
+        const auto statistics_unchanged = worker.GetStatistics();
+        ut.CompareInt(5, (int)statistics_unchanged.n_scrubbed_files_);
+        ut.CompareInt(1, (int)statistics_unchanged.n_unchanged_files_);
+
+        // If the verified file is changed, it is read again.
+        WriteLinksMaintenanceTestFile(links_directory / "doc_LaTeX2AI_001.pdf", "pdf contents 001 changed");
+        worker.Post(job);
+        worker.Flush();
+        GetLinksMaintenanceTestResults(worker.TakeResults(), removed_files, repair_files);
+        ut.CompareInt(3, (int)repair_files.size());
+        const auto statistics_changed = worker.GetStatistics();
+        ut.CompareInt(8, (int)statistics_changed.n_scrubbed_files_);
+        ut.CompareInt(1, (int)statistics_changed.n_unchanged_files_);
+
+        // After the worker is stopped, no more jobs are accepted.
+        worker.Stop();
+        worker.Post(job);
+        ut.CompareInt(true, worker.IsIdle());
+        ut.CompareInt(false, worker.HasResults());
+    }
+
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,121 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Test the utility math functions.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_math.h"
+#include "testing_utlity.h"
+
+#include "l2a_constants.h"
+#include "l2a_math.h"
+
+
+/**
+ *
+ */
+void TestMathAffineTransformation(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Transformation with zoom, rotation, a flipped vertical axis and translation, as it occurs in a document view.
+    const AIReal zoom = 2.5;
+    const AIReal angle = 0.3;
+    AIRealMatrix reference;
+    reference.a = zoom * cos(angle);
+    reference.b = zoom * sin(angle);
+    reference.c = zoom * sin(angle);
+    reference.d = -zoom * cos(angle);
+    reference.tx = 120.5;
+    reference.ty = -33.25;
+
+    // Reconstruct the transformation from the image of three points.
+    const AIReal reference_length = 1000.0;
+    const AIRealPoint image_origin = L2A::UTIL::MATH::TransformPoint(reference, {0.0, 0.0});
+    const AIRealPoint image_h = L2A::UTIL::MATH::TransformPoint(reference, {reference_length, 0.0});
+    const AIRealPoint image_v = L2A::UTIL::MATH::TransformPoint(reference, {0.0, reference_length});
+    const AIRealMatrix matrix =
+        L2A::UTIL::MATH::GetAffineTransformation(image_origin, image_h, image_v, reference_length);
+    ut.CompareFloat(reference.a, matrix.a, L2A::CONSTANTS::eps_pos_);
+    ut.CompareFloat(reference.b, matrix.b, L2A::CONSTANTS::eps_pos_);
+    ut.CompareFloat(reference.c, matrix.c, L2A::CONSTANTS::eps_pos_);
+    ut.CompareFloat(reference.d, matrix.d, L2A::CONSTANTS::eps_pos_);
+    ut.CompareFloat(reference.tx, matrix.tx, L2A::CONSTANTS::eps_pos_);
+    ut.CompareFloat(reference.ty, matrix.ty, L2A::CONSTANTS::eps_pos_);
+
+    // Transform a single point.
+    const AIRealPoint point = {10.0, -4.0};
+    const AIRealPoint transformed_point = L2A::UTIL::MATH::TransformPoint(matrix, point);
+    ut.CompareFloat(reference.a * point.h + reference.c * point.v + reference.tx, transformed_point.h,
+        L2A::CONSTANTS::eps_pos_);
+    ut.CompareFloat(reference.b * point.h + reference.d * point.v + reference.ty, transformed_point.v,
+        L2A::CONSTANTS::eps_pos_);
+
+    // The batched transformation has to give the same results as the transformation of the single points.
+    const size_t n_points = 37;
+    std::vector<AIReal> points_h(n_points);
+    std::vector<AIReal> points_v(n_points);
+    for (size_t i = 0; i < n_points; i++)
+    {
+        points_h[i] = -100.0 + 7.5 * i;
+        points_v[i] = 50.0 - 3.25 * i;
+    }
+    std::vector<AIReal> transformed_h(n_points);
+    std::vector<AIReal> transformed_v(n_points);
+    L2A::UTIL::MATH::TransformPoints(
+        matrix, n_points, points_h.data(), points_v.data(), transformed_h.data(), transformed_v.data());
+    for (size_t i = 0; i < n_points; i++)
+    {
+        const AIRealPoint single_point = L2A::UTIL::MATH::TransformPoint(matrix, {points_h[i], points_v[i]});
+        ut.CompareFloat(single_point.h, transformed_h[i], L2A::CONSTANTS::eps_pos_);
+        ut.CompareFloat(single_point.v, transformed_v[i], L2A::CONSTANTS::eps_pos_);
+    }
+}
+
+/**
+ *
+ */
+void TestMathRoundToInteger(L2A::TEST::UTIL::UnitTest& ut)
+{
+    ut.CompareInt(0, L2A::UTIL::MATH::RoundToInteger(0.2));
+    ut.CompareInt(1, L2A::UTIL::MATH::RoundToInteger(0.5));
+    ut.CompareInt(3, L2A::UTIL::MATH::RoundToInteger(2.7));
+    ut.CompareInt(-1, L2A::UTIL::MATH::RoundToInteger(-0.7));
+    ut.CompareInt(-2, L2A::UTIL::MATH::RoundToInteger(-2.2));
+}
+
+/**
+ *
+ */
+void L2A::TEST::TestMath(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("TestMath"));
+
+    // Call the individual tests
+    TestMathAffineTransformation(ut);
+    TestMathRoundToInteger(ut);
+}
@@ -0,0 +1,169 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+/**
+ * \brief Test the metrics registry.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_metrics.h"
+#include "testing_utlity.h"
+
+#include "l2a_metrics.h"
+
+#include <thread>
+
+
+/**
+ *
+ */
+void TestMetricsHistogram(L2A::TEST::UTIL::UnitTest& ut)
+{
+    L2A::UTIL::MetricsHistogram histogram;
+    ut.CompareFloat(0.0, histogram.GetQuantile(0.5), 1e-10);
+
+    // 1 ms to 100 ms in 1 ms steps.
+    for (size_t i = 1; i <= 100; i++) histogram.Add(1e-3 * (double)i);
+    ut.CompareInt(100, (int)histogram.count_);
+    ut.CompareFloat(1e-3, histogram.min_, 1e-10);
+    ut.CompareFloat(0.1, histogram.max_, 1e-10);
+    ut.CompareFloat(5.05, histogram.sum_, 1e-10);
+    ut.CompareInt(0, (int)histogram.buckets_[0]);
+    ut.CompareInt(1, (int)histogram.buckets_[1]);
+    ut.CompareInt(2, (int)histogram.buckets_[2]);
+    ut.CompareInt(37, (int)histogram.buckets_[7]);
+
+    // The quantiles are the upper limits of the buckets, but never larger than the maximum.
+    ut.CompareFloat(0.064, histogram.GetQuantile(0.5), 1e-10);
+    ut.CompareFloat(0.1, histogram.GetQuantile(0.95), 1e-10);
+    ut.CompareFloat(0.002, histogram.GetQuantile(0.01), 1e-10);
+
+    // Very long durations end up in the last bucket.
+    histogram.Add(1e6);
+    ut.CompareInt(1, (int)histogram.buckets_[L2A::UTIL::MetricsHistogram::n_buckets_ - 1]);
+    ut.CompareFloat(1e6, histogram.GetQuantile(1.0), 1e-10);
+}
+
+/**
+ *
+ */
+void TestMetricsRegistry(L2A::TEST::UTIL::UnitTest& ut)
+{
+    L2A::UTIL::MetricsRegistry registry(3);
+
+    // Counters and histograms are updated from multiple threads.
+    std::vector<std::thread> threads;
+    for (size_t i_thread = 0; i_thread < 4; i_thread++)
+        threads.emplace_back(
+            [&registry]()
+            {
+                for (size_t i = 0; i < 100; i++)
+                {
+                    registry.Increment("hits");
+                    registry.Observe("timer", 0.01);
+                }
+                registry.Increment("misses", 25);
+            });
+    for (auto& thread : threads) thread.join();
+
+    auto snapshot = registry.GetSnapshot();
+    ut.CompareInt(400, (int)snapshot.GetCounter("hits"));
+    ut.CompareInt(100, (int)snapshot.GetCounter("misses"));
+    ut.CompareInt(0, (int)snapshot.GetCounter("unknown"));
+    ut.CompareFloat(0.8, snapshot.GetHitRate("hits", "misses"), 1e-10);
+    ut.CompareFloat(-1.0, snapshot.GetHitRate("unknown", "unknown_misses"), 1e-10);
+    ut.CompareInt(400, (int)snapshot.histograms_["timer"].count_);
+
+    // Only the newest compilations are kept.
+    for (size_t i_compile = 1; i_compile <= 5; i_compile++)
+    {
+        L2A::UTIL::CompileRecord record;
+        record.n_items_ = i_compile;
+        registry.AddCompile(record);
+    }
+    snapshot = registry.GetSnapshot();
+    ut.CompareInt(3, (int)snapshot.compiles_.size());
+    ut.CompareInt(3, (int)snapshot.compiles_.front().n_items_);
+    ut.CompareInt(5, (int)snapshot.compiles_.back().n_items_);
+
+    registry.Clear();
+    snapshot = registry.GetSnapshot();
+    ut.CompareInt(0, (int)snapshot.counters_.size());
+    ut.CompareInt(0, (int)snapshot.histograms_.size());
+    ut.CompareInt(0, (int)snapshot.compiles_.size());
+}
+
+/**
+ *
+ */
+void TestMetricsOutput(L2A::TEST::UTIL::UnitTest& ut)
+{
+    L2A::UTIL::MetricsRegistry registry;
+    registry.Increment("header_cache_hits", 3);
+    registry.Increment("header_cache_misses");
+    registry.Observe("latex_engine", 0.5);
+    L2A::UTIL::CompileRecord record_background{true, true, 2, 2, 0.001, 0.5, 0.1, 0.7};
+    L2A::UTIL::CompileRecord record_foreground{false, false, 1, 1, 0.002, 1.5, 0.0, 1.6};
+    registry.AddCompile(record_background);
+    registry.AddCompile(record_foreground);
+    const auto snapshot = registry.GetSnapshot();
+
+    ut.CompareStr(ai::UnicodeString("Cache hit rates\n"
+                                    "  Header cache: 75.0 % (3 of 4)\n"
+                                    "Counters\n"
+                                    "  header_cache_hits: 3\n"
+                                    "  header_cache_misses: 1\n"
+                                    "Timings (count / mean / median / 95 % / max)\n"
+                                    "  latex_engine: 1 / 0.500 s / 0.500 s / 0.500 s / 0.500 s\n"
+                                    "Last compilations (newest first)\n"
+                                    "  foreground (failed), 1 items / 1 pages: write 0.002 s, LaTeX 1.500 s, "
+                                    "split 0.000 s, total 1.600 s\n"
+                                    "  background, 2 items / 2 pages: write 0.001 s, LaTeX 0.500 s, "
+                                    "split 0.100 s, total 0.700 s\n"),
+        ai::UnicodeString(L2A::UTIL::GetMetricsText(snapshot)));
+
+    const std::string json = L2A::UTIL::GetMetricsJson(snapshot);
+    ut.CompareInt(true, json.find("\"header_cache_hits\": 3") != std::string::npos);
+    ut.CompareInt(true, json.find("\"latex_engine\": {\"count\": 1, \"sum\": 0.500000") != std::string::npos);
+    ut.CompareInt(true, json.find("{\"background\": false, \"ok\": false, \"items\": 1, \"pages\": 1") !=
+                            std::string::npos);
+    ut.CompareStr(
+        ai::UnicodeString("{\n  \"counters\": {\n  },\n  \"histograms\": {\n  },\n  \"compiles\": [\n  ]\n}\n"),
+        ai::UnicodeString(L2A::UTIL::GetMetricsJson(L2A::UTIL::MetricsSnapshot())));
+}
+
+/**
+ *
+ */
+void L2A::TEST::TestMetrics(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("TestMetrics"));
+
+    // Call the individual tests
+    TestMetricsHistogram(ut);
+    TestMetricsRegistry(ut);
+    TestMetricsOutput(ut);
+}
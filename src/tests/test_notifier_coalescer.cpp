@@ -0,0 +1,90 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Test the notifier coalescer.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_notifier_coalescer.h"
+#include "testing_utlity.h"
+
+#include "l2a_notifier_coalescer.h"
+
+
+/**
+ *
+ */
+void L2A::TEST::TestNotifierCoalescer(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("TestNotifierCoalescer"));
+
+    using L2A::UTIL::NotifierEvent;
+    L2A::UTIL::NotifierCoalescer coalescer;
+    ut.CompareInt(false, coalescer.HasPending());
+
+    // A burst of selection changes is processed once.
+    for (unsigned int i = 0; i < 10; i++) coalescer.Post(NotifierEvent::selection_changed);
+    ut.CompareInt(true, coalescer.HasPending());
+    auto pending = coalescer.TakePending();
+    ut.CompareInt(true, pending.selection_changed_);
+    ut.CompareInt(false, pending.check_document_);
+    ut.CompareInt(false, coalescer.HasPending());
+    pending = coalescer.TakePending();
+    ut.CompareInt(false, pending.selection_changed_);
+
+    // Only the last active document is checked.
+    coalescer.Post(NotifierEvent::document_changed, "doc_a");
+    coalescer.Post(NotifierEvent::document_changed, "doc_b");
+    pending = coalescer.TakePending();
+    ut.CompareInt(true, pending.check_document_);
+    ut.CompareStr(ai::UnicodeString("doc_b"), ai::UnicodeString(pending.document_key_));
+
+    // Changes of the view title of the same document are also passed on, the document check itself decides if the
+    // document changed since its last check.
+    coalescer.Post(NotifierEvent::document_changed, "doc_b");
+    coalescer.Post(NotifierEvent::selection_changed);
+    pending = coalescer.TakePending();
+    ut.CompareInt(true, pending.check_document_);
+    ut.CompareStr(ai::UnicodeString("doc_b"), ai::UnicodeString(pending.document_key_));
+    ut.CompareInt(true, pending.selection_changed_);
+
+    // No active document.
+    coalescer.Post(NotifierEvent::document_changed, "");
+    ut.CompareInt(false, coalescer.TakePending().check_document_);
+
+    // Switch back to the first document.
+    coalescer.Post(NotifierEvent::document_changed, "doc_a");
+    ut.CompareInt(true, coalescer.TakePending().check_document_);
+
+    const auto& statistics = coalescer.GetStatistics();
+    ut.CompareInt(11, (int)statistics.n_received_selection_);
+    ut.CompareInt(2, (int)statistics.n_processed_selection_);
+    ut.CompareInt(5, (int)statistics.n_received_document_);
+    ut.CompareInt(3, (int)statistics.n_processed_document_);
+    ut.CompareInt(1, (int)statistics.n_skipped_document_);
+}
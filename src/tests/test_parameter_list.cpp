@@ -31,6 +31,7 @@
 
 #include "test_parameter_list.h"
 
+#include "base64.h"
 #include "testing_utlity.h"
 
 #include "l2a_parameter_list.h"
@@ -119,3 +120,53 @@ void L2A::TEST::TestParameterList(L2A::TEST::UTIL::UnitTest& ut)
     L2A::UTIL::ParameterList transformed_unicode_list(unicode_list.ToXMLString(ai::UnicodeString("root")));
     ut.CompareStr(test_string_unicode_value, transformed_unicode_list.GetStringOption(test_string_unicode_key));
 }
+
+/**
+ *
+ */
+void L2A::TEST::BenchmarkParameterList(L2A::TEST::UTIL::UnitTest& ut, L2A::TEST::UTIL::Benchmark& benchmark)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("BenchmarkParameterList"));
+
+    // Note of an item with an embedded pdf file, the encoded pdf has about 40 kB.
+    std::string pdf_contents(30000, ' ');
+    for (size_t i = 0; i < pdf_contents.size(); i++) pdf_contents[i] = (char)((i * 7919) >> 3);
+    const ai::UnicodeString pdf_encoded =
+        L2A::UTIL::StringStdToAi(base64::encode(pdf_contents.data(), pdf_contents.size()));
+
+    L2A::UTIL::ParameterList note;
+    note.SetOption(ai::UnicodeString("text_align_horizontal"), ai::UnicodeString("centreH"));
+    note.SetOption(ai::UnicodeString("text_align_vertical"), ai::UnicodeString("baseline"));
+    std::shared_ptr<L2A::UTIL::ParameterList> latex_sub_list = note.SetSubList(ai::UnicodeString("latex"));
+    latex_sub_list->SetMainOption(ai::UnicodeString("$\\int_0^1 f(x) \\, \\mathrm{d}x < \\varepsilon$"));
+    latex_sub_list->SetOption(ai::UnicodeString("cursor_position"), 12);
+    std::shared_ptr<L2A::UTIL::ParameterList> pdf_sub_list = note.SetSubList(ai::UnicodeString("pdf_file_contents"));
+    pdf_sub_list->SetMainOption(pdf_encoded);
+    pdf_sub_list->SetOption(ai::UnicodeString("hash"), L2A::UTIL::StringHash(pdf_encoded));
+    pdf_sub_list->SetOption(ai::UnicodeString("hash_method"), ai::UnicodeString("crc64"));
+    note.SetOption(ai::UnicodeString("latex2ai_version"), ai::UnicodeString("1.0.2"));
+    const ai::UnicodeString note_string = note.ToXMLString(ai::UnicodeString("LaTeX2AI_item"));
+
+    const size_t n_operations = 200;
+    size_t n_parsed = 0;
+    L2A::TEST::UTIL::Timer timer;
+    for (size_t i = 0; i < n_operations; i++)
+    {
+        L2A::UTIL::ParameterList parsed_note(note_string);
+        n_parsed += parsed_note.SubListExists(ai::UnicodeString("pdf_file_contents"));
+    }
+    timer.Stop();
+    benchmark.AddResult(ai::UnicodeString("ParameterList parse (item note, 40 kB)"), n_operations, timer);
+    ut.CompareInt((int)n_operations, (int)n_parsed);
+
+    size_t n_written = 0;
+    timer.Reset();
+    for (size_t i = 0; i < n_operations; i++)
+        n_written += note.ToXMLString(ai::UnicodeString("LaTeX2AI_item")).length() == note_string.length();
+    timer.Stop();
+    benchmark.AddResult(ai::UnicodeString("ParameterList write (item note, 40 kB)"), n_operations, timer);
+    ut.CompareInt((int)n_operations, (int)n_written);
+
+    ut.CompareInt(true, L2A::UTIL::ParameterList(note_string) == note);
+}
@@ -0,0 +1,111 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Test the plan for redoing items.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_redo_plan.h"
+#include "testing_utlity.h"
+
+#include "l2a_redo_plan.h"
+
+
+/**
+ *
+ */
+void L2A::TEST::TestRedoPlan(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("TestRedoPlan"));
+
+    using L2A::UTIL::RedoPlan;
+
+    {
+        // Empty batch.
+        const auto plan = L2A::UTIL::CreateRedoPlan({});
+        ut.CompareInt(0, (int)plan.compile_index_.size());
+        ut.CompareInt(0, (int)plan.compile_items_.size());
+        ut.CompareInt(0, (int)plan.n_skipped_);
+        ut.CompareInt(0, (int)plan.n_deduplicated_);
+    }
+
+    {
+        // Up to date items are skipped, identical items are compiled once. The same code as baseline item results in
+        // a different pdf.
+        const std::vector<L2A::UTIL::RedoPlanItem> items = {
+            {"$a$", false, false},
+            {"$b$", false, true},
+            {"$a$", false, false},
+            {"$a$", true, false},
+            {"$c$", false, false},
+            {"$a$", false, true},
+            {"$c$", false, false},
+            {"$a$", true, false},
+        };
+        const auto plan = L2A::UTIL::CreateRedoPlan(items);
+        ut.CompareInt(2, (int)plan.n_skipped_);
+        ut.CompareInt(3, (int)plan.n_deduplicated_);
+        ut.CompareInt(3, (int)plan.compile_items_.size());
+        ut.CompareInt(true, plan.compile_items_ == std::vector<size_t>{0, 3, 4});
+        const std::vector<size_t> compile_index = {0, RedoPlan::skip, 0, 1, 2, RedoPlan::skip, 2, 1};
+        ut.CompareInt(true, plan.compile_index_ == compile_index);
+        ut.CompareInt(
+            (int)items.size(), (int)(plan.n_skipped_ + plan.n_deduplicated_ + plan.compile_items_.size()));
+    }
+
+    {
+        // A batch with many copies of the same code only results in a single page.
+        std::vector<L2A::UTIL::RedoPlanItem> items(400, {"$x$", false, false});
+        items.push_back({"$y$", false, false});
+        const auto plan = L2A::UTIL::CreateRedoPlan(items);
+        ut.CompareInt(2, (int)plan.compile_items_.size());
+        ut.CompareInt(399, (int)plan.n_deduplicated_);
+        ut.CompareInt(0, (int)plan.compile_index_[399]);
+        ut.CompareInt(1, (int)plan.compile_index_[400]);
+    }
+
+    {
+        // Expected time of a plan. Skipped items do not count, a page gets the time of any of its items.
+        const std::vector<L2A::UTIL::RedoPlanItem> items = {
+            {"$a$", false, false, -1.0},
+            {"$b$", false, true, 5.0},
+            {"$a$", false, false, 0.25},
+            {"$c$", false, false, 1.5},
+            {"$d$", false, false},
+        };
+        const auto plan = L2A::UTIL::CreateRedoPlan(items);
+        const auto plan_time = L2A::UTIL::GetRedoPlanTime(items, plan);
+        ut.CompareFloat(1.75, plan_time.compile_time_, 1e-10);
+        ut.CompareInt(1, (int)plan_time.n_unknown_);
+        ut.CompareInt(3, (int)plan_time.slowest_item_);
+
+        const auto empty_time = L2A::UTIL::GetRedoPlanTime({}, L2A::UTIL::CreateRedoPlan({}));
+        ut.CompareFloat(0.0, empty_time.compile_time_, 1e-10);
+        ut.CompareInt(true, empty_time.slowest_item_ == RedoPlan::skip);
+    }
+}
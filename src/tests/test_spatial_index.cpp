@@ -0,0 +1,208 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Test the spatial index.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_spatial_index.h"
+#include "testing_utlity.h"
+
+#include "l2a_spatial_index.h"
+
+#include <random>
+
+
+/**
+ * \brief Create random item boxes, similar to labels placed on a large document.
+ */
+std::vector<AIRealRect> CreateRandomBoxes(const size_t n_boxes, const AIReal document_size, const unsigned int seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<AIReal> position(0.0, document_size);
+    std::uniform_real_distribution<AIReal> size(1.0, 40.0);
+
+    std::vector<AIRealRect> boxes;
+    boxes.reserve(n_boxes);
+    for (size_t i = 0; i < n_boxes; i++)
+    {
+        AIRealRect box;
+        box.left = position(generator);
+        box.bottom = position(generator);
+        box.right = box.left + size(generator);
+        box.top = box.bottom + 0.5 * size(generator);
+        boxes.push_back(box);
+    }
+    return boxes;
+}
+
+/**
+ * \brief Linear search for all boxes that intersect a rectangle.
+ */
+std::vector<size_t> QueryRectLinear(const std::vector<AIRealRect>& boxes, const AIRealRect& rect)
+{
+    std::vector<size_t> result;
+    for (size_t i = 0; i < boxes.size(); i++)
+    {
+        if (boxes[i].left <= rect.right && rect.left <= boxes[i].right && boxes[i].bottom <= rect.top &&
+            rect.bottom <= boxes[i].top)
+            result.push_back(i);
+    }
+    return result;
+}
+
+/**
+ * \brief Compare two index vectors.
+ */
+void CompareIndexVector(
+    L2A::TEST::UTIL::UnitTest& ut, const std::vector<size_t>& val1, const std::vector<size_t>& val2)
+{
+    ut.CompareInt((int)val1.size(), (int)val2.size());
+    if (val1.size() == val2.size())
+        for (size_t i = 0; i < val1.size(); i++) ut.CompareInt((int)val1[i], (int)val2[i]);
+}
+
+/**
+ *
+ */
+void TestSpatialIndexBoundingBox(L2A::TEST::UTIL::UnitTest& ut)
+{
+    std::vector<AIRealPoint> points = {{1.0, 2.0}, {-3.0, 5.0}, {4.0, -1.0}, {0.0, 0.0}};
+    AIRealRect bounding_box = L2A::UTIL::GetBoundingBox(points);
+    ut.CompareRect(bounding_box, {-3.0, 5.0, 4.0, -1.0});
+}
+
+/**
+ *
+ */
+void TestSpatialIndexSimple(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // The second box has flipped coordinates and the third box is degenerated to a point.
+    std::vector<AIRealRect> boxes = {{0.0, 10.0, 10.0, 0.0}, {20.0, 0.0, 30.0, 10.0}, {5.0, 5.0, 5.0, 5.0}};
+    L2A::UTIL::SpatialIndex index;
+    ut.CompareInt(1, index.IsEmpty());
+    ut.CompareInt(0, (int)index.QueryPoint({1.0, 1.0}).size());
+
+    index.Build(boxes);
+    ut.CompareInt(3, (int)index.Size());
+    CompareIndexVector(ut, {0}, index.QueryPoint({1.0, 1.0}));
+    CompareIndexVector(ut, {0, 2}, index.QueryPoint({5.0, 5.0}));
+    CompareIndexVector(ut, {1}, index.QueryPoint({25.0, 2.0}));
+    CompareIndexVector(ut, {}, index.QueryPoint({15.0, 5.0}));
+    CompareIndexVector(ut, {0, 1}, index.QueryPoint({15.0, 5.0}, 5.0));
+    CompareIndexVector(ut, {}, index.QueryPoint({-100.0, 5.0}));
+    CompareIndexVector(ut, {0, 1, 2}, index.QueryRect({-1.0, 20.0, 50.0, -1.0}));
+    CompareIndexVector(ut, {0, 2}, index.QueryRect({4.0, 4.0, 6.0, 6.0}));
+
+    index.Clear();
+    ut.CompareInt(1, index.IsEmpty());
+    CompareIndexVector(ut, {}, index.QueryPoint({1.0, 1.0}));
+}
+
+/**
+ *
+ */
+void TestSpatialIndexRandom(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Compare the results of the index with a linear search.
+    const auto boxes = CreateRandomBoxes(500, 1000.0, 1);
+    L2A::UTIL::SpatialIndex index;
+    index.Build(boxes);
+
+    const auto query_boxes = CreateRandomBoxes(50, 1000.0, 2);
+    for (const auto& query_box : query_boxes)
+    {
+        CompareIndexVector(ut, QueryRectLinear(boxes, query_box), index.QueryRect(query_box));
+        const AIRealPoint point = {query_box.left, query_box.bottom};
+        CompareIndexVector(ut, QueryRectLinear(boxes, {point.h, point.v, point.h, point.v}), index.QueryPoint(point));
+    }
+}
+
+/**
+ *
+ */
+void L2A::TEST::TestSpatialIndex(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("TestSpatialIndex"));
+
+    // Call the individual tests
+    TestSpatialIndexBoundingBox(ut);
+    TestSpatialIndexSimple(ut);
+    TestSpatialIndexRandom(ut);
+}
+
+/**
+ *
+ */
+void L2A::TEST::BenchmarkSpatialIndex(L2A::TEST::UTIL::UnitTest& ut, L2A::TEST::UTIL::Benchmark& benchmark)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("BenchmarkSpatialIndex"));
+
+    // Document with 20k items, the query points emulate cursor movements and the query rectangles emulate
+    // invalidated parts of the view.
+    const size_t n_items = 20000;
+    const size_t n_queries = 20000;
+    const auto boxes = CreateRandomBoxes(n_items, 5000.0, 3);
+    const auto query_boxes = CreateRandomBoxes(n_queries, 5000.0, 4);
+    std::vector<AIRealPoint> query_points;
+    for (const auto& query_box : query_boxes) query_points.push_back({query_box.left, query_box.bottom});
+
+    L2A::TEST::UTIL::Timer timer;
+    L2A::UTIL::SpatialIndex index;
+    index.Build(boxes);
+    timer.Stop();
+    benchmark.AddResult(ai::UnicodeString("SpatialIndex::Build (20k items)"), 1, timer);
+
+    size_t n_hits_index = 0;
+    timer.Reset();
+    for (const auto& point : query_points) n_hits_index += index.QueryPoint(point).size();
+    timer.Stop();
+    benchmark.AddResult(ai::UnicodeString("SpatialIndex::QueryPoint (20k items)"), n_queries, timer);
+
+    size_t n_hits_linear = 0;
+    timer.Reset();
+    for (const auto& point : query_points)
+        n_hits_linear += QueryRectLinear(boxes, {point.h, point.v, point.h, point.v}).size();
+    timer.Stop();
+    benchmark.AddResult(ai::UnicodeString("Linear point search (20k items)"), n_queries, timer);
+    ut.CompareInt((int)n_hits_linear, (int)n_hits_index);
+
+    n_hits_index = 0;
+    timer.Reset();
+    for (const auto& query_box : query_boxes) n_hits_index += index.QueryRect(query_box).size();
+    timer.Stop();
+    benchmark.AddResult(ai::UnicodeString("SpatialIndex::QueryRect (20k items)"), n_queries, timer);
+
+    n_hits_linear = 0;
+    timer.Reset();
+    for (const auto& query_box : query_boxes) n_hits_linear += QueryRectLinear(boxes, query_box).size();
+    timer.Stop();
+    benchmark.AddResult(ai::UnicodeString("Linear rectangle search (20k items)"), n_queries, timer);
+    ut.CompareInt((int)n_hits_linear, (int)n_hits_index);
+}
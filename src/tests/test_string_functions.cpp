@@ -161,3 +161,46 @@ void L2A::TEST::TestStringFunctions(L2A::TEST::UTIL::UnitTest& ut)
     TestReplace(ut);
     TestSplit(ut);
 }
+
+/**
+ *
+ */
+void L2A::TEST::BenchmarkStringFunctions(L2A::TEST::UTIL::UnitTest& ut, L2A::TEST::UTIL::Benchmark& benchmark)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("BenchmarkStringFunctions"));
+
+    // LaTeX code of a document with 10k items.
+    const size_t n_lines = 10000;
+    ai::UnicodeString text;
+    for (size_t i = 0; i < n_lines; i++)
+        text += ai::UnicodeString("\\LaTeXtoAI{$x_{" + std::to_string(i) + "}$}\n");
+
+    const size_t n_hash_operations = 20;
+    ai::UnicodeString hash;
+    L2A::TEST::UTIL::Timer timer;
+    for (size_t i = 0; i < n_hash_operations; i++) hash = L2A::UTIL::StringHash(text);
+    timer.Stop();
+    benchmark.AddResult(ai::UnicodeString("StringHash (10k lines)"), n_hash_operations, timer);
+    ut.CompareStr(hash, L2A::UTIL::StringHash(text));
+
+    const size_t n_operations = 5;
+    ai::UnicodeString replaced_text;
+    timer.Reset();
+    for (size_t i = 0; i < n_operations; i++)
+    {
+        replaced_text = text;
+        L2A::UTIL::StringReplaceAll(
+            replaced_text, ai::UnicodeString("\\LaTeXtoAI{"), ai::UnicodeString("\\LaTeXtoAIbase{"));
+    }
+    timer.Stop();
+    benchmark.AddResult(ai::UnicodeString("StringReplaceAll (10k lines)"), n_operations, timer);
+    ut.CompareInt((int)(text.length() + 4 * n_lines), (int)replaced_text.length());
+
+    std::vector<ai::UnicodeString> split_text;
+    timer.Reset();
+    for (size_t i = 0; i < n_operations; i++) split_text = L2A::UTIL::SplitString(text, ai::UnicodeString("\n"));
+    timer.Stop();
+    benchmark.AddResult(ai::UnicodeString("SplitString (10k lines)"), n_operations, timer);
+    ut.CompareInt((int)n_lines + 1, (int)split_text.size());
+}
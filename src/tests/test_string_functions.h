@@ -38,6 +38,7 @@ namespace L2A
         namespace UTIL
         {
             class UnitTest;
+            class Benchmark;
         }
     }  // namespace TEST
 }  // namespace L2A
@@ -51,6 +52,11 @@ namespace L2A
          * \brief Test the functionality of the string functions.
          */
         void TestStringFunctions(L2A::TEST::UTIL::UnitTest& ut);
+
+        /**
+         * \brief Benchmark the string functions on large inputs.
+         */
+        void BenchmarkStringFunctions(L2A::TEST::UTIL::UnitTest& ut, L2A::TEST::UTIL::Benchmark& benchmark);
     }  // namespace TEST
 }  // namespace L2A
 
@@ -0,0 +1,170 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Test the trace buffer.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "test_trace.h"
+#include "testing_utlity.h"
+
+#include "l2a_trace.h"
+
+#include <algorithm>
+#include <thread>
+
+
+/**
+ *
+ */
+void TestTraceBuffer(L2A::TEST::UTIL::UnitTest& ut)
+{
+    L2A::UTIL::TraceBuffer buffer(4);
+
+    // Nothing is recorded while the buffer is disabled.
+    {
+        L2A::UTIL::TraceScope trace_scope("disabled", buffer);
+    }
+    ut.CompareInt(0, (int)buffer.GetEvents().size());
+
+    // Nested scopes are recorded when they end.
+    buffer.SetEnabled(true);
+    {
+        L2A::UTIL::TraceScope trace_scope_outer("outer", buffer);
+        L2A::UTIL::TraceScope trace_scope_inner("inner", buffer);
+    }
+    auto events = buffer.GetEvents();
+    ut.CompareInt(2, (int)events.size());
+    ut.CompareStr(ai::UnicodeString("inner"), ai::UnicodeString(events[0].name_));
+    ut.CompareStr(ai::UnicodeString("outer"), ai::UnicodeString(events[1].name_));
+    ut.CompareInt(true, events[1].start_ <= events[0].start_);
+    ut.CompareInt(true, events[1].start_ + events[1].duration_ >= events[0].start_ + events[0].duration_);
+    ut.CompareInt(true, events[0].thread_id_ == L2A::UTIL::GetTraceThreadId());
+
+    // Only the newest events are kept.
+    const char* names[] = {"a", "b", "c", "d", "e"};
+    for (const char* name : names) buffer.Record(name, 10, 20);
+    events = buffer.GetEvents();
+    ut.CompareInt(4, (int)events.size());
+    ut.CompareStr(ai::UnicodeString("b"), ai::UnicodeString(events[0].name_));
+    ut.CompareStr(ai::UnicodeString("e"), ai::UnicodeString(events[3].name_));
+    ut.CompareInt(10, (int)events[3].duration_);
+
+    buffer.Clear();
+    ut.CompareInt(0, (int)buffer.GetEvents().size());
+    buffer.Record("f", 20, 10);
+    ut.CompareInt(1, (int)buffer.GetEvents().size());
+    ut.CompareInt(0, (int)buffer.GetEvents()[0].duration_);
+}
+
+/**
+ *
+ */
+void TestTraceThreads(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Spans are recorded from multiple threads at the same time, while the buffer is read.
+    L2A::UTIL::TraceBuffer buffer(1024);
+    buffer.SetEnabled(true);
+    const size_t n_threads = 4;
+    const size_t n_spans = 200;
+    std::vector<std::thread> threads;
+    for (size_t i_thread = 0; i_thread < n_threads; i_thread++)
+        threads.emplace_back(
+            [&buffer]()
+            {
+                for (size_t i_span = 0; i_span < n_spans; i_span++) L2A::UTIL::TraceScope trace_scope("span", buffer);
+            });
+    size_t n_read = 0;
+    for (size_t i_read = 0; i_read < 10; i_read++) n_read += buffer.GetEvents().size() <= buffer.Capacity();
+    for (auto& thread : threads) thread.join();
+    ut.CompareInt(10, (int)n_read);
+
+    const auto events = buffer.GetEvents();
+    ut.CompareInt((int)(n_threads * n_spans), (int)events.size());
+    std::vector<std::uint32_t> thread_ids;
+    for (const auto& event : events)
+        if (std::find(thread_ids.begin(), thread_ids.end(), event.thread_id_) == thread_ids.end())
+            thread_ids.push_back(event.thread_id_);
+    ut.CompareInt((int)n_threads, (int)thread_ids.size());
+}
+
+/**
+ *
+ */
+void TestTraceChromeFormat(L2A::TEST::UTIL::UnitTest& ut)
+{
+    ut.CompareStr(ai::UnicodeString("{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n]}\n"),
+        ai::UnicodeString(L2A::UTIL::GetChromeTrace({})));
+
+    const std::vector<L2A::UTIL::TraceEvent> events = {{"Write\"Files\"", 1500, 2000, 1}, {"Split", 4000, 10, 2}};
+    ut.CompareStr(ai::UnicodeString("{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n"
+                                    "{\"name\": \"Write\\\"Files\\\"\", \"cat\": \"LaTeX2AI\", \"ph\": \"X\", "
+                                    "\"ts\": 1.500, \"dur\": 2.000, \"pid\": 1, \"tid\": 1},\n"
+                                    "{\"name\": \"Split\", \"cat\": \"LaTeX2AI\", \"ph\": \"X\", "
+                                    "\"ts\": 4.000, \"dur\": 0.010, \"pid\": 1, \"tid\": 2}\n"
+                                    "]}\n"),
+        ai::UnicodeString(L2A::UTIL::GetChromeTrace(events)));
+}
+
+/**
+ *
+ */
+void L2A::TEST::TestTrace(L2A::TEST::UTIL::UnitTest& ut)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("TestTrace"));
+
+    // Call the individual tests
+    TestTraceBuffer(ut);
+    TestTraceThreads(ut);
+    TestTraceChromeFormat(ut);
+}
+
+/**
+ *
+ */
+void L2A::TEST::BenchmarkTrace(L2A::TEST::UTIL::UnitTest& ut, L2A::TEST::UTIL::Benchmark& benchmark)
+{
+    // Set test name.
+    ut.SetTestName(ai::UnicodeString("BenchmarkTrace"));
+
+    const size_t n_spans = 1000000;
+    L2A::UTIL::TraceBuffer buffer(1 << 14);
+
+    L2A::TEST::UTIL::Timer timer;
+    for (size_t i_span = 0; i_span < n_spans; i_span++) L2A::UTIL::TraceScope trace_scope("span", buffer);
+    timer.Stop();
+    benchmark.AddResult(ai::UnicodeString("TraceScope (disabled)"), n_spans, timer);
+    ut.CompareInt(0, (int)buffer.GetEvents().size());
+
+    buffer.SetEnabled(true);
+    timer.Reset();
+    for (size_t i_span = 0; i_span < n_spans; i_span++) L2A::UTIL::TraceScope trace_scope("span", buffer);
+    timer.Stop();
+    benchmark.AddResult(ai::UnicodeString("TraceScope (enabled)"), n_spans, timer);
+    ut.CompareInt((int)buffer.Capacity(), (int)buffer.GetEvents().size());
+}
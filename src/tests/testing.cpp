@@ -31,15 +31,35 @@
 
 #include "testing.h"
 
+#include "test_background_compile.h"
 #include "test_base64.h"
+#include "test_compile_core.h"
+#include "test_document_model.h"
+#include "test_document_fingerprint.h"
+#include "test_document_footprint.h"
+#include "test_encoded_file_writer.h"
 #include "test_file_system.h"
 #include "test_framework.h"
+#include "test_geometry.h"
+#include "test_header_resolver.h"
+#include "test_invalidation.h"
 #include "test_latex.h"
+#include "test_latex_syntax.h"
+#include "test_links_folder.h"
+#include "test_links_maintenance.h"
+#include "test_math.h"
+#include "test_metrics.h"
+#include "test_notifier_coalescer.h"
 #include "test_parameter_list.h"
+#include "test_redo_plan.h"
+#include "test_spatial_index.h"
 #include "test_string_functions.h"
+#include "test_trace.h"
 #include "test_utlity.h"
 #include "testing_utlity.h"
 
+#include "l2a_file_system.h"
+
 
 /**
  *
@@ -57,6 +77,24 @@ void L2A::TEST::TestingMain(const bool print_status)
     L2A::TEST::TestVersion(ut);
     L2A::TEST::TestBase64(ut);
     L2A::TEST::TestLatex(ut);
+    L2A::TEST::TestMath(ut);
+    L2A::TEST::TestGeometry(ut);
+    L2A::TEST::TestInvalidation(ut);
+    L2A::TEST::TestSpatialIndex(ut);
+    L2A::TEST::TestNotifierCoalescer(ut);
+    L2A::TEST::TestLinksFolder(ut);
+    L2A::TEST::TestDocumentFingerprint(ut);
+    L2A::TEST::TestLinksMaintenance(ut);
+    L2A::TEST::TestEncodedFileWriter(ut);
+    L2A::TEST::TestRedoPlan(ut);
+    L2A::TEST::TestHeaderResolver(ut);
+    L2A::TEST::TestBackgroundCompile(ut);
+    L2A::TEST::TestCompileCore(ut);
+    L2A::TEST::TestDocumentModel(ut);
+    L2A::TEST::TestTrace(ut);
+    L2A::TEST::TestMetrics(ut);
+    L2A::TEST::TestDocumentFootprint(ut);
+    L2A::TEST::TestLatexSyntax(ut);
 
     // Print the testing summary. For now this is deactivated.
     ut.PrintTestSummary(print_status);
@@ -76,3 +114,33 @@ void L2A::TEST::TestFramework(const bool print_status)
     // Print the testing summary. For now this is deactivated.
     ut.PrintTestSummary(print_status);
 }
+
+/**
+ *
+ */
+void L2A::TEST::BenchmarkMain(const bool print_status)
+{
+    // Create the testing and benchmark objects.
+    L2A::TEST::UTIL::UnitTest ut;
+    L2A::TEST::UTIL::Benchmark benchmark;
+
+    // Call the individual benchmarks.
+    L2A::TEST::BenchmarkSpatialIndex(ut, benchmark);
+    L2A::TEST::BenchmarkLinksFolder(ut, benchmark);
+    L2A::TEST::BenchmarkEncodedFileWriter(ut, benchmark);
+    L2A::TEST::BenchmarkParameterList(ut, benchmark);
+    L2A::TEST::BenchmarkBase64(ut, benchmark);
+    L2A::TEST::BenchmarkStringFunctions(ut, benchmark);
+    L2A::TEST::BenchmarkHeaderResolver(ut, benchmark);
+    L2A::TEST::BenchmarkFileSystem(ut, benchmark);
+    L2A::TEST::BenchmarkTrace(ut, benchmark);
+
+    // Write the results, so they can be compared between versions.
+    ai::FilePath result_file = L2A::UTIL::GetTemporaryDirectory();
+    result_file.AddComponent(ai::UnicodeString("LaTeX2AI_benchmark.json"));
+    benchmark.WriteJSON(L2A::UTIL::FilePathAiToStd(result_file));
+
+    // Print the testing and benchmark summary.
+    ut.PrintTestSummary(print_status);
+    benchmark.PrintBenchmarkSummary(print_status);
+}
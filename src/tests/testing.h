@@ -43,6 +43,11 @@ namespace L2A
          * \brief Test the functionality of the complete LaTeX2AI toolbox.
          */
         void TestFramework(const bool print_status = true);
+
+        /**
+         * \brief Run the benchmarks of performance critical parts of LaTeX2AI.
+         */
+        void BenchmarkMain(const bool print_status = true);
     }  // namespace TEST
 }  // namespace L2A
 
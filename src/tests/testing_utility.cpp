@@ -34,6 +34,13 @@
 #include "l2a_constants.h"
 #include "l2a_string_functions.h"
 
+#include "json.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
 
 /**
  *
@@ -186,3 +193,120 @@ void L2A::TEST::UTIL::UnitTest::PrintTestSummary(const bool print_status)
         sAIUser->MessageAlert(summary_string);
     }
 }
+
+/**
+ *
+ */
+void L2A::TEST::UTIL::Benchmark::AddResult(const ai::UnicodeString& name, const size_t n_operations, const Timer& timer)
+{
+    results_.push_back({name, n_operations, timer.Elapsed(), timer.Allocations()});
+}
+
+/**
+ *
+ */
+void L2A::TEST::UTIL::Benchmark::PrintBenchmarkSummary(const bool print_status) const
+{
+    if (print_status)
+    {
+        ai::UnicodeString summary_string("");
+        summary_string += "Benchmark results\n";
+        for (const auto& result : results_)
+        {
+            summary_string += "\n";
+            summary_string += result.name_;
+            summary_string += ": ";
+            summary_string += ai::UnicodeString(std::to_string(result.time_ * 1000.0));
+            summary_string += " ms for ";
+            summary_string += L2A::UTIL::IntegerToString((unsigned int)result.n_operations_);
+            summary_string += " operations";
+            if (IsAllocationCountEnabled())
+            {
+                summary_string += ", ";
+                summary_string += ai::UnicodeString(
+                    std::to_string((double)result.n_allocations_ / (double)std::max(result.n_operations_, size_t(1))));
+                summary_string += " allocations per operation";
+            }
+        }
+        sAIUser->MessageAlert(summary_string);
+    }
+}
+
+/**
+ *
+ */
+void L2A::TEST::UTIL::Benchmark::WriteJSON(const std::filesystem::path& path) const
+{
+    using json = nlohmann::json;
+
+    json results = json::array();
+    for (const auto& result : results_)
+    {
+        const double n_operations = (double)std::max(result.n_operations_, size_t(1));
+        json result_json = {{"name", L2A::UTIL::StringAiToStd(result.name_)}, {"n_operations", result.n_operations_},
+            {"time", result.time_}, {"time_per_operation", result.time_ / n_operations},
+            {"operations_per_second", result.time_ > 0.0 ? n_operations / result.time_ : 0.0}};
+        if (IsAllocationCountEnabled())
+            result_json["allocations_per_operation"] = (double)result.n_allocations_ / n_operations;
+        else
+            result_json["allocations_per_operation"] = nullptr;
+        results.push_back(result_json);
+    }
+
+    const json benchmark_json = {
+        {"version", L2A_VERSION_STRING_}, {"git_sha", L2A_VERSION_GIT_SHA_HEAD_}, {"results", results}};
+    std::ofstream file(path, std::ios::trunc);
+    file << benchmark_json.dump(4);
+}
+
+#ifdef _DEBUG
+//! Number of allocations with operator new in each thread. They are only counted in debug builds, where the
+//! benchmarks are run. The counter is per thread, so the allocations of the background workers of the plugin do not
+//! show up in the benchmarks.
+thread_local size_t l2a_allocation_count = 0;
+
+/**
+ * \brief Replace the global allocation functions to count the allocations.
+ */
+void* operator new(std::size_t size)
+{
+    l2a_allocation_count++;
+    void* pointer = std::malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+#endif
+
+/**
+ *
+ */
+size_t L2A::TEST::UTIL::GetAllocationCount()
+{
+#ifdef _DEBUG
+    return l2a_allocation_count;
+#else
+    return 0;
+#endif
+}
+
+/**
+ *
+ */
+bool L2A::TEST::UTIL::IsAllocationCountEnabled()
+{
+#ifdef _DEBUG
+    return true;
+#else
+    return false;
+#endif
+}
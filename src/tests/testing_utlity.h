@@ -32,6 +32,9 @@
 
 #include "IllustratorSDK.h"
 
+#include <chrono>
+#include <filesystem>
+
 
 namespace L2A
 {
@@ -127,6 +130,130 @@ namespace L2A
                 //! Number of passed tests.
                 unsigned int test_count_passed_;
             };
+
+            /**
+             * \brief Get the number of memory allocations with operator new of the calling thread since it was started.
+             * Allocations of other threads, e.g., the background workers of the plugin or threads started by the
+             * benchmark itself, are not included. The allocations are only counted in debug builds, see
+             * IsAllocationCountEnabled.
+             */
+            size_t GetAllocationCount();
+
+            /**
+             * \brief Return true if the memory allocations are counted.
+             */
+            bool IsAllocationCountEnabled();
+
+            /**
+             * \brief Simple wall clock timer for benchmarks, it also counts the memory allocations.
+             */
+            class Timer
+            {
+               public:
+                /**
+                 * \brief Constructor, starts the timer.
+                 */
+                Timer() { Reset(); };
+
+                /**
+                 * \brief Restart the timer.
+                 */
+                void Reset()
+                {
+                    is_stopped_ = false;
+                    start_allocations_ = GetAllocationCount();
+                    start_ = std::chrono::steady_clock::now();
+                }
+
+                /**
+                 * \brief Stop the timer, the elapsed time and allocations are kept until the next reset.
+                 */
+                void Stop()
+                {
+                    stop_ = std::chrono::steady_clock::now();
+                    stop_allocations_ = GetAllocationCount();
+                    is_stopped_ = true;
+                }
+
+                /**
+                 * \brief Get the elapsed time in seconds since the last reset.
+                 */
+                double Elapsed() const
+                {
+                    const auto end = is_stopped_ ? stop_ : std::chrono::steady_clock::now();
+                    return std::chrono::duration<double>(end - start_).count();
+                }
+
+                /**
+                 * \brief Get the number of memory allocations since the last reset.
+                 */
+                size_t Allocations() const
+                {
+                    return (is_stopped_ ? stop_allocations_ : GetAllocationCount()) - start_allocations_;
+                }
+
+               private:
+                //! Start and stop point of the time measurement.
+                std::chrono::steady_clock::time_point start_;
+                std::chrono::steady_clock::time_point stop_;
+
+                //! Allocation count at the start and stop of the measurement.
+                size_t start_allocations_;
+                size_t stop_allocations_;
+
+                //! Flag if the timer is stopped.
+                bool is_stopped_;
+            };
+
+            /**
+             * \brief A class that collects the results of benchmarks.
+             */
+            class Benchmark
+            {
+               public:
+                /**
+                 * \brief Container for a single benchmark result.
+                 */
+                struct Result
+                {
+                    //! Name of the benchmark.
+                    ai::UnicodeString name_;
+
+                    //! Number of operations performed in the benchmark.
+                    size_t n_operations_;
+
+                    //! Total time for all operations in seconds.
+                    double time_;
+
+                    //! Number of memory allocations for all operations.
+                    size_t n_allocations_;
+                };
+
+                /**
+                 * \brief Add the result of a benchmark. The timer should be stopped, so the allocations for the
+                 * arguments of this call are not counted.
+                 */
+                void AddResult(const ai::UnicodeString& name, const size_t n_operations, const Timer& timer);
+
+                /**
+                 * \brief Get all results.
+                 */
+                const std::vector<Result>& GetResults() const { return results_; }
+
+                /**
+                 * \brief Print summary of the benchmarks.
+                 */
+                void PrintBenchmarkSummary(const bool print_status) const;
+
+                /**
+                 * \brief Write the results to a JSON file, so the results of different versions can be compared.
+                 */
+                void WriteJSON(const std::filesystem::path& path) const;
+
+               private:
+                //! Results of all benchmarks.
+                std::vector<Result> results_;
+            };
         }  // namespace UTIL
     }  // namespace TEST
 }  // namespace L2A
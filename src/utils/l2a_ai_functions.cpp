@@ -39,10 +39,12 @@
 #include "l2a_file_system.h"
 #include "l2a_global.h"
 #include "l2a_item.h"
+#include "l2a_math.h"
 #include "l2a_names.h"
 #include "l2a_property.h"
 #include "l2a_string_functions.h"
 #include "l2a_suites.h"
+#include "l2a_trace.h"
 #include "l2a_utils.h"
 
 
@@ -51,6 +53,8 @@
  */
 AIArtHandle L2A::AI::CreatePlacedItem(const ai::FilePath& pdf_path)
 {
+    L2A::UTIL::TraceScope trace_scope("CreatePlacedItem");
+
     ASErr error = kNoErr;
 
     // Create the placed item with the place request function.
@@ -134,6 +138,8 @@ void L2A::AI::SetPlacedItemPath(AIArtHandle& placed_item, const ai::FilePath& pa
  */
 void L2A::AI::RelinkPlacedItem(AIArtHandle& placed_item, const ai::FilePath& path)
 {
+    L2A::UTIL::TraceScope trace_scope("RelinkPlacedItem");
+
     AIErr error;
 
     // Request for creating a placed item.
@@ -385,16 +391,60 @@ void L2A::AI::GetItems(std::vector<AIArtHandle>& items, SelectionState selected,
  */
 void L2A::AI::GetDocumentItems(std::vector<AIArtHandle>& l2a_items, SelectionState selected)
 {
-    // Clear the input vector.
-    l2a_items.clear();
+    const std::array<L2A::UTIL::ArtSelection, 3> art_selections = {
+        L2A::UTIL::ArtSelection::all, L2A::UTIL::ArtSelection::selected, L2A::UTIL::ArtSelection::deselected};
+    L2A::UTIL::GetDocumentItems(
+        Document(), l2a_items, art_selections.at(selected), std::string(L2A::NAMES::ai_item_name_));
+}
+
+/**
+ *
+ */
+void L2A::AI::Document::GetPlacedArt(std::vector<AIArtHandle>& items, const L2A::UTIL::ArtSelection selection) const
+{
+    const std::array<SelectionState, 3> selection_states = {
+        SelectionState::all, SelectionState::selected, SelectionState::deselected};
+    GetItems(items, selection_states.at((size_t)selection), kPlacedArt);
+}
+
+/**
+ *
+ */
+std::string L2A::AI::Document::GetName(const AIArtHandle& item) const
+{
+    return L2A::UTIL::StringAiToStd(L2A::AI::GetName(item));
+}
+
+/**
+ *
+ */
+std::string L2A::AI::Document::GetNote(const AIArtHandle& item) const
+{
+    return L2A::UTIL::StringAiToStd(L2A::AI::GetNote(item));
+}
 
-    // Get the art items in the document.
-    std::vector<AIArtHandle> art_items;
-    GetItems(art_items, selected, kPlacedArt);
+/**
+ *
+ */
+std::filesystem::path L2A::AI::Document::GetPlacedItemPath(const AIArtHandle& item) const
+{
+    return L2A::UTIL::FilePathAiToStd(L2A::AI::GetPlacedItemPath(item));
+}
 
-    // Loop over placed art items and check if they are LaTeX2AI items
-    for (const auto& item : art_items)
-        if (IsL2AItem(item)) l2a_items.push_back(item);
+/**
+ *
+ */
+L2A::UTIL::GeometrySnapshot L2A::AI::Document::GetGeometry(const AIArtHandle& item) const
+{
+    return L2A::UTIL::GeometrySnapshot(GetPlacedMatrix(item), GetArtBounds(item), GetPlacedBoundingBox(item));
+}
+
+/**
+ *
+ */
+void L2A::AI::Document::GetIsHiddenLocked(const AIArtHandle& item, bool& is_hidden, bool& is_locked) const
+{
+    L2A::AI::GetIsHiddenLocked(item, is_hidden, is_locked);
 }
 
 /**
@@ -475,6 +525,11 @@ unsigned int L2A::AI::GetDocumentCount()
     return (unsigned int)n;
 }
 
+/**
+ *
+ */
+size_t L2A::AI::GetGlobalArtTimeStamp() { return (size_t)sAIArt->GetGlobalTimeStamp(); }
+
 /**
  *
  */
@@ -514,6 +569,63 @@ AIRect L2A::AI::ArtworkBoundsToViewBounds(const AIRealRect& artwork_bounds)
     return view_bounds;
 }
 
+/**
+ *
+ */
+AIRealRect L2A::AI::ViewBoundsToArtworkBounds(const AIRect& view_bounds)
+{
+    ASErr result = kNoErr;
+
+    AIPoint tlView, brView;
+    tlView.h = view_bounds.left;
+    tlView.v = view_bounds.top;
+    brView.h = view_bounds.right;
+    brView.v = view_bounds.bottom;
+
+    // Convert view coordinates to artwork coordinates.
+    AIRealPoint tlArt, brArt;
+    result = sAIDocumentView->ViewPointToArtworkPoint(nullptr, &tlView, &tlArt);
+    l2a_check_ai_error(result);
+    result = sAIDocumentView->ViewPointToArtworkPoint(nullptr, &brView, &brArt);
+    l2a_check_ai_error(result);
+
+    AIRealRect artwork_bounds;
+    artwork_bounds.left = tlArt.h;
+    artwork_bounds.top = tlArt.v;
+    artwork_bounds.right = brArt.h;
+    artwork_bounds.bottom = brArt.v;
+    return artwork_bounds;
+}
+
+/**
+ *
+ */
+AIReal L2A::AI::GetDocumentViewZoom()
+{
+    AIReal zoom;
+    AIErr error = sAIDocumentView->GetDocumentViewZoom(nullptr, &zoom);
+    l2a_check_ai_error(error);
+    return zoom;
+}
+
+/**
+ *
+ */
+AIRealMatrix L2A::AI::GetArtworkToViewTransformation()
+{
+    // The transformation from artwork to view coordinates is affine (zoom, rotation and translation of the view), so
+    // it can be reconstructed from the images of three points.
+    const AIReal reference_length = 1000.0;
+    const std::array<AIRealPoint, 3> artwork_points = {{{0.0, 0.0}, {reference_length, 0.0}, {0.0, reference_length}}};
+    std::array<AIRealPoint, 3> view_points;
+    for (unsigned int i = 0; i < 3; i++)
+    {
+        AIErr error = sAIDocumentView->FixedArtworkPointToViewPoint(nullptr, &artwork_points[i], &view_points[i]);
+        l2a_check_ai_error(error);
+    }
+    return L2A::UTIL::MATH::GetAffineTransformation(view_points[0], view_points[1], view_points[2], reference_length);
+}
+
 
 /**
  *
@@ -542,7 +654,8 @@ void L2A::AI::SaveToPDF()
             bool is_hidden;
             bool is_locked;
             L2A::Item item_temp(placed_item);
-            if (item_temp.IsStretched() || item_temp.IsDiamond())
+            const auto geometry = item_temp.GetGeometry();
+            if (geometry.IsStretched() || geometry.IsDiamond())
             {
                 L2A::AI::GetIsHiddenLocked(placed_item, is_hidden, is_locked);
 
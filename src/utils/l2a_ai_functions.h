@@ -33,6 +33,8 @@
 
 #include "IllustratorSDK.h"
 
+#include "l2a_document_model.h"
+
 // Forward declarations.
 namespace L2A
 {
@@ -178,6 +180,21 @@ namespace L2A
          */
         void GetDocumentItems(std::vector<AIArtHandle>& l2a_items, SelectionState selected);
 
+        /**
+         * \brief Document model of the current Illustrator document, the data is read with the functions in this
+         * file.
+         */
+        class Document : public L2A::UTIL::DocumentModel
+        {
+           public:
+            void GetPlacedArt(std::vector<AIArtHandle>& items, const L2A::UTIL::ArtSelection selection) const override;
+            std::string GetName(const AIArtHandle& item) const override;
+            std::string GetNote(const AIArtHandle& item) const override;
+            std::filesystem::path GetPlacedItemPath(const AIArtHandle& item) const override;
+            L2A::UTIL::GeometrySnapshot GetGeometry(const AIArtHandle& item) const override;
+            void GetIsHiddenLocked(const AIArtHandle& item, bool& is_hidden, bool& is_locked) const override;
+        };
+
         /**
          * \brief Get the art item that is in single isolation mode.
          * @return False if no single art item is in isolation mode.
@@ -214,6 +231,11 @@ namespace L2A
          */
         unsigned int GetDocumentCount();
 
+        /**
+         * \brief Get the global art time stamp, it is incremented by Illustrator whenever art is changed.
+         */
+        size_t GetGlobalArtTimeStamp();
+
         /**
          * \brief Convert a point in the document to a point on the screen.
          * @param artwork_point Point in the document.
@@ -228,6 +250,24 @@ namespace L2A
          */
         AIRect ArtworkBoundsToViewBounds(const AIRealRect& artwork_bounds);
 
+        /**
+         * \brief Converts an AIRect in view coordinates to an AIRealRect in artwork coordinates.
+         * @param view_bounds IN the rectangle bounds in view coordinates.
+         * @return the rectangle bounds in artwork coordinates.
+         */
+        AIRealRect ViewBoundsToArtworkBounds(const AIRect& view_bounds);
+
+        /**
+         * \brief Get the zoom factor of the current document view.
+         */
+        AIReal GetDocumentViewZoom();
+
+        /**
+         * \brief Get the affine transformation from artwork coordinates to (non rounded) view coordinates of the
+         * current document view.
+         */
+        AIRealMatrix GetArtworkToViewTransformation();
+
         /**
          * \brief Save a copy of the active document to a pdf.
          */
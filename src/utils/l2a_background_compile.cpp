@@ -0,0 +1,268 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Background worker to compile LaTeX items, e.g., after the header changed.
+ */
+
+
+#include "l2a_background_compile.h"
+
+#include "l2a_compile_core.h"
+#include "l2a_trace.h"
+
+#include <chrono>
+#include <fstream>
+
+
+/**
+ * \brief Write a text file for the background compilation.
+ */
+bool WriteBackgroundCompileFile(const std::filesystem::path& path, const std::string& text)
+{
+    std::ofstream file(path, std::ios::trunc);
+    file << text;
+    return file.good();
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::CompileBackgroundJob(const BackgroundCompileJob& job, const CompileCommandFunction& run_command,
+    BackgroundCompileResult& result, const std::function<bool()>& is_stopped)
+{
+    L2A::UTIL::TraceScope trace_scope("BackgroundCompile");
+
+    CompileRecord& record = result.compile_record_;
+    record.is_background_ = true;
+    record.n_items_ = job.pages_.size();
+    record.n_pages_ = job.pages_.size();
+    const auto start_time = std::chrono::steady_clock::now();
+    auto get_elapsed_time = [&start_time]()
+    { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count(); };
+
+    // Create the files in an empty directory.
+    std::filesystem::remove_all(job.directory_);
+    std::filesystem::create_directories(job.directory_);
+    if (!WriteBackgroundCompileFile(job.directory_ / std::filesystem::u8path(job.header_name_), job.header_text_))
+        return false;
+    for (const auto& package : job.local_packages_)
+    {
+        const std::filesystem::path package_path = job.directory_ / package.relative_path_;
+        std::filesystem::create_directories(package_path.parent_path());
+        if (!WriteBackgroundCompileFile(package_path, package.text_)) return false;
+    }
+    const std::filesystem::path tex_path = job.directory_ / std::filesystem::u8path(job.tex_name_);
+    if (!WriteBackgroundCompileFile(tex_path, job.tex_text_)) return false;
+    record.write_time_ = get_elapsed_time();
+
+    // Compile the document. The exit code is not checked, the pdf file is the relevant output.
+    if (is_stopped && is_stopped()) return false;
+    run_command(job.latex_command_, job.directory_);
+    record.latex_time_ = get_elapsed_time() - record.write_time_;
+    std::filesystem::path pdf_path = tex_path;
+    pdf_path.replace_extension(".pdf");
+    if (!std::filesystem::is_regular_file(pdf_path)) return false;
+
+    // Split the document into the pages.
+    if (is_stopped && is_stopped()) return false;
+    if (run_command(job.split_command_, job.directory_) != 0) return false;
+    record.split_time_ = get_elapsed_time() - record.write_time_ - record.latex_time_;
+    const std::string page_base_name = tex_path.stem().u8string() + "_";
+    std::filesystem::path log_path = tex_path;
+    const std::vector<double> page_times = ReadLatexPageTimes(log_path.replace_extension(".log"));
+    for (size_t i_page = 0; i_page < job.pages_.size(); i_page++)
+    {
+        const std::filesystem::path page_path =
+            job.directory_ / std::filesystem::u8path(page_base_name + std::to_string(i_page + 1) + ".pdf");
+        if (!std::filesystem::is_regular_file(page_path)) return false;
+        const std::pair<std::string, bool> key = {job.pages_[i_page].latex_code_, job.pages_[i_page].is_baseline_};
+        result.page_files_[key] = page_path;
+        if (i_page < page_times.size() && page_times[i_page] >= 0.0) result.page_times_[key] = page_times[i_page];
+    }
+    record.total_time_ = get_elapsed_time();
+    return true;
+}
+
+/**
+ *
+ */
+L2A::UTIL::BackgroundCompileWorker::BackgroundCompileWorker(const CommandFunction& run_command)
+    : run_command_(run_command ? run_command
+                               : [this](const std::string& command, const std::filesystem::path& working_directory)
+                               { return process_.Run(command, working_directory); }),
+      n_posted_jobs_(0), is_running_job_(false), stop_(false)
+{
+}
+
+/**
+ *
+ */
+void L2A::UTIL::BackgroundCompileWorker::Post(const BackgroundCompileJob& job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_) return;
+
+        // Only the latest job is relevant, the previous result is also outdated.
+        if (job_ != nullptr) statistics_.n_superseded_jobs_++;
+        job_ = std::make_unique<BackgroundCompileJob>(job);
+        result_.reset();
+        n_posted_jobs_++;
+
+        if (!thread_.joinable()) thread_ = std::thread(&BackgroundCompileWorker::Run, this);
+    }
+    condition_.notify_all();
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::BackgroundCompileWorker::IsIdle() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return job_ == nullptr && !is_running_job_;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::BackgroundCompileWorker::HasResult() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return result_ != nullptr;
+}
+
+/**
+ *
+ */
+std::unique_ptr<L2A::UTIL::BackgroundCompileResult> L2A::UTIL::BackgroundCompileWorker::TakeResult()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::move(result_);
+}
+
+/**
+ *
+ */
+void L2A::UTIL::BackgroundCompileWorker::Flush()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this] { return stop_ || (job_ == nullptr && !is_running_job_); });
+}
+
+/**
+ *
+ */
+void L2A::UTIL::BackgroundCompileWorker::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        job_.reset();
+    }
+    condition_.notify_all();
+
+    // Kill the running command, otherwise joining the thread would wait until it is finished.
+    process_.Stop();
+    if (thread_.joinable()) thread_.join();
+}
+
+/**
+ *
+ */
+L2A::UTIL::BackgroundCompileStatistics L2A::UTIL::BackgroundCompileWorker::GetStatistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return statistics_;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::BackgroundCompileWorker::Run()
+{
+    while (true)
+    {
+        std::unique_ptr<BackgroundCompileJob> job;
+        size_t job_number;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this] { return stop_ || job_ != nullptr; });
+            if (stop_) return;
+            job = std::move(job_);
+            job_number = n_posted_jobs_;
+            is_running_job_ = true;
+        }
+
+        auto result = std::make_unique<BackgroundCompileResult>();
+        result->document_path_ = job->document_path_;
+        result->compile_digest_ = job->compile_digest_;
+        MetricsTimer compile_timer("background_compile");
+        try
+        {
+            result->is_ok_ = CompileBackgroundJob(*job, run_command_, *result, [this] { return IsStopped(); });
+        }
+        catch (const std::exception&)
+        {
+            result->is_ok_ = false;
+        }
+
+        // The timings are also added for jobs that are superseded, since they used the same resources.
+        result->compile_record_.is_ok_ = result->is_ok_;
+        result->compile_record_.total_time_ = compile_timer.Stop();
+        GetMetrics().AddCompile(result->compile_record_);
+        GetMetrics().Increment(result->is_ok_ ? "background_compiles" : "failed_background_compiles");
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            is_running_job_ = false;
+            if (stop_) return;
+            if (job_number != n_posted_jobs_)
+            {
+                // A new job was posted while this one was running.
+                statistics_.n_superseded_jobs_++;
+            }
+            else
+            {
+                statistics_.n_jobs_++;
+                if (result->is_ok_)
+                    statistics_.n_pages_ += job->pages_.size();
+                else
+                    statistics_.n_failed_jobs_++;
+                result_ = std::move(result);
+            }
+        }
+        condition_.notify_all();
+    }
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::BackgroundCompileWorker::IsStopped() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stop_;
+}
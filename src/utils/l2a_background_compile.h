@@ -0,0 +1,274 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Background worker to compile LaTeX items, e.g., after the header changed.
+ */
+
+#ifndef UTIL_BACKGROUND_COMPILE_H_
+#define UTIL_BACKGROUND_COMPILE_H_
+
+
+#include "l2a_background_process.h"
+#include "l2a_header_resolver.h"
+#include "l2a_metrics.h"
+#include "l2a_redo_plan.h"
+
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Job for the background compile worker. All commands and texts are prepared on the main thread, so the
+         * worker does not need Illustrator.
+         */
+        struct BackgroundCompileJob
+        {
+            //! Directory where the document is compiled. It is cleared before the compilation.
+            std::filesystem::path directory_;
+
+            //! Path to the Illustrator document the items belong to.
+            std::filesystem::path document_path_;
+
+            //! Compile digest of the header and options used for this job.
+            std::string compile_digest_;
+
+            //! Name and text of the resolved header.
+            std::string header_name_;
+            std::string header_text_;
+
+            //! Local packages of the header.
+            std::vector<LocalPackage> local_packages_;
+
+            //! Name and text of the LaTeX document.
+            std::string tex_name_;
+            std::string tex_text_;
+
+            //! Command to compile the LaTeX document.
+            std::string latex_command_;
+
+            //! Command to split the compiled pdf file into single pages named "<tex name>_<page>.pdf".
+            std::string split_command_;
+
+            //! Code of the items on each page of the document.
+            std::vector<RedoPlanItem> pages_;
+        };
+
+        /**
+         * \brief Result of a background compilation. The pages are staged until they are used to redo the items.
+         */
+        struct BackgroundCompileResult
+        {
+            //! Path to the Illustrator document the items belong to.
+            std::filesystem::path document_path_;
+
+            //! Compile digest the pages were created with.
+            std::string compile_digest_;
+
+            //! Flag if the compilation was successful.
+            bool is_ok_ = false;
+
+            //! Pdf file for each item code, the key is the LaTeX code and the baseline flag.
+            std::map<std::pair<std::string, bool>, std::filesystem::path> page_files_;
+
+            //! Time in seconds the LaTeX engine spent on the page of each item code, if it is written to the log.
+            std::map<std::pair<std::string, bool>, double> page_times_;
+
+            //! Timings of the stages of the compilation.
+            CompileRecord compile_record_;
+
+            /**
+             * \brief Get the staged pdf file for an item, or nullptr if the item is not staged.
+             */
+            const std::filesystem::path* FindPage(const RedoPlanItem& item) const
+            {
+                const auto it = page_files_.find({item.latex_code_, item.is_baseline_});
+                return it == page_files_.end() ? nullptr : &it->second;
+            }
+
+            /**
+             * \brief Get the compile time of the staged page for an item, or a negative value if it is not known.
+             */
+            double GetPageTime(const RedoPlanItem& item) const
+            {
+                const auto it = page_times_.find({item.latex_code_, item.is_baseline_});
+                return it == page_times_.end() ? -1.0 : it->second;
+            }
+        };
+
+        /**
+         * \brief Statistics of the background compile worker.
+         */
+        struct BackgroundCompileStatistics
+        {
+            //! Number of finished jobs.
+            size_t n_jobs_ = 0;
+
+            //! Number of jobs that failed.
+            size_t n_failed_jobs_ = 0;
+
+            //! Number of jobs that were replaced by a newer job before their result was available.
+            size_t n_superseded_jobs_ = 0;
+
+            //! Number of compiled pages.
+            size_t n_pages_ = 0;
+        };
+
+        //! Function to run a command in a working directory, returns the exit code.
+        using CompileCommandFunction =
+            std::function<int(const std::string& command, const std::filesystem::path& working_directory)>;
+
+        /**
+         * \brief Compile the document of a job and split it into the pages.
+         * @param run_command Function to run the external commands.
+         * @param is_stopped Optional function that is checked before each command, the compilation is aborted if it
+         * returns true.
+         * @return False if the compilation failed or was aborted.
+         */
+        bool CompileBackgroundJob(const BackgroundCompileJob& job, const CompileCommandFunction& run_command,
+            BackgroundCompileResult& result, const std::function<bool()>& is_stopped = nullptr);
+
+        /**
+         * \brief Worker that compiles LaTeX documents in a background thread.
+         *
+         * Only the latest job is relevant, a queued job is replaced by a new one and the result of a running job is
+         * discarded if a new job was posted in the meantime. By default the external commands are run with a low
+         * priority in a BackgroundProcess, that is killed when the worker is stopped. A different function to run the
+         * commands can be given to the worker.
+         */
+        class BackgroundCompileWorker
+        {
+           public:
+            //! Function to run a command in a working directory, returns the exit code.
+            using CommandFunction = CompileCommandFunction;
+
+            /**
+             * \brief Constructor.
+             * @param run_command Function to run the external commands. If it is empty, the commands are run in the
+             * background process of the worker.
+             */
+            BackgroundCompileWorker(const CommandFunction& run_command = nullptr);
+
+            /**
+             * \brief Destructor, stops the worker.
+             */
+            ~BackgroundCompileWorker() { Stop(); }
+
+            /**
+             * \brief Add a job, it replaces all previous jobs.
+             */
+            void Post(const BackgroundCompileJob& job);
+
+            /**
+             * \brief Return true if there is no queued job and no job is running.
+             */
+            bool IsIdle() const;
+
+            /**
+             * \brief Return true if there is a result that was not taken yet.
+             */
+            bool HasResult() const;
+
+            /**
+             * \brief Get the result of the last finished job.
+             */
+            std::unique_ptr<BackgroundCompileResult> TakeResult();
+
+            /**
+             * \brief Wait until the queued job is finished.
+             */
+            void Flush();
+
+            /**
+             * \brief Stop the worker. A queued job is dropped and a running command of the background process is
+             * killed. With a command function given to the worker, a running job is stopped after the current command.
+             */
+            void Stop();
+
+            /**
+             * \brief Get the statistics of the worker.
+             */
+            BackgroundCompileStatistics GetStatistics() const;
+
+           private:
+            /**
+             * \brief Main loop of the worker thread.
+             */
+            void Run();
+
+            /**
+             * \brief Check if the worker has to stop.
+             */
+            bool IsStopped() const;
+
+           private:
+            //! Process to run the external commands if no function is given to the worker.
+            BackgroundProcess process_;
+
+            //! Function to run the external commands.
+            const CommandFunction run_command_;
+
+            //! Mutex for all members below.
+            mutable std::mutex mutex_;
+
+            //! Condition to wake up the worker thread and the threads waiting for the worker.
+            std::condition_variable condition_;
+
+            //! Queued job.
+            std::unique_ptr<BackgroundCompileJob> job_;
+
+            //! Result of the last finished job.
+            std::unique_ptr<BackgroundCompileResult> result_;
+
+            //! Number of posted jobs, used to detect if the running job was replaced.
+            size_t n_posted_jobs_;
+
+            //! Flag if a job is running.
+            bool is_running_job_;
+
+            //! Flag if the worker has to stop.
+            bool stop_;
+
+            //! Statistics of the worker.
+            BackgroundCompileStatistics statistics_;
+
+            //! Worker thread, it is started with the first job.
+            std::thread thread_;
+        };
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
@@ -0,0 +1,169 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Process to run external commands from background threads, that can be killed from another thread.
+ */
+
+
+#include "l2a_background_process.h"
+
+#ifdef WIN_ENV
+#include <windows.h>
+#else
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+
+/**
+ *
+ */
+L2A::UTIL::BackgroundProcess::BackgroundProcess() : stop_(false)
+{
+#ifdef WIN_ENV
+    // Manual reset, so the event stays set for all following commands.
+    stop_event_ = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+#else
+    pid_ = 0;
+#endif
+}
+
+/**
+ *
+ */
+L2A::UTIL::BackgroundProcess::~BackgroundProcess()
+{
+#ifdef WIN_ENV
+    if (stop_event_ != nullptr) CloseHandle(stop_event_);
+#endif
+}
+
+/**
+ *
+ */
+int L2A::UTIL::BackgroundProcess::Run(const std::string& command, const std::filesystem::path& working_directory)
+{
+#ifdef WIN_ENV
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_ || stop_event_ == nullptr) return -1;
+    }
+
+    // Convert the UTF-8 command to platform text.
+    const int n_chars = MultiByteToWideChar(CP_UTF8, 0, command.c_str(), -1, nullptr, 0);
+    if (n_chars <= 0) return -1;
+    std::wstring command_wstr(n_chars, L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, command.c_str(), -1, &command_wstr[0], n_chars);
+    const std::wstring working_directory_wstr = working_directory.wstring();
+
+    // The working directory is given to the process, since the working directory of Illustrator is used by the main
+    // thread.
+    PROCESS_INFORMATION processInformation = {0};
+    STARTUPINFOW startupInfo = {0};
+    startupInfo.cb = sizeof(startupInfo);
+    const BOOL result = CreateProcessW(nullptr, &command_wstr[0], nullptr, nullptr, FALSE,
+        BELOW_NORMAL_PRIORITY_CLASS | CREATE_NO_WINDOW, nullptr, working_directory_wstr.c_str(), &startupInfo,
+        &processInformation);
+    if (!result) return -1;
+
+    // Wait for the process or the stop event, whichever comes first.
+    const HANDLE handles[2] = {processInformation.hProcess, stop_event_};
+    int exit_code = -1;
+    if (WaitForMultipleObjects(2, handles, FALSE, INFINITE) == WAIT_OBJECT_0)
+    {
+        DWORD process_exit_code;
+        if (GetExitCodeProcess(processInformation.hProcess, &process_exit_code)) exit_code = (int)process_exit_code;
+    }
+    else
+    {
+        TerminateProcess(processInformation.hProcess, 1);
+        WaitForSingleObject(processInformation.hProcess, INFINITE);
+    }
+    CloseHandle(processInformation.hProcess);
+    CloseHandle(processInformation.hThread);
+    return exit_code;
+#else
+    // Everything the child process needs is prepared before the fork, in the child only async-signal-safe functions
+    // are called.
+    const std::string working_directory_string = working_directory.u8string();
+
+    pid_t pid;
+    {
+        // The process is created while the mutex is locked, so Stop either prevents the start or sees the process id.
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_) return -1;
+        pid = fork();
+        if (pid == 0)
+        {
+            setpgid(0, 0);
+            if (chdir(working_directory_string.c_str()) != 0) _exit(127);
+            setpriority(PRIO_PROCESS, 0, 10);
+            const int null_file = open("/dev/null", O_WRONLY);
+            if (null_file >= 0)
+            {
+                dup2(null_file, STDOUT_FILENO);
+                dup2(null_file, STDERR_FILENO);
+            }
+            execl("/bin/sh", "sh", "-c", command.c_str(), static_cast<char*>(nullptr));
+            _exit(127);
+        }
+        if (pid < 0) return -1;
+
+        // Also set the process group here, so it exists when Stop is called before the child set it.
+        setpgid(pid, pid);
+        pid_ = pid;
+    }
+
+    int status = 0;
+    pid_t wait_result;
+    do
+    {
+        wait_result = waitpid(pid, &status, 0);
+    } while (wait_result == -1 && errno == EINTR);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    pid_ = 0;
+    if (wait_result == -1 || !WIFEXITED(status)) return -1;
+    return WEXITSTATUS(status);
+#endif
+}
+
+/**
+ *
+ */
+void L2A::UTIL::BackgroundProcess::Stop()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+#ifdef WIN_ENV
+    if (stop_event_ != nullptr) SetEvent(stop_event_);
+#else
+    if (pid_ > 0) kill(-pid_, SIGKILL);
+#endif
+}
@@ -0,0 +1,102 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Process to run external commands from background threads, that can be killed from another thread.
+ */
+
+#ifndef UTIL_BACKGROUND_PROCESS_H_
+#define UTIL_BACKGROUND_PROCESS_H_
+
+
+#include <filesystem>
+#include <mutex>
+#include <string>
+
+#ifndef WIN_ENV
+#include <sys/types.h>
+#endif
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Run external commands with a low priority and without output.
+         *
+         * The functions do not use the Illustrator API and can be called from background threads. The running command
+         * can be killed from another thread, e.g., when the plugin is shut down. On Windows the process is created
+         * directly, otherwise the command is run by /bin/sh in a forked process with its own process group, so the
+         * programs started by the shell are also killed.
+         */
+        class BackgroundProcess
+        {
+           public:
+            /**
+             * \brief Constructor.
+             */
+            BackgroundProcess();
+
+            /**
+             * \brief Destructor.
+             */
+            ~BackgroundProcess();
+
+            /**
+             * \brief Copying is not allowed, the process handles belong to this object.
+             */
+            BackgroundProcess(const BackgroundProcess&) = delete;
+            BackgroundProcess& operator=(const BackgroundProcess&) = delete;
+
+            /**
+             * \brief Run a command in a working directory and wait until it is finished. Return the exit code, or -1
+             * if the process could not be created or was killed.
+             */
+            int Run(const std::string& command, const std::filesystem::path& working_directory);
+
+            /**
+             * \brief Kill the running command. Commands that are run afterwards are not started.
+             */
+            void Stop();
+
+           private:
+            //! Mutex for all members below.
+            std::mutex mutex_;
+
+            //! Flag if the process was stopped.
+            bool stop_;
+
+#ifdef WIN_ENV
+            //! Event that is set when the process is stopped, the running command waits for it.
+            void* stop_event_;
+#else
+            //! Id of the running process, it is also the id of its process group. Zero if no command is running.
+            pid_t pid_;
+#endif
+        };
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
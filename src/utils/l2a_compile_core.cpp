@@ -0,0 +1,350 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Functions to create and compile the LaTeX document of items, that do not depend on Illustrator.
+ */
+
+
+#include "l2a_compile_core.h"
+
+#include "auto_generated/tex.h"
+
+#include "l2a_trace.h"
+
+#include "tinyxml2.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#define CRCPP_USE_CPP11
+#define CRCPP_INCLUDE_ESOTERIC_CRC_DEFINITIONS
+#include "CRC.h"
+
+
+/**
+ * \brief Replace all occurrences of a placeholder in a string.
+ */
+void ReplaceCompileCorePlaceholder(std::string& string, const std::string& placeholder, const std::string& value)
+{
+    size_t position = string.find(placeholder);
+    while (position != std::string::npos)
+    {
+        string.replace(position, placeholder.size(), value);
+        position = string.find(placeholder, position + value.size());
+    }
+}
+
+/**
+ *
+ */
+std::string L2A::UTIL::GetStringHash(const std::string& string)
+{
+    L2A::UTIL::TraceScope trace_scope("StringHash");
+
+    std::uint64_t crc = CRC::Calculate(string.c_str(), string.size(), CRC::CRC_64());
+    std::stringstream buffer;
+    buffer << std::hex << crc;
+    return buffer.str();
+}
+
+/**
+ *
+ */
+std::string L2A::UTIL::GetLatexPagesCode(const std::vector<RedoPlanItem>& items, const std::vector<size_t>& page_items)
+{
+    std::string pages_code = "\n\n";
+    for (const auto& i_item : page_items)
+    {
+        if (items[i_item].is_baseline_)
+            pages_code += "\\LaTeXtoAIbase{";
+        else
+            pages_code += "\\LaTeXtoAI{";
+        pages_code += items[i_item].latex_code_;
+        pages_code += "}\n\n";
+    }
+    return pages_code;
+}
+
+/**
+ *
+ */
+std::string L2A::UTIL::GetLatexDocumentText(const std::string& pages_code, const std::string& header_name)
+{
+    // The header name is replaced first, so placeholders in the code of the items are not touched.
+    std::string text = L2A_LATEX_ITEM_;
+    ReplaceCompileCorePlaceholder(text, "{tex_header_name}", header_name);
+    ReplaceCompileCorePlaceholder(text, "{latex_code}", pages_code);
+    return text;
+}
+
+/**
+ *
+ */
+std::string L2A::UTIL::GetLatexEngineCommand(
+    const std::filesystem::path& latex_bin_path, const std::string& latex_engine)
+{
+    // In the case there is an empty bin directory, so we simply run the latex engine command name
+    if (latex_bin_path.empty()) return latex_engine;
+
+#ifdef WIN_ENV
+    const std::filesystem::path exe_path = latex_bin_path / std::filesystem::u8path(latex_engine + ".exe");
+#else
+    const std::filesystem::path exe_path = latex_bin_path / std::filesystem::u8path(latex_engine);
+#endif
+    return "\"" + exe_path.u8string() + "\"";
+}
+
+/**
+ *
+ */
+std::string L2A::UTIL::GetLatexCompileCommand(const std::filesystem::path& latex_bin_path,
+    const std::string& latex_engine, const std::string& latex_command_options, const std::filesystem::path& tex_file)
+{
+    // Add the options and the name of the tex file
+    std::string command = GetLatexEngineCommand(latex_bin_path, latex_engine);
+    command += " " + latex_command_options + " \"" + tex_file.u8string() + "\"";
+    return command;
+}
+
+/**
+ *
+ */
+std::string L2A::UTIL::GetSplitPdfPagesCommand(const std::filesystem::path& pdf_file, const std::string& gs_command)
+{
+    return "\"" + gs_command + "\" -sDEVICE=pdfwrite -o " + pdf_file.stem().u8string() + "_%d.pdf " +
+           pdf_file.filename().u8string();
+}
+
+/**
+ *
+ */
+std::vector<double> L2A::UTIL::ReadLatexPageTimes(const std::string& log_text)
+{
+    static const std::string prefix = "LaTeX2AI page time: ";
+
+    std::vector<double> page_times;
+    size_t position = log_text.find(prefix);
+    while (position != std::string::npos)
+    {
+        // Only lines that start with the prefix are written by the template.
+        if (position == 0 || log_text[position - 1] == '\n' || log_text[position - 1] == '\r')
+        {
+            char* page_end = nullptr;
+            char* ticks_end = nullptr;
+            const char* page_start = log_text.c_str() + position + prefix.size();
+            const unsigned long page = std::strtoul(page_start, &page_end, 10);
+            const long long ticks = *page_end == ' ' ? std::strtoll(page_end + 1, &ticks_end, 10) : -1;
+            if (page > 0 && ticks_end != page_end + 1 && ticks >= 0)
+            {
+                if (page > page_times.size()) page_times.resize(page, -1.0);
+                page_times[page - 1] = (double)ticks / 65536.0;
+            }
+        }
+        position = log_text.find(prefix, position + prefix.size());
+    }
+    return page_times;
+}
+
+/**
+ *
+ */
+std::vector<double> L2A::UTIL::ReadLatexPageTimes(const std::filesystem::path& log_file)
+{
+    std::ifstream file(log_file, std::ios::binary);
+    if (!file.is_open()) return {};
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return ReadLatexPageTimes(buffer.str());
+}
+
+/**
+ * \brief Read the LaTeX code, the baseline flag and the last compile time of an item from the parsed XML data.
+ */
+static bool ReadItemXMLElement(const tinyxml2::XMLDocument& xml_doc, L2A::UTIL::RedoPlanItem& item)
+{
+    const tinyxml2::XMLElement* xml_root = xml_doc.RootElement();
+    if (xml_root == nullptr || std::string(xml_root->Name()) != "LaTeX2AI_item") return false;
+    const tinyxml2::XMLElement* xml_latex = xml_root->FirstChildElement("latex");
+    if (xml_latex == nullptr) return false;
+
+    // Items with an empty code do not have a text in the latex element.
+    const char* latex_code = xml_latex->GetText();
+    item.latex_code_ = latex_code == nullptr ? "" : latex_code;
+    const char* text_align_vertical = xml_root->Attribute("text_align_vertical");
+    item.is_baseline_ = text_align_vertical != nullptr && std::string(text_align_vertical) == "baseline";
+    item.is_up_to_date_ = false;
+    const int compile_time_us = xml_latex->IntAttribute("compile_time_us", -1);
+    item.compile_time_ = compile_time_us < 0 ? -1.0 : compile_time_us * 1e-6;
+    return true;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::ReadItemXML(const std::string& xml_string, RedoPlanItem& item)
+{
+    tinyxml2::XMLDocument xml_doc;
+    if (xml_doc.Parse(xml_string.c_str()) != tinyxml2::XML_SUCCESS) return false;
+    return ReadItemXMLElement(xml_doc, item);
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::ReadItemRedoPlanItem(
+    const std::string& xml_string, const std::string& compile_digest, RedoPlanItem& item)
+{
+    // The encoded pdf file is by far the largest part of the data. It is cut out before the XML is parsed, the
+    // attributes of the element are kept.
+    static const std::string pdf_start_tag = "<pdf_file_contents";
+    static const std::string pdf_end_tag = "</pdf_file_contents>";
+    std::string xml_without_pdf;
+    const std::string* xml_parse = &xml_string;
+    bool has_pdf_text = false;
+    const size_t pdf_start = xml_string.find(pdf_start_tag);
+    const size_t pdf_text_start = pdf_start == std::string::npos ? pdf_start : xml_string.find('>', pdf_start);
+    if (pdf_text_start != std::string::npos && xml_string[pdf_text_start - 1] != '/')
+    {
+        const size_t pdf_text_end = xml_string.find(pdf_end_tag, pdf_text_start);
+        if (pdf_text_end != std::string::npos)
+        {
+            has_pdf_text = pdf_text_end > pdf_text_start + 1;
+            xml_without_pdf.reserve(xml_string.size() - (pdf_text_end - pdf_text_start - 1));
+            xml_without_pdf.append(xml_string, 0, pdf_text_start + 1);
+            xml_without_pdf.append(xml_string, pdf_text_end, std::string::npos);
+            xml_parse = &xml_without_pdf;
+        }
+    }
+
+    tinyxml2::XMLDocument xml_doc;
+    if (xml_doc.Parse(xml_parse->c_str()) != tinyxml2::XML_SUCCESS || !ReadItemXMLElement(xml_doc, item)) return false;
+
+    // Only items with a pdf file that were compiled with the given digest are up to date. As for the property of an
+    // item, an empty pdf element does not count as pdf file.
+    const char* item_compile_digest = xml_doc.RootElement()->FirstChildElement("latex")->Attribute("compile_digest");
+    const tinyxml2::XMLElement* xml_pdf = xml_doc.RootElement()->FirstChildElement("pdf_file_contents");
+    const char* pdf_hash = xml_pdf == nullptr ? nullptr : xml_pdf->Attribute("hash");
+    const bool has_pdf = xml_pdf != nullptr && (has_pdf_text || (pdf_hash != nullptr && pdf_hash[0] != '\0'));
+    item.is_up_to_date_ = !compile_digest.empty() && item_compile_digest != nullptr &&
+                          compile_digest == item_compile_digest && has_pdf;
+    return true;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::ReadItemPDFFileHash(const std::string& xml_string, std::string& hash)
+{
+    tinyxml2::XMLDocument xml_doc;
+    if (xml_doc.Parse(xml_string.c_str()) != tinyxml2::XML_SUCCESS) return false;
+
+    const tinyxml2::XMLElement* xml_root = xml_doc.RootElement();
+    if (xml_root == nullptr || std::string(xml_root->Name()) != "LaTeX2AI_item") return false;
+    const tinyxml2::XMLElement* xml_pdf = xml_root->FirstChildElement("pdf_file_contents");
+    if (xml_pdf == nullptr || xml_pdf->Attribute("hash") == nullptr) return false;
+
+    hash = xml_pdf->Attribute("hash");
+    return true;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::ReadItemPDFFile(
+    const std::string& xml_string, std::string& encoded_contents, std::string& hash, bool& is_legacy_hash)
+{
+    tinyxml2::XMLDocument xml_doc;
+    if (xml_doc.Parse(xml_string.c_str()) != tinyxml2::XML_SUCCESS) return false;
+
+    const tinyxml2::XMLElement* xml_root = xml_doc.RootElement();
+    if (xml_root == nullptr || std::string(xml_root->Name()) != "LaTeX2AI_item") return false;
+
+    encoded_contents.clear();
+    hash.clear();
+    is_legacy_hash = false;
+    const tinyxml2::XMLElement* xml_pdf = xml_root->FirstChildElement("pdf_file_contents");
+    if (xml_pdf == nullptr || xml_pdf->GetText() == nullptr) return true;
+
+    // The hash method was added after the hash, items without it are from older versions of LaTeX2AI.
+    encoded_contents = xml_pdf->GetText();
+    const char* hash_attribute = xml_pdf->Attribute("hash");
+    const char* hash_method = xml_pdf->Attribute("hash_method");
+    is_legacy_hash = hash_attribute == nullptr || hash_method == nullptr || std::string(hash_method) != "crc64";
+    hash = is_legacy_hash ? GetStringHash(encoded_contents) : hash_attribute;
+    return true;
+}
+
+/**
+ *
+ */
+std::vector<std::string> L2A::UTIL::FindItemXML(const std::string& text)
+{
+    static const std::string start_tag = "<LaTeX2AI_item";
+    static const std::string end_tag = "</LaTeX2AI_item>";
+
+    std::vector<std::string> items;
+    size_t start = text.find(start_tag);
+    while (start != std::string::npos)
+    {
+        // The start tag has to be followed by an attribute or the end of the tag, otherwise this is a different
+        // element with the same prefix.
+        const size_t tag_end = start + start_tag.size();
+        if (tag_end < text.size() && (text[tag_end] == ' ' || text[tag_end] == '>' || text[tag_end] == '/'))
+        {
+            const size_t element_end = text.find(end_tag, tag_end);
+            if (element_end == std::string::npos) break;
+            items.push_back(text.substr(start, element_end + end_tag.size() - start));
+            start = element_end + end_tag.size();
+        }
+        else
+            start = tag_end;
+        start = text.find(start_tag, start);
+    }
+    return items;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::IsCompressedIllustratorData(const std::string& text)
+{
+    // The markers are preceded by "%AI" and the version of Illustrator that introduced the compression.
+    for (const std::string marker : {"_CompressedData", "_ZStandard_Data"})
+    {
+        size_t position = text.find(marker);
+        while (position != std::string::npos)
+        {
+            size_t version_start = position;
+            while (version_start > 0 && std::isdigit(static_cast<unsigned char>(text[version_start - 1])))
+                version_start--;
+            if (version_start < position && version_start >= 3 && text.compare(version_start - 3, 3, "%AI") == 0)
+                return true;
+            position = text.find(marker, position + 1);
+        }
+    }
+    return false;
+}
@@ -0,0 +1,141 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Functions to create and compile the LaTeX document of items, that do not depend on Illustrator.
+ *
+ * This file and the other SDK-free utilities (redo plan, header resolver and background compile) form the portable
+ * core that is also used by the l2a-compile command line tool.
+ */
+
+#ifndef UTIL_COMPILE_CORE_H_
+#define UTIL_COMPILE_CORE_H_
+
+
+#include "l2a_redo_plan.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Get the CRC64 hash of a string as hex number.
+         */
+        std::string GetStringHash(const std::string& string);
+
+        /**
+         * \brief Get the LaTeX code for a document with one page for each of the given items.
+         */
+        std::string GetLatexPagesCode(const std::vector<RedoPlanItem>& items, const std::vector<size_t>& page_items);
+
+        /**
+         * \brief Get the text of the LaTeX document for the given pages code.
+         * @param header_name Name of the header file that is included in the document.
+         */
+        std::string GetLatexDocumentText(const std::string& pages_code, const std::string& header_name);
+
+        /**
+         * \brief Get the command to call a LaTeX engine, without any arguments.
+         * @param latex_bin_path Directory with the LaTeX binaries. If this is empty, the engine is called by its name.
+         */
+        std::string GetLatexEngineCommand(const std::filesystem::path& latex_bin_path, const std::string& latex_engine);
+
+        /**
+         * \brief Get the command to compile a tex file.
+         * @param latex_bin_path Directory with the LaTeX binaries. If this is empty, the engine is called by its name.
+         */
+        std::string GetLatexCompileCommand(const std::filesystem::path& latex_bin_path,
+            const std::string& latex_engine, const std::string& latex_command_options,
+            const std::filesystem::path& tex_file);
+
+        /**
+         * \brief Get the command to split a pdf file into the pages "<pdf name>_<page>.pdf". The command has to be
+         * called in the directory of the pdf file.
+         */
+        std::string GetSplitPdfPagesCommand(const std::filesystem::path& pdf_file, const std::string& gs_command);
+
+        /**
+         * \brief Read the time the LaTeX engine spent on each page from the log of a compiled document. The times are
+         * written by the item template in units of 1/65536 seconds.
+         * @return Time in seconds for each page, pages without a time in the log get a negative value.
+         */
+        std::vector<double> ReadLatexPageTimes(const std::string& log_text);
+
+        /**
+         * \brief Read the time the LaTeX engine spent on each page from a log file. If the file can not be read, an
+         * empty vector is returned.
+         */
+        std::vector<double> ReadLatexPageTimes(const std::filesystem::path& log_file);
+
+        /**
+         * \brief Read the LaTeX code, the baseline flag and the last compile time of an item from its XML data, i.e.,
+         * the "LaTeX2AI_item" element stored with each item.
+         * @return False if the XML could not be parsed or does not contain the LaTeX code.
+         */
+        bool ReadItemXML(const std::string& xml_string, RedoPlanItem& item);
+
+        /**
+         * \brief Read the data of an item needed for the redo plan from its XML data. The encoded pdf file is not
+         * parsed, so this is also fast for items with large pdf files.
+         * @param compile_digest Digest of the current header and options. The item is up to date if it contains pdf
+         * contents that were compiled with this digest. An empty digest means that no item is up to date.
+         * @return False if the XML could not be parsed or does not contain the LaTeX code.
+         */
+        bool ReadItemRedoPlanItem(const std::string& xml_string, const std::string& compile_digest, RedoPlanItem& item);
+
+        /**
+         * \brief Read the hash of the pdf contents stored in the XML data of an item.
+         * @return False if the XML could not be parsed or the item does not contain pdf contents.
+         */
+        bool ReadItemPDFFileHash(const std::string& xml_string, std::string& hash);
+
+        /**
+         * \brief Read the encoded pdf file stored in the XML data of an item and its hash. If the item does not contain
+         * a pdf file, the encoded contents are empty.
+         * @param is_legacy_hash True if the hash was not created with the current hash method. The hash is calculated
+         * again in this case, as it is done by the plugin.
+         * @return False if the XML could not be parsed or is not the data of an item.
+         */
+        bool ReadItemPDFFile(
+            const std::string& xml_string, std::string& encoded_contents, std::string& hash, bool& is_legacy_hash);
+
+        /**
+         * \brief Find the XML data of the items in the contents of a file, e.g., an uncompressed Illustrator file.
+         */
+        std::vector<std::string> FindItemXML(const std::string& text);
+
+        /**
+         * \brief Check if the contents of an Illustrator file contain compressed private data, e.g.,
+         * "%AI12_CompressedData" or "%AI24_ZStandard_Data". The XML data of the items can not be found in such files.
+         */
+        bool IsCompressedIllustratorData(const std::string& text);
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
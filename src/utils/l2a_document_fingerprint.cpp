@@ -0,0 +1,68 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Fingerprints of documents to skip checks of documents that did not change.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_document_fingerprint.h"
+
+#include "l2a_metrics.h"
+
+
+/**
+ *
+ */
+std::int64_t L2A::UTIL::GetLastWriteTime(const std::filesystem::path& path)
+{
+    std::error_code error_code;
+    const auto write_time = std::filesystem::last_write_time(path, error_code);
+    if (error_code) return 0;
+    return (std::int64_t)write_time.time_since_epoch().count();
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::DocumentCheckMemo::SkipCheck(const DocumentFingerprint& fingerprint)
+{
+    const auto it = fingerprints_.find(fingerprint.document_key_);
+    if (it == fingerprints_.end() || !(it->second == fingerprint)) return false;
+    statistics_.n_skipped_++;
+    GetMetrics().Increment("document_check_skipped");
+    return true;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::DocumentCheckMemo::SetChecked(const DocumentFingerprint& fingerprint)
+{
+    statistics_.n_performed_++;
+    GetMetrics().Increment("document_check_performed");
+    fingerprints_[fingerprint.document_key_] = fingerprint;
+}
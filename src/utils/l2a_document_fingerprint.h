@@ -0,0 +1,121 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Fingerprints of documents to skip checks of documents that did not change.
+ */
+
+#ifndef UTIL_DOCUMENT_FINGERPRINT_H_
+#define UTIL_DOCUMENT_FINGERPRINT_H_
+
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Values that change if something relevant for LaTeX2AI changed in a document.
+         */
+        struct DocumentFingerprint
+        {
+            //! Key that identifies the document.
+            std::string document_key_;
+
+            //! Time stamp of the art in Illustrator, this is incremented by every change of the art.
+            std::size_t art_time_stamp_ = 0;
+
+            //! Last write time of the links folder of the document, this changes if files are added or removed.
+            std::int64_t links_write_time_ = 0;
+
+            /**
+             * \brief Check if two fingerprints are equal.
+             */
+            bool operator==(const DocumentFingerprint& other) const
+            {
+                return document_key_ == other.document_key_ && art_time_stamp_ == other.art_time_stamp_ &&
+                       links_write_time_ == other.links_write_time_;
+            }
+        };
+
+        /**
+         * \brief Statistics of the performed and skipped document checks.
+         */
+        struct DocumentCheckStatistics
+        {
+            //! Number of performed checks.
+            size_t n_performed_ = 0;
+
+            //! Number of checks that were skipped, since the document did not change.
+            size_t n_skipped_ = 0;
+        };
+
+        /**
+         * \brief Get the last write time of a file or directory. If it does not exist, 0 is returned.
+         */
+        std::int64_t GetLastWriteTime(const std::filesystem::path& path);
+
+        /**
+         * \brief Store the fingerprints of the documents after they were successfully checked.
+         */
+        class DocumentCheckMemo
+        {
+           public:
+            /**
+             * \brief Return true if the document did not change since its last successful check, i.e., the check can
+             * be skipped.
+             */
+            bool SkipCheck(const DocumentFingerprint& fingerprint);
+
+            /**
+             * \brief Store the fingerprint of a document after a successful check.
+             */
+            void SetChecked(const DocumentFingerprint& fingerprint);
+
+            /**
+             * \brief Remove all stored fingerprints, so the next check of each document is performed.
+             */
+            void Clear() { fingerprints_.clear(); }
+
+            /**
+             * \brief Get the statistics of the checks.
+             */
+            const DocumentCheckStatistics& GetStatistics() const { return statistics_; }
+
+           private:
+            //! Fingerprints of the checked documents, the keys are the document keys.
+            std::map<std::string, DocumentFingerprint> fingerprints_;
+
+            //! Statistics of the checks.
+            DocumentCheckStatistics statistics_;
+        };
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
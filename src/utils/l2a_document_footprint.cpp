@@ -0,0 +1,204 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+/**
+ * \brief Analyze the size of the data that LaTeX2AI items store in a document.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_document_footprint.h"
+
+#include "base64.h"
+#include "json.hpp"
+
+#include "l2a_compile_core.h"
+#include "l2a_document_model.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <unordered_map>
+
+
+/**
+ *
+ */
+L2A::UTIL::DocumentFootprint L2A::UTIL::AnalyzeDocumentFootprint(const std::vector<std::string>& notes)
+{
+    DocumentFootprint footprint;
+    std::unordered_map<std::string, FootprintDuplicate> payloads;
+    std::string payload;
+    std::string hash;
+    for (size_t i_item = 0; i_item < notes.size(); i_item++)
+    {
+        const std::string& note = notes[i_item];
+        footprint.n_items_++;
+        footprint.note_size_ += note.size();
+        footprint.max_note_size_ = std::max(footprint.max_note_size_, note.size());
+
+        bool is_legacy_hash;
+        if (!ReadItemPDFFile(note, payload, hash, is_legacy_hash))
+        {
+            footprint.n_invalid_notes_++;
+            continue;
+        }
+        if (payload.empty())
+        {
+            footprint.n_items_without_payload_++;
+            continue;
+        }
+
+        if (is_legacy_hash) footprint.legacy_hash_items_.push_back(i_item);
+
+        footprint.payload_size_ += payload.size();
+        footprint.max_payload_size_ = std::max(footprint.max_payload_size_, payload.size());
+        size_t i_bucket = 0;
+        size_t bucket_limit = 1024;
+        while (payload.size() >= bucket_limit && i_bucket + 1 < DocumentFootprint::n_buckets_)
+        {
+            i_bucket++;
+            bucket_limit *= 2;
+        }
+        footprint.payload_size_buckets_[i_bucket]++;
+
+        // Only the first item with a pdf file is counted for the compression, all further ones could be removed.
+        auto [it, is_new] = payloads.emplace(hash, FootprintDuplicate{hash, 0, payload.size()});
+        it->second.n_items_++;
+        if (is_new)
+            footprint.compression_savings_ +=
+                payload.size() - std::min(payload.size(), EstimateCompressedEncodedSize(payload));
+        else
+            footprint.deduplication_savings_ += payload.size();
+    }
+
+    for (const auto& [payload_hash, duplicate] : payloads)
+        if (duplicate.n_items_ > 1) footprint.duplicates_.push_back(duplicate);
+    std::sort(footprint.duplicates_.begin(), footprint.duplicates_.end(),
+        [](const FootprintDuplicate& a, const FootprintDuplicate& b)
+        {
+            const size_t savings_a = (a.n_items_ - 1) * a.payload_size_;
+            const size_t savings_b = (b.n_items_ - 1) * b.payload_size_;
+            return savings_a != savings_b ? savings_a > savings_b : a.hash_ < b.hash_;
+        });
+    return footprint;
+}
+
+/**
+ *
+ */
+L2A::UTIL::DocumentFootprint L2A::UTIL::AnalyzeDocumentFootprint(
+    const DocumentModel& document, const std::string& item_name)
+{
+    std::vector<AIArtHandle> items;
+    GetDocumentItems(document, items, ArtSelection::all, item_name);
+    std::vector<std::string> notes;
+    notes.reserve(items.size());
+    for (const auto& item : items) notes.push_back(document.GetNote(item));
+    return AnalyzeDocumentFootprint(notes);
+}
+
+/**
+ *
+ */
+size_t L2A::UTIL::EstimateCompressedEncodedSize(const std::string& encoded)
+{
+    std::vector<char> decoded;
+    try
+    {
+        decoded = base64::decode(encoded);
+    }
+    catch (...)
+    {
+        return encoded.size();
+    }
+    if (decoded.empty()) return encoded.size();
+
+    std::array<size_t, 256> counts = {};
+    for (const char byte : decoded) counts[(unsigned char)byte]++;
+    double entropy = 0.0;
+    for (const size_t count : counts)
+    {
+        if (count == 0) continue;
+        const double probability = (double)count / (double)decoded.size();
+        entropy -= probability * std::log2(probability);
+    }
+    const size_t compressed_size = (size_t)std::ceil((double)decoded.size() * entropy / 8.0);
+    return 4 * ((compressed_size + 2) / 3);
+}
+
+/**
+ *
+ */
+std::string L2A::UTIL::GetDocumentFootprintJson(const DocumentFootprint& footprint)
+{
+    nlohmann::json json;
+    json["n_items"] = footprint.n_items_;
+    json["n_items_without_payload"] = footprint.n_items_without_payload_;
+    json["n_invalid_notes"] = footprint.n_invalid_notes_;
+    json["note_size"] = {{"total", footprint.note_size_}, {"max", footprint.max_note_size_}};
+
+    // Only the buckets up to the largest payload are written.
+    nlohmann::json buckets = nlohmann::json::array();
+    size_t n_buckets = DocumentFootprint::n_buckets_;
+    while (n_buckets > 0 && footprint.payload_size_buckets_[n_buckets - 1] == 0) n_buckets--;
+    for (size_t i_bucket = 0; i_bucket < n_buckets; i_bucket++)
+        buckets.push_back(
+            {{"below_kb", (size_t)1 << i_bucket}, {"n_items", footprint.payload_size_buckets_[i_bucket]}});
+    json["payload_size"] = {
+        {"total", footprint.payload_size_}, {"max", footprint.max_payload_size_}, {"buckets", buckets}};
+
+    nlohmann::json duplicates = nlohmann::json::array();
+    for (const auto& duplicate : footprint.duplicates_)
+        duplicates.push_back({{"hash", duplicate.hash_}, {"n_items", duplicate.n_items_},
+            {"payload_size", duplicate.payload_size_}});
+    json["duplicates"] = duplicates;
+    json["legacy_hash_items"] = footprint.legacy_hash_items_;
+    json["estimated_savings"] = {
+        {"deduplication", footprint.deduplication_savings_}, {"compression", footprint.compression_savings_}};
+    return json.dump(4) + "\n";
+}
+
+/**
+ *
+ */
+std::string L2A::UTIL::GetDocumentFootprintText(const DocumentFootprint& footprint)
+{
+    const auto kb = [](const size_t size) { return std::to_string((size + 512) / 1024) + " kB"; };
+
+    size_t n_duplicate_items = 0;
+    for (const auto& duplicate : footprint.duplicates_) n_duplicate_items += duplicate.n_items_;
+
+    std::string text;
+    text += "Document items: " + std::to_string(footprint.n_items_) + " (" +
+            std::to_string(footprint.n_items_without_payload_) + " without pdf data)\n";
+    text += "Notes: " + kb(footprint.note_size_) + " (largest " + kb(footprint.max_note_size_) + ")\n";
+    text += "Embedded pdf data: " + kb(footprint.payload_size_) + "\n";
+    text += "Duplicate pdf files: " + std::to_string(footprint.duplicates_.size()) + " in " +
+            std::to_string(n_duplicate_items) + " items, storing them once would save " +
+            kb(footprint.deduplication_savings_) + "\n";
+    text += "Compressing the pdf data would save about " + kb(footprint.compression_savings_) + "\n";
+    text += "Items with legacy hash: " + std::to_string(footprint.legacy_hash_items_.size()) + "\n";
+    return text;
+}
@@ -0,0 +1,134 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+/**
+ * \brief Analyze the size of the data that LaTeX2AI items store in a document.
+ *
+ * Each item stores its complete state, including the base64 encoded pdf file, in the note of the placed item. For
+ * documents with many items this is the main part of the file size. The analysis reports the sizes of the notes and the
+ * embedded pdf files, identical pdf files stored in multiple items, items with a legacy hash and an estimate of the
+ * size that could be saved by storing each pdf file only once or compressed.
+ */
+
+#ifndef UTIL_DOCUMENT_FOOTPRINT_H_
+#define UTIL_DOCUMENT_FOOTPRINT_H_
+
+
+#include "IllustratorSDK.h"
+
+#include <string>
+#include <vector>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        // Forward declaration.
+        class DocumentModel;
+
+        /**
+         * \brief A pdf file that is embedded in more than one item.
+         */
+        struct FootprintDuplicate
+        {
+            //! Hash of the encoded pdf file.
+            std::string hash_;
+
+            //! Number of items that contain the pdf file.
+            size_t n_items_;
+
+            //! Size of the encoded pdf file in bytes.
+            size_t payload_size_;
+        };
+
+        /**
+         * \brief Sizes of the data stored in the LaTeX2AI items of a document.
+         */
+        struct DocumentFootprint
+        {
+            //! Number of buckets for the payload sizes, bucket i contains the sizes below 2^i kB.
+            static constexpr size_t n_buckets_ = 16;
+
+            //! Number of analyzed items, the number of items without an embedded pdf file and the number of items
+            //! whose note could not be read.
+            size_t n_items_ = 0;
+            size_t n_items_without_payload_ = 0;
+            size_t n_invalid_notes_ = 0;
+
+            //! Total and maximal size of the notes in bytes.
+            size_t note_size_ = 0;
+            size_t max_note_size_ = 0;
+
+            //! Total and maximal size of the encoded pdf files in bytes.
+            size_t payload_size_ = 0;
+            size_t max_payload_size_ = 0;
+
+            //! Number of items in each payload size bucket.
+            std::vector<size_t> payload_size_buckets_ = std::vector<size_t>(n_buckets_, 0);
+
+            //! Pdf files that are embedded in more than one item, the ones with the largest savings first.
+            std::vector<FootprintDuplicate> duplicates_;
+
+            //! Indices of the items whose pdf hash was created with a legacy method. The hash of these items is
+            //! calculated again each time the item is read.
+            std::vector<size_t> legacy_hash_items_;
+
+            //! Bytes that would be saved if each pdf file was only stored once.
+            size_t deduplication_savings_ = 0;
+
+            //! Estimated bytes that would be saved if the stored pdf files were compressed before they are encoded. The
+            //! estimate is based on the byte entropy of the decoded files, so it is only an approximation.
+            size_t compression_savings_ = 0;
+        };
+
+        /**
+         * \brief Analyze the notes of LaTeX2AI items.
+         */
+        DocumentFootprint AnalyzeDocumentFootprint(const std::vector<std::string>& notes);
+
+        /**
+         * \brief Analyze the LaTeX2AI items in a document, i.e., the placed items whose name starts with item_name.
+         */
+        DocumentFootprint AnalyzeDocumentFootprint(const DocumentModel& document, const std::string& item_name);
+
+        /**
+         * \brief Estimate the size of a base64 encoded string, if the decoded data is compressed before it is encoded.
+         * The estimate is the order-0 entropy of the decoded bytes. If the string can not be decoded, its size is
+         * returned.
+         */
+        size_t EstimateCompressedEncodedSize(const std::string& encoded);
+
+        /**
+         * \brief Get the footprint as JSON.
+         */
+        std::string GetDocumentFootprintJson(const DocumentFootprint& footprint);
+
+        /**
+         * \brief Get a short summary of the footprint.
+         */
+        std::string GetDocumentFootprintText(const DocumentFootprint& footprint);
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
@@ -0,0 +1,298 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Interface to the Illustrator document used by the document level functions of LaTeX2AI, and an in-memory
+ * implementation of it.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_document_model.h"
+
+#include "l2a_compile_core.h"
+#include "l2a_links_folder.h"
+#include "l2a_metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_set>
+
+
+/**
+ *
+ */
+AIArtHandle L2A::UTIL::FakeDocument::AddArt(const FakeArt& art)
+{
+    art_.push_back(art);
+    return reinterpret_cast<AIArtHandle>(static_cast<std::uintptr_t>(art_.size()));
+}
+
+/**
+ *
+ */
+L2A::UTIL::FakeArt& L2A::UTIL::FakeDocument::GetArtMutable(const AIArtHandle& item)
+{
+    const std::uintptr_t id = reinterpret_cast<std::uintptr_t>(item);
+    if (id == 0 || id > art_.size()) throw std::out_of_range("The art item does not exist in the document");
+    return art_[id - 1];
+}
+
+/**
+ *
+ */
+const L2A::UTIL::FakeArt& L2A::UTIL::FakeDocument::GetArt(const AIArtHandle& item) const
+{
+    n_calls_++;
+    const std::uintptr_t id = reinterpret_cast<std::uintptr_t>(item);
+    if (id == 0 || id > art_.size()) throw std::out_of_range("The art item does not exist in the document");
+    return art_[id - 1];
+}
+
+/**
+ *
+ */
+void L2A::UTIL::FakeDocument::GetPlacedArt(std::vector<AIArtHandle>& items, const ArtSelection selection) const
+{
+    n_calls_++;
+    items.clear();
+    for (size_t i_art = 0; i_art < art_.size(); i_art++)
+    {
+        const bool is_selected = art_[i_art].is_selected_;
+        if (selection == ArtSelection::all || (selection == ArtSelection::selected) == is_selected)
+            items.push_back(reinterpret_cast<AIArtHandle>(static_cast<std::uintptr_t>(i_art + 1)));
+    }
+}
+
+/**
+ *
+ */
+std::string L2A::UTIL::FakeDocument::GetName(const AIArtHandle& item) const { return GetArt(item).name_; }
+
+/**
+ *
+ */
+std::string L2A::UTIL::FakeDocument::GetNote(const AIArtHandle& item) const { return GetArt(item).note_; }
+
+/**
+ *
+ */
+std::filesystem::path L2A::UTIL::FakeDocument::GetPlacedItemPath(const AIArtHandle& item) const
+{
+    return GetArt(item).placed_item_path_;
+}
+
+/**
+ *
+ */
+L2A::UTIL::GeometrySnapshot L2A::UTIL::FakeDocument::GetGeometry(const AIArtHandle& item) const
+{
+    const FakeArt& art = GetArt(item);
+    return GeometrySnapshot(art.placed_matrix_, art.bounds_, art.placed_bounding_box_);
+}
+
+/**
+ *
+ */
+void L2A::UTIL::FakeDocument::GetIsHiddenLocked(const AIArtHandle& item, bool& is_hidden, bool& is_locked) const
+{
+    const FakeArt& art = GetArt(item);
+    is_hidden = art.is_hidden_;
+    is_locked = art.is_locked_;
+}
+
+/**
+ * \brief Check if the n-th item is affected by a synthetic document option that applies to every interval-th item.
+ */
+bool IsSyntheticInterval(const size_t i_item, const size_t interval)
+{
+    return interval != 0 && i_item % interval == 0;
+}
+
+/**
+ * \brief Get random base64 encoded data for the pdf file of a synthetic item. The data only depends on the code index.
+ */
+std::string GetSyntheticPayload(const size_t i_code, const size_t payload_size)
+{
+    static const char* base64_characters = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string payload(4 * ((payload_size + 3) / 4), 'A');
+    std::uint64_t state = 0x9E3779B97F4A7C15ull * (i_code + 1);
+    for (auto& character : payload)
+    {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        character = base64_characters[state >> 58];
+    }
+    return payload;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::CreateSyntheticDocument(FakeDocument& document, const SyntheticDocumentOptions& options)
+{
+    const size_t n_total = options.n_items_ + options.n_other_items_;
+    const size_t n_columns = std::max((size_t)1, (size_t)std::ceil(std::sqrt((double)n_total)));
+    const size_t other_interval = options.n_other_items_ == 0 ? 0 : n_total / options.n_other_items_;
+    const AIReal pi = std::acos((AIReal)-1.0);
+
+    size_t n_other_items = 0;
+    for (size_t i_item = 0; i_item < n_total; i_item++)
+    {
+        // The other placed items are mixed in between the LaTeX2AI items.
+        const bool is_l2a_item = n_other_items == options.n_other_items_ ||
+                                 (i_item % other_interval != other_interval - 1 &&
+                                     n_total - i_item > options.n_other_items_ - n_other_items);
+        if (!is_l2a_item) n_other_items++;
+
+        FakeArt art;
+        art.is_selected_ = IsSyntheticInterval(i_item, options.selected_interval_);
+        art.is_hidden_ = IsSyntheticInterval(i_item, options.hidden_interval_);
+        art.is_locked_ = IsSyntheticInterval(i_item, options.locked_interval_);
+
+        // Pdf files of the items have a size that depends on the code, rotated items are rotated by 30 degrees.
+        const size_t i_code = options.n_codes_ == 0 ? i_item : i_item % options.n_codes_;
+        const AIReal width = 10.0 + (AIReal)(i_code % 5) * 5.0;
+        const AIReal height = 10.0;
+        const AIReal angle = IsSyntheticInterval(i_item, options.rotated_interval_) ? pi / 6.0 : 0.0;
+        art.placed_bounding_box_ = {0.0, height, width, 0.0};
+        art.placed_matrix_ = {std::cos(angle), -std::sin(angle), -std::sin(angle), -std::cos(angle), 0.0, 0.0};
+
+        // Bounds of the rotated item, the bottom left corner is on the grid.
+        const AIRealPoint corner = {
+            (AIReal)(i_item % n_columns) * options.spacing_, -(AIReal)(i_item / n_columns) * options.spacing_};
+        const AIRealPoint edge_0 = {width * std::cos(angle), width * std::sin(angle)};
+        const AIRealPoint edge_1 = {-height * std::sin(angle), height * std::cos(angle)};
+        art.bounds_ = {corner.h + std::min({(AIReal)0.0, edge_0.h, edge_1.h, edge_0.h + edge_1.h}),
+            corner.v + std::max({(AIReal)0.0, edge_0.v, edge_1.v, edge_0.v + edge_1.v}),
+            corner.h + std::max({(AIReal)0.0, edge_0.h, edge_1.h, edge_0.h + edge_1.h}),
+            corner.v + std::min({(AIReal)0.0, edge_0.v, edge_1.v, edge_0.v + edge_1.v})};
+
+        if (is_l2a_item)
+        {
+            const std::string latex_code = "$x_{" + std::to_string(i_code) + "}$";
+            const std::string payload =
+                options.payload_size_ == 0 ? "" : GetSyntheticPayload(i_code, options.payload_size_);
+            const std::string hash = GetStringHash(payload.empty() ? latex_code : payload);
+            const bool is_legacy_hash = IsSyntheticInterval(i_item, options.legacy_hash_interval_);
+            art.name_ = options.item_name_;
+            art.note_ = "<LaTeX2AI_item text_align_horizontal=\"left\" text_align_vertical=\"" +
+                        std::string(i_code % 2 == 0 ? "bottom" : "baseline") + "\"><latex cursor_position=\"0\">" +
+                        latex_code + "</latex><pdf_file_contents hash=\"" + hash + "\"" +
+                        (is_legacy_hash ? "" : " hash_method=\"crc64\"") +
+                        (payload.empty() ? "/>" : ">" + payload + "</pdf_file_contents>") + "</LaTeX2AI_item>";
+            art.placed_item_path_ =
+                options.links_directory_ / (options.document_name_ + options.pdf_item_post_fix_ + hash + ".pdf");
+        }
+        else
+        {
+            art.name_ = "image " + std::to_string(i_item);
+            art.placed_item_path_ = options.links_directory_ / ("image_" + std::to_string(i_item) + ".png");
+        }
+        document.AddArt(art);
+    }
+}
+
+/**
+ *
+ */
+void L2A::UTIL::GetDocumentItems(const DocumentModel& document, std::vector<AIArtHandle>& l2a_items,
+    const ArtSelection selection, const std::string& item_name)
+{
+    l2a_items.clear();
+
+    std::vector<AIArtHandle> art_items;
+    document.GetPlacedArt(art_items, selection);
+
+    // Loop over placed art items and check if they are LaTeX2AI items.
+    for (const auto& item : art_items)
+        if (document.GetName(item).rfind(item_name, 0) == 0) l2a_items.push_back(item);
+}
+
+/**
+ *
+ */
+std::array<AIRealPoint, 9> L2A::UTIL::GetPlacementPoints(const GeometrySnapshot& geometry)
+{
+    std::array<AIRealPoint, 9> points;
+    for (size_t i_point = 0; i_point < points.size(); i_point++)
+    {
+        const AIReal pos_fac[2] = {0.5 * (AIReal)(i_point % 3), 1.0 - 0.5 * (AIReal)(i_point / 3)};
+        points[i_point] = geometry.GetPosition(pos_fac);
+    }
+    return points;
+}
+
+/**
+ *
+ */
+L2A::UTIL::DrawnItemState L2A::UTIL::CreateDrawnItemState(const AIArtHandle& item, const GeometrySnapshot& geometry,
+    const std::array<AIRealPoint, 9>& placement_points, const bool is_hidden, const bool is_locked)
+{
+    DrawnItemState state;
+    state.art_ = item;
+    state.bounds_ = {placement_points[0].h, placement_points[0].v, placement_points[0].h, placement_points[0].v};
+    state.values_.reserve(2 * placement_points.size() + 6);
+    for (const auto& point : placement_points)
+    {
+        state.bounds_.left = std::min(state.bounds_.left, point.h);
+        state.bounds_.top = std::max(state.bounds_.top, point.v);
+        state.bounds_.right = std::max(state.bounds_.right, point.h);
+        state.bounds_.bottom = std::min(state.bounds_.bottom, point.v);
+        state.values_.push_back(point.h);
+        state.values_.push_back(point.v);
+    }
+    for (const bool flag : {geometry.IsDiamond(), geometry.IsStretched(), is_hidden, is_locked})
+        state.values_.push_back(flag ? 1.0 : 0.0);
+    return state;
+}
+
+/**
+ *
+ */
+L2A::UTIL::ItemLinksPlan L2A::UTIL::CreateItemLinksPlan(
+    const LinksManifest& manifest, const std::vector<ItemLinkState>& items)
+{
+    ItemLinksPlan plan;
+    plan.used_pdf_files_.reserve(items.size());
+    std::unordered_set<std::string> write_files;
+    size_t n_invalid = 0;
+    for (size_t i_item = 0; i_item < items.size(); i_item++)
+    {
+        const auto& item = items[i_item];
+        const bool is_valid_file = manifest.IsValid(item.pdf_name_, item.pdf_hash_);
+        if (!is_valid_file)
+        {
+            n_invalid++;
+            if (write_files.insert(item.pdf_name_).second) plan.write_items_.push_back(i_item);
+        }
+        if (!(is_valid_file && item.is_linked_)) plan.relink_items_.push_back(i_item);
+        plan.used_pdf_files_.push_back(item.pdf_name_);
+    }
+    GetMetrics().Increment("links_manifest_valid", items.size() - n_invalid);
+    GetMetrics().Increment("links_manifest_invalid", n_invalid);
+    return plan;
+}
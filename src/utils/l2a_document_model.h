@@ -0,0 +1,295 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Interface to the Illustrator document used by the document level functions of LaTeX2AI, and an in-memory
+ * implementation of it.
+ *
+ * The functions that loop over all items of a document (finding the items, the annotator states, the check of the
+ * linked pdf files) only get data from the document through DocumentModel. In the plugin the data comes from
+ * Illustrator, with FakeDocument synthetic documents of any size can be created, so these functions can be tested and
+ * profiled without Illustrator.
+ */
+
+#ifndef UTIL_DOCUMENT_MODEL_H_
+#define UTIL_DOCUMENT_MODEL_H_
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_geometry.h"
+#include "l2a_invalidation.h"
+
+#include <array>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        // Forward declaration.
+        class LinksManifest;
+
+        /**
+         * \brief Selection state of art items that are searched in the document.
+         */
+        enum class ArtSelection
+        {
+            all,
+            selected,
+            deselected
+        };
+
+        /**
+         * \brief Interface for the data that the document level functions get from the document.
+         */
+        class DocumentModel
+        {
+           public:
+            /**
+             * \brief Virtual destructor.
+             */
+            virtual ~DocumentModel() = default;
+
+            /**
+             * \brief Get all placed art items in the document with the given selection state.
+             */
+            virtual void GetPlacedArt(std::vector<AIArtHandle>& items, const ArtSelection selection) const = 0;
+
+            /**
+             * \brief Get the name of an art item.
+             */
+            virtual std::string GetName(const AIArtHandle& item) const = 0;
+
+            /**
+             * \brief Get the note of an art item.
+             */
+            virtual std::string GetNote(const AIArtHandle& item) const = 0;
+
+            /**
+             * \brief Get the path of the file linked to a placed item.
+             */
+            virtual std::filesystem::path GetPlacedItemPath(const AIArtHandle& item) const = 0;
+
+            /**
+             * \brief Get a snapshot of the geometry of a placed item.
+             */
+            virtual GeometrySnapshot GetGeometry(const AIArtHandle& item) const = 0;
+
+            /**
+             * \brief Get the hidden and locked status of an art item.
+             */
+            virtual void GetIsHiddenLocked(const AIArtHandle& item, bool& is_hidden, bool& is_locked) const = 0;
+        };
+
+        /**
+         * \brief Data of one art item in a FakeDocument.
+         */
+        struct FakeArt
+        {
+            //! Name and note of the item.
+            std::string name_;
+            std::string note_;
+
+            //! Path of the linked file.
+            std::filesystem::path placed_item_path_;
+
+            //! Geometric data of the placed item.
+            AIRealMatrix placed_matrix_ = {1.0, 0.0, 0.0, -1.0, 0.0, 0.0};
+            AIRealRect bounds_ = {0.0, 0.0, 0.0, 0.0};
+            AIRealRect placed_bounding_box_ = {0.0, 0.0, 0.0, 0.0};
+
+            //! State flags of the item.
+            bool is_selected_ = false;
+            bool is_hidden_ = false;
+            bool is_locked_ = false;
+        };
+
+        /**
+         * \brief Document that stores its placed art items in memory.
+         *
+         * The number of calls to the DocumentModel functions is counted, since each of them is a call to an
+         * Illustrator suite in the plugin.
+         */
+        class FakeDocument : public DocumentModel
+        {
+           public:
+            /**
+             * \brief Add an art item to the document and return its handle.
+             */
+            AIArtHandle AddArt(const FakeArt& art);
+
+            /**
+             * \brief Get a mutable reference to the data of an art item.
+             */
+            FakeArt& GetArtMutable(const AIArtHandle& item);
+
+            /**
+             * \brief Get the number of art items in the document.
+             */
+            size_t Size() const { return art_.size(); }
+
+            /**
+             * \brief Get the number of calls to the DocumentModel functions.
+             */
+            size_t GetCallCount() const { return n_calls_; }
+
+            /**
+             * \brief Reset the number of calls to the DocumentModel functions.
+             */
+            void ResetCallCount() { n_calls_ = 0; }
+
+            void GetPlacedArt(std::vector<AIArtHandle>& items, const ArtSelection selection) const override;
+            std::string GetName(const AIArtHandle& item) const override;
+            std::string GetNote(const AIArtHandle& item) const override;
+            std::filesystem::path GetPlacedItemPath(const AIArtHandle& item) const override;
+            GeometrySnapshot GetGeometry(const AIArtHandle& item) const override;
+            void GetIsHiddenLocked(const AIArtHandle& item, bool& is_hidden, bool& is_locked) const override;
+
+           private:
+            /**
+             * \brief Get the data of an art item and count the call.
+             */
+            const FakeArt& GetArt(const AIArtHandle& item) const;
+
+           private:
+            //! Art items in the document, the handle of an item is its position in this vector plus one.
+            std::vector<FakeArt> art_;
+
+            //! Number of calls to the DocumentModel functions.
+            mutable size_t n_calls_ = 0;
+        };
+
+        /**
+         * \brief Options for a synthetic document.
+         */
+        struct SyntheticDocumentOptions
+        {
+            //! Number of LaTeX2AI items and other placed items in the document.
+            size_t n_items_ = 1000;
+            size_t n_other_items_ = 0;
+
+            //! Number of different LaTeX codes, items with the same code are duplicates of each other.
+            size_t n_codes_ = 1000;
+
+            //! Every n-th item is selected, hidden, locked or rotated (0 for none).
+            size_t selected_interval_ = 10;
+            size_t hidden_interval_ = 50;
+            size_t locked_interval_ = 20;
+            size_t rotated_interval_ = 7;
+
+            //! Size of the encoded pdf file stored in the note of each item (0 for none). Items with the same code
+            //! store the same pdf file.
+            size_t payload_size_ = 0;
+
+            //! Every n-th item stores its pdf file without the hash method, as items of older versions (0 for none).
+            size_t legacy_hash_interval_ = 0;
+
+            //! Items are placed on a grid with this spacing (in artwork coordinates).
+            AIReal spacing_ = 50.0;
+
+            //! Name of the LaTeX2AI items and the postfix of their pdf files, as in l2a_names.h.
+            std::string item_name_ = "LaTeX2AI";
+            std::string pdf_item_post_fix_ = "_LaTeX2AI_";
+
+            //! Name of the document, used for the names of the linked pdf files.
+            std::string document_name_ = "document";
+
+            //! Directory of the linked pdf files.
+            std::filesystem::path links_directory_ = "links";
+        };
+
+        /**
+         * \brief Fill a document with placed items, as they are created by LaTeX2AI.
+         *
+         * The LaTeX2AI items have the name and the note of an item (with a hash and, if requested, with random pdf
+         * contents) and are linked to the pdf file of their hash in the links directory. The files themselves are not
+         * created.
+         */
+        void CreateSyntheticDocument(FakeDocument& document, const SyntheticDocumentOptions& options);
+
+        /**
+         * \brief Get the LaTeX2AI items in the document, i.e., the placed items whose name starts with item_name.
+         */
+        void GetDocumentItems(const DocumentModel& document, std::vector<AIArtHandle>& l2a_items,
+            const ArtSelection selection, const std::string& item_name);
+
+        /**
+         * \brief Get the placement points of an item in the order top left, top mid, top right, mid left, ..., bottom
+         * right.
+         */
+        std::array<AIRealPoint, 9> GetPlacementPoints(const GeometrySnapshot& geometry);
+
+        /**
+         * \brief Create the state of a drawn item from its geometry and status. The values of the state are the
+         * placement points and the flags, further values that influence the drawing can be appended by the caller.
+         */
+        DrawnItemState CreateDrawnItemState(const AIArtHandle& item, const GeometrySnapshot& geometry,
+            const std::array<AIRealPoint, 9>& placement_points, const bool is_hidden, const bool is_locked);
+
+        /**
+         * \brief Data of an item needed to check if its pdf file is stored and linked correctly.
+         */
+        struct ItemLinkState
+        {
+            //! Name of the pdf file of the item in the links directory.
+            std::string pdf_name_;
+
+            //! Hash of the pdf contents stored in the item.
+            std::string pdf_hash_;
+
+            //! If the placed item is linked to this pdf file.
+            bool is_linked_;
+        };
+
+        /**
+         * \brief Items whose pdf files have to be written or relinked.
+         */
+        struct ItemLinksPlan
+        {
+            //! Indices of the items whose pdf file has to be written. Items with the same pdf file share the file, it
+            //! is only written for the first of them.
+            std::vector<size_t> write_items_;
+
+            //! Indices of the items that have to be relinked to their pdf file.
+            std::vector<size_t> relink_items_;
+
+            //! Names of all pdf files used by the items.
+            std::vector<std::string> used_pdf_files_;
+        };
+
+        /**
+         * \brief Find the items whose pdf files have to be written again or relinked.
+         *
+         * A pdf file only has to be written if it is not a valid file in the manifest. An item has to be relinked if
+         * its file is written or if it is linked to a different file.
+         */
+        ItemLinksPlan CreateItemLinksPlan(const LinksManifest& manifest, const std::vector<ItemLinkState>& items);
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
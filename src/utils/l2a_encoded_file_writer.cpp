@@ -0,0 +1,101 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Write base64 encoded files in parallel.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_encoded_file_writer.h"
+
+#include "base64.h"
+
+#include "l2a_links_folder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <thread>
+
+
+/**
+ * \brief Decode and write a single file.
+ */
+void WriteEncodedFile(L2A::UTIL::EncodedFileWrite& file)
+{
+    file.is_written_ = false;
+    if (file.encoded_contents_.empty()) return;
+    try
+    {
+        const auto char_vector = base64::decode(file.encoded_contents_);
+        std::ofstream output_stream(file.path_, std::ofstream::binary | std::ofstream::trunc);
+        output_stream.write(char_vector.data(), char_vector.size());
+        output_stream.close();
+        if (!output_stream) return;
+        file.content_hash_ = L2A::UTIL::GetDataContentHash(char_vector.data(), char_vector.size());
+        file.is_written_ = true;
+    }
+    catch (const std::exception&)
+    {
+        // The caller handles files that could not be written.
+    }
+}
+
+/**
+ *
+ */
+unsigned int L2A::UTIL::GetEncodedFileWriteThreadCount()
+{
+    // Writing the files is limited by the disk, so more than a few threads do not pay off.
+    static const unsigned int max_threads = 8;
+    return std::clamp(std::thread::hardware_concurrency(), 1u, max_threads);
+}
+
+/**
+ *
+ */
+void L2A::UTIL::WriteEncodedFiles(std::vector<EncodedFileWrite>& files, const unsigned int n_threads)
+{
+    const size_t n_workers = std::min((size_t)std::max(n_threads, 1u), files.size());
+    if (n_workers <= 1)
+    {
+        for (auto& file : files) WriteEncodedFile(file);
+        return;
+    }
+
+    // Each thread takes the next file that was not taken yet, so large files do not stall the other threads.
+    std::atomic<size_t> next_file(0);
+    const auto work = [&files, &next_file]()
+    {
+        for (size_t i_file = next_file++; i_file < files.size(); i_file = next_file++) WriteEncodedFile(files[i_file]);
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(n_workers - 1);
+    for (size_t i_thread = 1; i_thread < n_workers; i_thread++) threads.emplace_back(work);
+    work();
+    for (auto& thread : threads) thread.join();
+}
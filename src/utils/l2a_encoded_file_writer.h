@@ -0,0 +1,78 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Write base64 encoded files in parallel.
+ */
+
+#ifndef UTIL_ENCODED_FILE_WRITER_H_
+#define UTIL_ENCODED_FILE_WRITER_H_
+
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief A file that has to be written from base64 encoded data.
+         *
+         * This only contains standard library types, so it can be processed without calling any Illustrator suites.
+         */
+        struct EncodedFileWrite
+        {
+            //! Path of the file.
+            std::filesystem::path path_;
+
+            //! Base64 encoded contents of the file.
+            std::string encoded_contents_;
+
+            //! Flag if the file was written.
+            bool is_written_ = false;
+
+            //! Hash of the written file contents, see L2A::UTIL::GetDataContentHash.
+            std::uint64_t content_hash_ = 0;
+        };
+
+        /**
+         * \brief Get the number of threads to write the encoded files.
+         */
+        unsigned int GetEncodedFileWriteThreadCount();
+
+        /**
+         * \brief Decode and write the files.
+         *
+         * The files are distributed over the given number of threads. Errors are not thrown, instead the is_written_
+         * flag of the file is false. Files with empty encoded contents are not written.
+         */
+        void WriteEncodedFiles(std::vector<EncodedFileWrite>& files, const unsigned int n_threads);
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
@@ -34,9 +34,11 @@
 #include "base64.h"
 
 #include "l2a_error.h"
+#include "l2a_links_folder.h"
 #include "l2a_names.h"
 #include "l2a_string_functions.h"
 #include "l2a_suites.h"
+#include "l2a_trace.h"
 
 #include <array>
 #include <regex>
@@ -377,6 +379,8 @@ bool L2A::UTIL::IsEqualFile(const ai::FilePath& path_a, const ai::FilePath& path
  */
 std::string L2A::UTIL::encode_file_base64(const ai::FilePath& path)
 {
+    L2A::UTIL::TraceScope trace_scope("EncodeBase64");
+
     // https://www.cplusplus.com/reference/istream/istream/read/
 
     std::ifstream input_stream(FilePathAiToStd(path), std::ifstream::binary);
@@ -403,10 +407,11 @@ std::string L2A::UTIL::encode_file_base64(const ai::FilePath& path)
 /*
  *
  */
-void L2A::UTIL::decode_file_base64(const ai::FilePath& path, const ai::UnicodeString& encoded_string)
+std::uint64_t L2A::UTIL::decode_file_base64(const ai::FilePath& path, const ai::UnicodeString& encoded_string)
 {
     auto char_vector = base64::decode(L2A::UTIL::StringAiToStd(encoded_string));
     std::ofstream output_stream(FilePathAiToStd(path), std::ofstream::binary);
     output_stream.write(char_vector.data(), char_vector.size());
     output_stream.close();
+    return L2A::UTIL::GetDataContentHash(char_vector.data(), char_vector.size());
 }
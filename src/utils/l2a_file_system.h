@@ -32,6 +32,7 @@
 
 #include "IllustratorSDK.h"
 
+#include <cstdint>
 #include <filesystem>
 
 namespace L2A
@@ -168,9 +169,10 @@ namespace L2A
         std::string encode_file_base64(const ai::FilePath& path);
 
         /*
-         * \brief Write a base64 encoded string to a file.
+         * \brief Write a base64 encoded string to a file. Return the hash of the written contents, see
+         * L2A::UTIL::GetDataContentHash.
          */
-        void decode_file_base64(const ai::FilePath& path, const ai::UnicodeString& encoded_string);
+        std::uint64_t decode_file_base64(const ai::FilePath& path, const ai::UnicodeString& encoded_string);
     }  // namespace UTIL
 }  // namespace L2A
 
@@ -0,0 +1,95 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Geometry of a placed item in the document.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_geometry.h"
+
+#include "l2a_constants.h"
+
+#include <algorithm>
+
+
+/**
+ *
+ */
+L2A::UTIL::GeometrySnapshot::GeometrySnapshot(
+    const AIRealMatrix& placed_matrix, const AIRealRect& bounds, const AIRealRect& placed_bounding_box)
+    : placed_matrix_(placed_matrix), bounds_(bounds), placed_bounding_box_(placed_bounding_box)
+{
+    // Angles of the basis vectors.
+    angle_[0] = -atan2(placed_matrix_.b, placed_matrix_.a);
+    angle_[1] = atan2(-placed_matrix_.d, placed_matrix_.c);
+
+    // Scale factor of the basis vectors.
+    stretch_[0] = sqrt(placed_matrix_.b * placed_matrix_.b + placed_matrix_.a * placed_matrix_.a);
+    stretch_[1] = sqrt(placed_matrix_.c * placed_matrix_.c + placed_matrix_.d * placed_matrix_.d);
+
+    // Check if item is rotated.
+    is_rotated_ = std::abs(angle_[0]) >= L2A::CONSTANTS::eps_angle_;
+
+    // Check if the angle between the two directors is pi/2. Use the strech tollerance here, because not the angles
+    // are compared, but their cosines.
+    is_diamond_ = std::abs(cos(angle_[1] - angle_[0])) >= L2A::CONSTANTS::eps_strech_;
+
+    // Check if item is streched, both strech factors must be smaller than eps.
+    is_stretched_ = std::abs(1. - stretch_[0]) >= L2A::CONSTANTS::eps_strech_ ||
+                    std::abs(1. - stretch_[1]) >= L2A::CONSTANTS::eps_strech_;
+
+    // Vectors along the edges of the item.
+    const AIReal pdf_height = placed_bounding_box_.top - placed_bounding_box_.bottom;
+    const AIReal pdf_width = placed_bounding_box_.right - placed_bounding_box_.left;
+    edge_[0] = {stretch_[0] * pdf_width * cos(angle_[0]), stretch_[0] * pdf_width * sin(angle_[0])};
+    edge_[1] = {stretch_[1] * pdf_height * cos(angle_[1]), stretch_[1] * pdf_height * sin(angle_[1])};
+
+    // Get the minimum distance of the corners for both directions and the position of the bottom left node.
+    const AIReal diff_x = std::min({(AIReal)0.0, edge_[0].h, edge_[1].h, edge_[0].h + edge_[1].h});
+    const AIReal diff_y = std::min({(AIReal)0.0, edge_[0].v, edge_[1].v, edge_[0].v + edge_[1].v});
+    corner_ = {bounds_.left - diff_x, bounds_.bottom - diff_y};
+}
+
+/**
+ *
+ */
+AIRealPoint L2A::UTIL::GeometrySnapshot::GetPosition(const AIReal (&pos_fac)[2]) const
+{
+    AIRealPoint position;
+    if ((!is_rotated_) && (!is_diamond_))
+    {
+        // Item is rectangle that is not rotated. This should be the default case.
+        position.h = (ASReal)(bounds_.left + pos_fac[0] * (bounds_.right - bounds_.left));
+        position.v = (ASReal)(bounds_.bottom + pos_fac[1] * (bounds_.top - bounds_.bottom));
+    }
+    else
+    {
+        position.h = (ASReal)(corner_.h + pos_fac[0] * edge_[0].h + pos_fac[1] * edge_[1].h);
+        position.v = (ASReal)(corner_.v + pos_fac[0] * edge_[0].v + pos_fac[1] * edge_[1].v);
+    }
+    return position;
+}
@@ -0,0 +1,144 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Geometry of a placed item in the document.
+ */
+
+#ifndef UTIL_GEOMETRY_H_
+#define UTIL_GEOMETRY_H_
+
+
+#include "IllustratorSDK.h"
+
+#include <array>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Snapshot of the geometry of a placed item.
+         *
+         * The geometric data of a placed item is stored in the placed matrix, the art bounds and the bounding box of
+         * the placed file. All derived quantities (angles, stretches and the shape classification) are computed once
+         * when the snapshot is created, so the snapshot can be queried multiple times without going through the
+         * Illustrator suites again.
+         */
+        class GeometrySnapshot
+        {
+           public:
+            /**
+             * \brief Create the snapshot from the geometric data of a placed item.
+             * @param placed_matrix Placed matrix of the item.
+             * @param bounds Bounds of the item in the document.
+             * @param placed_bounding_box Bounding box of the placed file.
+             */
+            GeometrySnapshot(
+                const AIRealMatrix& placed_matrix, const AIRealRect& bounds, const AIRealRect& placed_bounding_box);
+
+            /**
+             * \brief Get the placed matrix of the item.
+             */
+            const AIRealMatrix& GetPlacedMatrix() const { return placed_matrix_; }
+
+            /**
+             * \brief Get the bounds of the item in the document.
+             */
+            const AIRealRect& GetBounds() const { return bounds_; }
+
+            /**
+             * \brief Get the bounding box of the placed file.
+             */
+            const AIRealRect& GetPlacedBoundingBox() const { return placed_bounding_box_; }
+
+            /**
+             * \brief Get the angle of the item along the x1 or x2 axis (director is 0 for x1 and 1 for x2).
+             */
+            AIReal GetAngle(unsigned short director = 0) const { return angle_.at(director); }
+
+            /**
+             * \brief Get the stretch of the item in a direction.
+             */
+            AIReal GetStretch(unsigned short director = 0) const { return stretch_.at(director); }
+
+            /**
+             * \brief Check if the item is rotated.
+             */
+            bool IsRotated() const { return is_rotated_; }
+
+            /**
+             * \brief Check if the item is of diamond shape.
+             */
+            bool IsDiamond() const { return is_diamond_; }
+
+            /**
+             * \brief Check if the item is stretched.
+             */
+            bool IsStretched() const { return is_stretched_; }
+
+            /**
+             * \brief Get the position of a point on the item.
+             * @param pos_fac Relative position of the point on the item, i.e., {0,0} is the bottom left corner and
+             * {1,1} is the top right corner.
+             */
+            AIRealPoint GetPosition(const AIReal (&pos_fac)[2]) const;
+
+           private:
+            //! Placed matrix of the item.
+            AIRealMatrix placed_matrix_;
+
+            //! Bounds of the item in the document.
+            AIRealRect bounds_;
+
+            //! Bounding box of the placed file.
+            AIRealRect placed_bounding_box_;
+
+            //! Angles of the item along the x1 and x2 axis.
+            std::array<AIReal, 2> angle_;
+
+            //! Stretch of the item along the x1 and x2 axis.
+            std::array<AIReal, 2> stretch_;
+
+            //! Flag if the item is rotated.
+            bool is_rotated_;
+
+            //! Flag if the item is of diamond shape.
+            bool is_diamond_;
+
+            //! Flag if the item is stretched.
+            bool is_stretched_;
+
+            //! Position of the bottom left corner of a rotated or diamond shaped item.
+            AIRealPoint corner_;
+
+            //! Vectors along the edges of a rotated or diamond shaped item.
+            std::array<AIRealPoint, 2> edge_;
+        };
+    }  // namespace UTIL
+}  // namespace L2A
+
+
+#endif
@@ -0,0 +1,425 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Resolve the LaTeX header of a document and cache the result as long as the included files do not change.
+ */
+
+
+#include "l2a_header_resolver.h"
+
+#include "l2a_compile_core.h"
+#include "l2a_metrics.h"
+
+#include <cctype>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+
+namespace
+{
+    /**
+     * \brief State while a header is resolved.
+     */
+    struct HeaderResolveState
+    {
+        /**
+         * \brief Create the state for a header in the given directory.
+         */
+        HeaderResolveState(L2A::UTIL::ResolvedHeader& result, const std::filesystem::path& header_directory)
+            : result_(result), header_directory_(header_directory)
+        {
+        }
+
+        //! Result that is filled up.
+        L2A::UTIL::ResolvedHeader& result_;
+
+        //! Directory of the header, local packages are searched relative to this directory.
+        std::filesystem::path header_directory_;
+
+        //! Files that are currently resolved, used to detect cycles.
+        std::vector<std::filesystem::path> stack_;
+
+        //! Files that are already tracked as dependency.
+        std::set<std::filesystem::path> tracked_files_;
+
+        //! Local packages that are already scanned.
+        std::set<std::filesystem::path> scanned_packages_;
+    };
+}  // namespace
+
+/**
+ * \brief Get a normalized path, so the same file always results in the same path.
+ */
+static std::filesystem::path NormalizeHeaderPath(const std::filesystem::path& path)
+{
+    std::error_code error_code;
+    std::filesystem::path normalized_path = std::filesystem::weakly_canonical(path, error_code);
+    if (error_code) normalized_path = std::filesystem::absolute(path, error_code).lexically_normal();
+    return normalized_path;
+}
+
+/**
+ * \brief Read a text file, return false if the file could not be read.
+ */
+static bool ReadHeaderTextFile(const std::filesystem::path& path, std::string& text)
+{
+    std::ifstream file(path);
+    if (!file) return false;
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    text = buffer.str();
+    return true;
+}
+
+/**
+ * \brief Add a file to the dependencies of the header and return true if the file exists.
+ */
+static bool TrackHeaderFile(HeaderResolveState& state, const std::filesystem::path& path)
+{
+    const auto dependency = L2A::UTIL::GetHeaderDependency(NormalizeHeaderPath(path));
+    if (state.tracked_files_.insert(dependency.path_).second) state.result_.dependencies_.push_back(dependency);
+    return dependency.exists_;
+}
+
+/**
+ * \brief Parse a group, e.g., "{...}", starting at position. Spaces before the group are skipped. If a group is found
+ * the position is set after the group.
+ */
+static bool ParseHeaderGroup(
+    const std::string& text, size_t& position, const char open, const char close, std::string& content)
+{
+    size_t group_start = position;
+    while (group_start < text.size() && (text[group_start] == ' ' || text[group_start] == '\t')) group_start++;
+    if (group_start >= text.size() || text[group_start] != open) return false;
+    const size_t group_end = text.find(close, group_start + 1);
+    if (group_end == std::string::npos) return false;
+    content = text.substr(group_start + 1, group_end - group_start - 1);
+    position = group_end + 1;
+    return true;
+}
+
+/**
+ * \brief Remove leading and trailing whitespace.
+ */
+static std::string TrimHeaderArgument(const std::string& argument)
+{
+    const size_t first = argument.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) return "";
+    const size_t last = argument.find_last_not_of(" \t\r\n");
+    return argument.substr(first, last - first + 1);
+}
+
+// Forward declaration.
+static std::string ResolveHeaderText(
+    const std::string& text, const std::filesystem::path& directory, HeaderResolveState& state);
+
+/**
+ * \brief Resolve an \input or \include command. If the file does not exist, the command is returned.
+ */
+static std::string ResolveHeaderInput(const std::string& command, const std::string& argument, const bool is_include,
+    const std::filesystem::path& directory, HeaderResolveState& state)
+{
+    // \include always adds the extension, \input first tries the name with the extension.
+    const std::string file_name = TrimHeaderArgument(argument);
+    std::vector<std::string> candidates;
+    if (is_include || std::filesystem::u8path(file_name).extension().empty()) candidates.push_back(file_name + ".tex");
+    if (!is_include) candidates.push_back(file_name);
+
+    for (const auto& candidate : candidates)
+    {
+        const std::filesystem::path input_path = directory / std::filesystem::u8path(candidate);
+        if (!TrackHeaderFile(state, input_path)) continue;
+
+        const std::filesystem::path normalized_path = NormalizeHeaderPath(input_path);
+        for (size_t i_stack = 0; i_stack < state.stack_.size(); i_stack++)
+        {
+            if (state.stack_[i_stack] != normalized_path) continue;
+            state.result_.cycle_.assign(state.stack_.begin() + i_stack, state.stack_.end());
+            state.result_.cycle_.push_back(normalized_path);
+            return command;
+        }
+
+        std::string input_text;
+        if (!ReadHeaderTextFile(normalized_path, input_text)) return command;
+        state.stack_.push_back(normalized_path);
+        const std::string resolved_text = ResolveHeaderText(input_text, normalized_path.parent_path(), state);
+        state.stack_.pop_back();
+        return resolved_text;
+    }
+    return command;
+}
+
+/**
+ * \brief Check if a package exists as local file. If so, add it to the local packages and scan it for dependencies.
+ */
+static void ScanHeaderPackage(const std::string& package_name, HeaderResolveState& state)
+{
+    const std::filesystem::path relative_path = std::filesystem::u8path(package_name + ".sty");
+    const std::filesystem::path package_path = state.header_directory_ / relative_path;
+    if (!TrackHeaderFile(state, package_path)) return;
+
+    // Packages are only loaded once by LaTeX, so packages that load each other are not a cycle.
+    const std::filesystem::path normalized_path = NormalizeHeaderPath(package_path);
+    if (!state.scanned_packages_.insert(normalized_path).second) return;
+    const size_t package_index = state.result_.local_packages_.size();
+    state.result_.local_packages_.push_back({normalized_path, relative_path, ""});
+
+    std::string package_text;
+    if (!ReadHeaderTextFile(normalized_path, package_text)) return;
+    state.stack_.push_back(normalized_path);
+    std::string resolved_text = ResolveHeaderText(package_text, normalized_path.parent_path(), state);
+    state.stack_.pop_back();
+
+    // The vector of packages can grow while the package is resolved.
+    state.result_.local_packages_[package_index].text_ = std::move(resolved_text);
+}
+
+/**
+ * \brief Resolve the inputs in a text and scan it for local packages.
+ */
+static std::string ResolveHeaderText(
+    const std::string& text, const std::filesystem::path& directory, HeaderResolveState& state)
+{
+    std::string resolved_text;
+    resolved_text.reserve(text.size());
+    size_t position = 0;
+    while (position < text.size())
+    {
+        const char character = text[position];
+        if (character == '%')
+        {
+            // Comments are not resolved.
+            size_t line_end = text.find('\n', position);
+            if (line_end == std::string::npos) line_end = text.size();
+            resolved_text.append(text, position, line_end - position);
+            position = line_end;
+            continue;
+        }
+        else if (character != '\\')
+        {
+            resolved_text += character;
+            position++;
+            continue;
+        }
+
+        // Get the name of the command.
+        size_t name_end = position + 1;
+        while (name_end < text.size() && std::isalpha((unsigned char)text[name_end])) name_end++;
+        if (name_end == position + 1)
+        {
+            // Control symbols, e.g., "\%", are copied as they are.
+            resolved_text.append(text, position, 2);
+            position += 2;
+            continue;
+        }
+        const std::string name = text.substr(position + 1, name_end - position - 1);
+
+        size_t argument_end = name_end;
+        std::string argument;
+        if ((name == "input" || name == "include") && ParseHeaderGroup(text, argument_end, '{', '}', argument))
+        {
+            const std::string command = text.substr(position, argument_end - position);
+            resolved_text += ResolveHeaderInput(command, argument, name == "include", directory, state);
+            position = argument_end;
+            continue;
+        }
+        else if (name == "usepackage" || name == "RequirePackage")
+        {
+            std::string options;
+            ParseHeaderGroup(text, argument_end, '[', ']', options);
+            if (ParseHeaderGroup(text, argument_end, '{', '}', argument))
+            {
+                std::stringstream package_names(argument);
+                std::string package_name;
+                while (std::getline(package_names, package_name, ','))
+                {
+                    package_name = TrimHeaderArgument(package_name);
+                    if (!package_name.empty()) ScanHeaderPackage(package_name, state);
+                }
+            }
+            resolved_text.append(text, position, argument_end - position);
+            position = argument_end;
+            continue;
+        }
+
+        resolved_text.append(text, position, name_end - position);
+        position = name_end;
+    }
+    return resolved_text;
+}
+
+/**
+ * \brief Set the digest of a resolved header.
+ */
+static void SetResolvedHeaderDigest(L2A::UTIL::ResolvedHeader& result)
+{
+    // The digest also contains the local packages, since they are not part of the resolved text.
+    std::string digest_input = result.text_;
+    for (const auto& package : result.local_packages_)
+        digest_input += "\n" + package.relative_path_.u8string() + "\n" + package.text_;
+    result.digest_ = L2A::UTIL::GetStringHash(digest_input);
+}
+
+/**
+ *
+ */
+const L2A::UTIL::ResolvedHeader& L2A::UTIL::HeaderResolver::Resolve(const std::filesystem::path& header_path)
+{
+    const std::filesystem::path normalized_path = NormalizeHeaderPath(header_path);
+
+    // Return the cached header if none of the files it depends on changed.
+    auto it = cache_.find(normalized_path);
+    if (it != cache_.end())
+    {
+        bool is_up_to_date = true;
+        for (const auto& dependency : it->second.dependencies_)
+        {
+            if (!(GetHeaderDependency(dependency.path_) == dependency))
+            {
+                is_up_to_date = false;
+                break;
+            }
+        }
+        if (is_up_to_date)
+        {
+            statistics_.n_cached_++;
+            GetMetrics().Increment("header_cache_hits");
+            return it->second;
+        }
+    }
+
+    ResolvedHeader result;
+    HeaderResolveState state(result, normalized_path.parent_path());
+    std::string header_text;
+    if (TrackHeaderFile(state, normalized_path) && ReadHeaderTextFile(normalized_path, header_text))
+    {
+        state.stack_.push_back(normalized_path);
+        result.text_ = ResolveHeaderText(header_text, normalized_path.parent_path(), state);
+    }
+
+    SetResolvedHeaderDigest(result);
+
+    statistics_.n_resolved_++;
+    GetMetrics().Increment("header_cache_misses");
+    return cache_[normalized_path] = std::move(result);
+}
+
+/**
+ *
+ */
+L2A::UTIL::ResolvedHeader L2A::UTIL::HeaderResolver::ResolveText(
+    const std::string& header_text, const std::filesystem::path& header_directory)
+{
+    const std::filesystem::path normalized_directory = NormalizeHeaderPath(header_directory);
+
+    ResolvedHeader result;
+    HeaderResolveState state(result, normalized_directory);
+    result.text_ = ResolveHeaderText(header_text, normalized_directory, state);
+    SetResolvedHeaderDigest(result);
+
+    statistics_.n_resolved_++;
+    return result;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::HeaderWatcher::Watch(const std::vector<HeaderDependency>& dependencies)
+{
+    dependencies_ = dependencies;
+    pending_dependencies_.clear();
+}
+
+/**
+ *
+ */
+void L2A::UTIL::HeaderWatcher::Clear()
+{
+    dependencies_.clear();
+    pending_dependencies_.clear();
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::HeaderWatcher::Poll()
+{
+    std::vector<HeaderDependency> current_dependencies;
+    current_dependencies.reserve(dependencies_.size());
+    for (const auto& dependency : dependencies_) current_dependencies.push_back(GetHeaderDependency(dependency.path_));
+
+    if (current_dependencies == dependencies_)
+    {
+        pending_dependencies_.clear();
+        return false;
+    }
+    else if (current_dependencies == pending_dependencies_)
+    {
+        // The files changed and are stable now.
+        dependencies_.swap(current_dependencies);
+        pending_dependencies_.clear();
+        return true;
+    }
+    else
+    {
+        pending_dependencies_.swap(current_dependencies);
+        return false;
+    }
+}
+
+/**
+ *
+ */
+L2A::UTIL::HeaderDependency L2A::UTIL::GetHeaderDependency(const std::filesystem::path& path)
+{
+    HeaderDependency dependency;
+    dependency.path_ = path;
+    std::error_code error_code;
+    dependency.exists_ = std::filesystem::is_regular_file(path, error_code);
+    if (!dependency.exists_) return dependency;
+    dependency.size_ = std::filesystem::file_size(path, error_code);
+    dependency.write_time_ = std::filesystem::last_write_time(path, error_code).time_since_epoch().count();
+    return dependency;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::WriteFileIfChanged(const std::filesystem::path& path, const std::string& contents)
+{
+    std::string existing_contents;
+    std::error_code error_code;
+    if (std::filesystem::is_regular_file(path, error_code) && ReadHeaderTextFile(path, existing_contents) &&
+        existing_contents == contents)
+        return false;
+
+    std::ofstream file(path, std::ios::trunc);
+    file << contents;
+    file.close();
+    if (file.fail()) throw std::runtime_error("Could not write the file '" + path.u8string() + "'");
+    return true;
+}
@@ -0,0 +1,214 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Resolve the LaTeX header of a document and cache the result as long as the included files do not change.
+ */
+
+#ifndef UTIL_HEADER_RESOLVER_H_
+#define UTIL_HEADER_RESOLVER_H_
+
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief File the resolved header depends on.
+         */
+        struct HeaderDependency
+        {
+            //! Path to the file.
+            std::filesystem::path path_;
+
+            //! Flag if the file existed. Missing files are also tracked, since creating them changes the header.
+            bool exists_ = false;
+
+            //! Size of the file.
+            std::uintmax_t size_ = 0;
+
+            //! Last write time of the file.
+            std::int64_t write_time_ = 0;
+
+            /**
+             * \brief Check if two states of a file are equal.
+             */
+            bool operator==(const HeaderDependency& other) const
+            {
+                return path_ == other.path_ && exists_ == other.exists_ && size_ == other.size_ &&
+                       write_time_ == other.write_time_;
+            }
+        };
+
+        /**
+         * \brief Local package that is used in the header and has to be placed next to the header for the compilation.
+         */
+        struct LocalPackage
+        {
+            //! Path to the package file.
+            std::filesystem::path path_;
+
+            //! Path of the package file relative to the header.
+            std::filesystem::path relative_path_;
+
+            //! Text of the package with the contents of all \input and \include files.
+            std::string text_;
+        };
+
+        /**
+         * \brief A header where all inputs are resolved.
+         */
+        struct ResolvedHeader
+        {
+            //! Text of the header with the contents of all \input and \include files.
+            std::string text_;
+
+            //! Digest of the resolved text and the contents of the local packages.
+            std::string digest_;
+
+            //! All files the resolved header depends on.
+            std::vector<HeaderDependency> dependencies_;
+
+            //! Local packages used in the header.
+            std::vector<LocalPackage> local_packages_;
+
+            //! If the inputs contain a cycle, this contains the files in the cycle. The input that closes the cycle is
+            //! not resolved.
+            std::vector<std::filesystem::path> cycle_;
+        };
+
+        /**
+         * \brief Statistics of the header resolver.
+         */
+        struct HeaderResolverStatistics
+        {
+            //! Number of times a header was resolved from the files.
+            size_t n_resolved_ = 0;
+
+            //! Number of times the cached result was returned.
+            size_t n_cached_ = 0;
+        };
+
+        /**
+         * \brief Resolve LaTeX headers and cache the results.
+         *
+         * The header text is scanned for \input, \include, \usepackage and \RequirePackage. Commented parts are not
+         * resolved. Files in \input and \include are inserted into the header, if they exist relative to the including
+         * file. Otherwise the command is kept, so LaTeX can find the file in its own search paths. Packages that exist
+         * as .sty file relative to the header are local packages, their inputs are also resolved. All files
+         * that were looked at are tracked, and a cached result is returned as long as none of them changed.
+         */
+        class HeaderResolver
+        {
+           public:
+            /**
+             * \brief Get the resolved header.
+             */
+            const ResolvedHeader& Resolve(const std::filesystem::path& header_path);
+
+            /**
+             * \brief Resolve a header text that is not (yet) stored in a file. The result is the same as for a header
+             * file in the given directory with this text, but it is not cached.
+             */
+            ResolvedHeader ResolveText(const std::string& header_text, const std::filesystem::path& header_directory);
+
+            /**
+             * \brief Clear the cached headers.
+             */
+            void Clear() { cache_.clear(); }
+
+            /**
+             * \brief Get the statistics of the resolver.
+             */
+            const HeaderResolverStatistics& GetStatistics() const { return statistics_; }
+
+           private:
+            //! Resolved headers.
+            std::map<std::filesystem::path, ResolvedHeader> cache_;
+
+            //! Statistics of the resolver.
+            HeaderResolverStatistics statistics_;
+        };
+
+        /**
+         * \brief Watch the files a header depends on by polling their status.
+         *
+         * Editors often write a file in several steps, therefore a change is only reported once the files did not
+         * change between two polls.
+         */
+        class HeaderWatcher
+        {
+           public:
+            /**
+             * \brief Start to watch the given files. Changes before this call are not reported.
+             */
+            void Watch(const std::vector<HeaderDependency>& dependencies);
+
+            /**
+             * \brief Stop watching the files.
+             */
+            void Clear();
+
+            /**
+             * \brief Check if files are watched.
+             */
+            bool IsWatching() const { return !dependencies_.empty(); }
+
+            /**
+             * \brief Check the status of the watched files.
+             * @return True if the files changed and did not change since the last poll. A change is only reported
+             * once.
+             */
+            bool Poll();
+
+           private:
+            //! Status of the watched files at the last reported change.
+            std::vector<HeaderDependency> dependencies_;
+
+            //! Status of the watched files at the last poll, if it differs from the last reported change.
+            std::vector<HeaderDependency> pending_dependencies_;
+        };
+
+        /**
+         * \brief Get the current status of a file the header depends on.
+         */
+        HeaderDependency GetHeaderDependency(const std::filesystem::path& path);
+
+        /**
+         * \brief Write a text file, if it does not already have the given contents. An exception is thrown if the file
+         * could not be written.
+         * @return True if the file was written.
+         */
+        bool WriteFileIfChanged(const std::filesystem::path& path, const std::string& contents);
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
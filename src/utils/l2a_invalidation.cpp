@@ -0,0 +1,116 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Functions to find the parts of the document that have to be redrawn by the annotator.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_invalidation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+
+/**
+ * \brief Check if two item states are drawn the same way.
+ */
+bool IsSameDrawnState(const L2A::UTIL::DrawnItemState& state_a, const L2A::UTIL::DrawnItemState& state_b,
+    const AIReal eps)
+{
+    if (state_a.values_.size() != state_b.values_.size()) return false;
+    for (size_t i = 0; i < state_a.values_.size(); i++)
+        if (std::abs(state_a.values_[i] - state_b.values_[i]) > eps) return false;
+
+    const auto& bounds_a = state_a.bounds_;
+    const auto& bounds_b = state_b.bounds_;
+    return std::abs(bounds_a.left - bounds_b.left) <= eps && std::abs(bounds_a.right - bounds_b.right) <= eps &&
+           std::abs(bounds_a.top - bounds_b.top) <= eps && std::abs(bounds_a.bottom - bounds_b.bottom) <= eps;
+}
+
+/**
+ *
+ */
+AIRealRect L2A::UTIL::GetRectUnion(const AIRealRect& rect_a, const AIRealRect& rect_b)
+{
+    AIRealRect rect_union;
+    rect_union.left = std::min(rect_a.left, rect_b.left);
+    rect_union.right = std::max(rect_a.right, rect_b.right);
+    rect_union.bottom = std::min(rect_a.bottom, rect_b.bottom);
+    rect_union.top = std::max(rect_a.top, rect_b.top);
+    return rect_union;
+}
+
+/**
+ *
+ */
+AIReal L2A::UTIL::GetRectArea(const AIRealRect& rect)
+{
+    return std::abs(rect.right - rect.left) * std::abs(rect.top - rect.bottom);
+}
+
+/**
+ *
+ */
+std::vector<AIRealRect> L2A::UTIL::GetChangedBounds(const std::vector<DrawnItemState>& old_states,
+    const std::vector<DrawnItemState>& new_states, const AIReal eps, const size_t max_rects)
+{
+    // Map the art handles of the old states to their position in the vector.
+    std::unordered_map<AIArtHandle, size_t> old_state_ids;
+    old_state_ids.reserve(old_states.size());
+    for (size_t i = 0; i < old_states.size(); i++) old_state_ids[old_states[i].art_] = i;
+    std::vector<bool> old_state_found(old_states.size(), false);
+
+    // Compare the new states to the old ones.
+    std::vector<AIRealRect> changed_bounds;
+    for (const auto& new_state : new_states)
+    {
+        const auto it = old_state_ids.find(new_state.art_);
+        if (it == old_state_ids.end())
+            changed_bounds.push_back(new_state.bounds_);
+        else
+        {
+            const auto& old_state = old_states[it->second];
+            old_state_found[it->second] = true;
+            if (!IsSameDrawnState(old_state, new_state, eps))
+                changed_bounds.push_back(GetRectUnion(old_state.bounds_, new_state.bounds_));
+        }
+    }
+
+    // Items that do not exist anymore.
+    for (size_t i = 0; i < old_states.size(); i++)
+        if (!old_state_found[i]) changed_bounds.push_back(old_states[i].bounds_);
+
+    // Merge the rectangles if there are too many.
+    if (changed_bounds.size() > max_rects)
+    {
+        AIRealRect merged_bounds = changed_bounds[0];
+        for (const auto& bounds : changed_bounds) merged_bounds = GetRectUnion(merged_bounds, bounds);
+        changed_bounds = {merged_bounds};
+    }
+    return changed_bounds;
+}
@@ -0,0 +1,99 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Functions to find the parts of the document that have to be redrawn by the annotator.
+ */
+
+#ifndef UTIL_INVALIDATION_H_
+#define UTIL_INVALIDATION_H_
+
+
+#include "IllustratorSDK.h"
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief State of one item as it is drawn by the annotator.
+         */
+        struct DrawnItemState
+        {
+            //! Art handle of the item, used to match the states before and after a change.
+            AIArtHandle art_;
+
+            //! Artwork bounding box of the drawn item.
+            AIRealRect bounds_;
+
+            //! All values that influence the drawing of the item, e.g., the placement points and the state flags.
+            std::vector<AIReal> values_;
+        };
+
+        /**
+         * \brief Statistics of the invalidations of the annotator.
+         */
+        struct InvalidationStatistics
+        {
+            //! Number of handled events.
+            size_t n_events_ = 0;
+
+            //! Number of events where nothing had to be invalidated.
+            size_t n_skipped_events_ = 0;
+
+            //! Total number of invalidated rectangles.
+            size_t n_rects_ = 0;
+
+            //! Invalidated area of the last event (in view coordinates).
+            AIReal last_event_area_ = 0.0;
+
+            //! Total invalidated area of all events (in view coordinates).
+            AIReal total_area_ = 0.0;
+        };
+
+        /**
+         * \brief Get the smallest rectangle that contains both rectangles (artwork convention, i.e., top >= bottom).
+         */
+        AIRealRect GetRectUnion(const AIRealRect& rect_a, const AIRealRect& rect_b);
+
+        /**
+         * \brief Get the area of a rectangle, independent of the orientation of the vertical axis.
+         */
+        AIReal GetRectArea(const AIRealRect& rect);
+
+        /**
+         * \brief Get the artwork rectangles that have to be redrawn when the drawn items change from old_states to
+         * new_states.
+         *
+         * For an item that changed, the union of the old and the new bounds is returned. Removed items return their
+         * old bounds and added items their new bounds. Unchanged items do not return anything. If more than max_rects
+         * rectangles are found, a single rectangle containing all of them is returned.
+         */
+        std::vector<AIRealRect> GetChangedBounds(const std::vector<DrawnItemState>& old_states,
+            const std::vector<DrawnItemState>& new_states, const AIReal eps, const size_t max_rects);
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
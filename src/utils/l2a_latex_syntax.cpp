@@ -0,0 +1,390 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Check the LaTeX code of items for structural errors before it is compiled.
+ */
+
+
+#include "l2a_latex_syntax.h"
+
+#include <map>
+#include <set>
+#include <vector>
+
+
+/**
+ * \brief Group that is opened in the LaTeX code and has to be closed, e.g., a brace or an environment.
+ */
+struct LatexSyntaxGroup
+{
+    //! Text that opens the group, e.g., "{" or "\begin{align}".
+    std::string opener_;
+
+    //! Text that closes the group.
+    std::string closer_;
+
+    //! Offset of the opener in the code.
+    size_t offset_;
+};
+
+/**
+ * \brief Check if a character is a letter in the sense of TeX, i.e., it can be part of a control word.
+ */
+bool IsLatexLetter(const char character)
+{
+    return (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z');
+}
+
+/**
+ * \brief Check if a byte is the first byte of a UTF-8 character.
+ */
+bool IsLatexCharacterStart(const char character) { return (character & 0xC0) != 0x80; }
+
+/**
+ * \brief Get the end of the control sequence that starts with the backslash at the given position. The name is empty
+ * if the code ends with the backslash.
+ */
+size_t ReadLatexControlSequence(const std::string& code, const size_t position, std::string& name)
+{
+    size_t end = position + 1;
+    if (end >= code.size())
+    {
+        name.clear();
+        return end;
+    }
+    if (IsLatexLetter(code[end]))
+        while (end < code.size() && IsLatexLetter(code[end])) end++;
+    else
+        end++;
+    name = code.substr(position + 1, end - position - 1);
+    return end;
+}
+
+/**
+ * \brief Skip white space and comments.
+ */
+size_t SkipLatexSpaces(const std::string& code, size_t position)
+{
+    while (position < code.size())
+    {
+        if (code[position] == '%')
+        {
+            position = code.find('\n', position);
+            if (position == std::string::npos) return code.size();
+        }
+        else if (code[position] != ' ' && code[position] != '\t' && code[position] != '\n' && code[position] != '\r')
+            return position;
+        position++;
+    }
+    return position;
+}
+
+/**
+ * \brief Get the position after the brace that closes the group opened at the given position, or npos if the group is
+ * not closed.
+ */
+size_t FindLatexGroupEnd(const std::string& code, size_t position)
+{
+    size_t depth = 0;
+    while (position < code.size())
+    {
+        const char character = code[position];
+        if (character == '\\')
+            position++;
+        else if (character == '%')
+        {
+            position = code.find('\n', position);
+            if (position == std::string::npos) return std::string::npos;
+        }
+        else if (character == '{')
+            depth++;
+        else if (character == '}' && --depth == 0)
+            return position + 1;
+        position++;
+    }
+    return std::string::npos;
+}
+
+/**
+ * \brief Read the name of an environment after \begin or \end.
+ * @return The position after the name, or npos if there is no name.
+ */
+size_t ReadLatexEnvironmentName(const std::string& code, const size_t position, std::string& name)
+{
+    const size_t start = SkipLatexSpaces(code, position);
+    if (start >= code.size() || code[start] != '{') return std::string::npos;
+    const size_t end = code.find('}', start);
+    if (end == std::string::npos || end == start + 1) return std::string::npos;
+    name = code.substr(start + 1, end - start - 1);
+    return end + 1;
+}
+
+/**
+ * \brief Check that the arguments of a command are given.
+ * @param position Position after the command.
+ * @param message Error message if an argument is missing.
+ * @return The position after the arguments, or npos if an argument is missing.
+ */
+size_t CheckLatexArguments(const std::string& code, size_t position, const unsigned int n_arguments,
+    const bool has_optional_argument, const std::string& command, std::string& message)
+{
+    if (has_optional_argument)
+    {
+        const size_t start = SkipLatexSpaces(code, position);
+        if (start < code.size() && code[start] == '[')
+        {
+            position = code.find(']', start);
+            if (position == std::string::npos)
+            {
+                message = "Missing ] in the optional argument of \\" + command;
+                return std::string::npos;
+            }
+            position++;
+        }
+    }
+
+    for (unsigned int i_argument = 0; i_argument < n_arguments; i_argument++)
+    {
+        // An argument is either a group, a control sequence or a single character.
+        position = SkipLatexSpaces(code, position);
+        if (position >= code.size() || std::string("}$&#^_").find(code[position]) != std::string::npos)
+        {
+            message = "Missing argument of \\" + command;
+            return std::string::npos;
+        }
+        if (code[position] == '{')
+        {
+            position = FindLatexGroupEnd(code, position);
+            if (position == std::string::npos)
+            {
+                message = "Missing } in an argument of \\" + command;
+                return std::string::npos;
+            }
+        }
+        else if (code[position] == '\\')
+        {
+            std::string name;
+            position = ReadLatexControlSequence(code, position, name);
+        }
+        else
+        {
+            position++;
+            while (position < code.size() && !IsLatexCharacterStart(code[position])) position++;
+        }
+    }
+    return position;
+}
+
+/**
+ * \brief Set the position of a syntax error in the code.
+ */
+void SetLatexSyntaxError(
+    const std::string& code, const size_t offset, const std::string& message, L2A::UTIL::LatexSyntaxError& error)
+{
+    error.offset_ = offset;
+    error.character_offset_ = 0;
+    error.line_ = 1;
+    error.column_ = 1;
+    for (size_t i = 0; i < offset && i < code.size(); i++)
+    {
+        if (!IsLatexCharacterStart(code[i])) continue;
+        error.character_offset_++;
+        if (code[i] == '\n')
+        {
+            error.line_++;
+            error.column_ = 1;
+        }
+        else
+            error.column_++;
+    }
+    error.message_ = message;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::CheckLatexSyntax(const std::string& latex_code, LatexSyntaxError& error)
+{
+    // Commands that change how the code is tokenized or define new commands. The code can not be checked without TeX if
+    // it contains one of them.
+    static const std::set<std::string> unchecked_commands = {"catcode", "def", "edef", "gdef", "xdef", "let",
+        "newcommand", "renewcommand", "providecommand", "newenvironment", "renewenvironment", "NewDocumentCommand",
+        "DeclareRobustCommand", "makeatletter", "csname"};
+
+    // Environments whose contents are not tokenized.
+    static const std::set<std::string> verbatim_environments = {
+        "verbatim", "verbatim*", "Verbatim", "lstlisting", "minted", "comment"};
+
+    // Commands with mandatory arguments, and if they have an optional argument before them.
+    static const std::map<std::string, std::pair<unsigned int, bool>> argument_commands = {{"frac", {2, false}},
+        {"dfrac", {2, false}}, {"tfrac", {2, false}}, {"cfrac", {2, true}}, {"binom", {2, false}},
+        {"dbinom", {2, false}}, {"tbinom", {2, false}}, {"overset", {2, false}}, {"underset", {2, false}},
+        {"stackrel", {2, false}}, {"sqrt", {1, true}}};
+
+    std::vector<LatexSyntaxGroup> groups;
+    auto set_error = [&](const size_t offset, const std::string& message)
+    {
+        SetLatexSyntaxError(latex_code, offset, message, error);
+        return false;
+    };
+    auto open_group = [&](const std::string& opener, const std::string& closer, const size_t offset)
+    { groups.push_back({opener, closer, offset}); };
+    auto close_group = [&](const std::string& opener, const std::string& closer, const size_t offset)
+    {
+        if (groups.empty()) return set_error(offset, closer + " has no matching " + opener);
+        if (groups.back().closer_ != closer)
+            return set_error(offset, "Missing " + groups.back().closer_ + " before " + closer);
+        groups.pop_back();
+        return true;
+    };
+
+    size_t position = 0;
+    while (position < latex_code.size())
+    {
+        const char character = latex_code[position];
+        if (character == '%')
+        {
+            position = latex_code.find('\n', position);
+            if (position == std::string::npos) break;
+            position++;
+        }
+        else if (character == '{')
+        {
+            open_group("{", "}", position);
+            position++;
+        }
+        else if (character == '}')
+        {
+            if (!close_group("{", "}", position)) return false;
+            position++;
+        }
+        else if (character == '$')
+        {
+            // Inline math is closed by a single $, display math by $$. Math can only be started again inside a
+            // group, e.g., in the argument of \text, but not between \left and \right.
+            const bool is_double = position + 1 < latex_code.size() && latex_code[position + 1] == '$';
+            if (!groups.empty() && groups.back().opener_ == "\\left")
+                return set_error(position, "Missing \\right before $");
+            else if (!groups.empty() && groups.back().opener_ == "$")
+                groups.pop_back();
+            else if (!groups.empty() && groups.back().opener_ == "$$")
+            {
+                if (!is_double) return set_error(position, "Display math has to be closed with $$");
+                groups.pop_back();
+                position++;
+            }
+            else
+            {
+                open_group(is_double ? "$$" : "$", is_double ? "$$" : "$", position);
+                if (is_double) position++;
+            }
+            position++;
+        }
+        else if (character == '\\')
+        {
+            std::string name;
+            const size_t command_end = ReadLatexControlSequence(latex_code, position, name);
+            if (name.empty()) return set_error(position, "The code must not end with \\");
+            if (unchecked_commands.find(name) != unchecked_commands.end()) return true;
+
+            if (name == "(")
+                open_group("\\(", "\\)", position);
+            else if (name == "[")
+                open_group("\\[", "\\]", position);
+            else if (name == ")" || name == "]")
+            {
+                if (!close_group(name == ")" ? "\\(" : "\\[", "\\" + name, position)) return false;
+            }
+            else if (name == "left")
+                open_group("\\left", "\\right", position);
+            else if (name == "right")
+            {
+                if (!close_group("\\left", "\\right", position)) return false;
+            }
+            else if (name == "begin" || name == "end")
+            {
+                std::string environment;
+                const size_t environment_end = ReadLatexEnvironmentName(latex_code, command_end, environment);
+                if (environment_end == std::string::npos)
+                    return set_error(position, "Missing environment name after \\" + name);
+                const std::string begin = "\\begin{" + environment + "}";
+                const std::string end = "\\end{" + environment + "}";
+                if (name == "end")
+                {
+                    if (!close_group(begin, end, position)) return false;
+                }
+                else if (verbatim_environments.find(environment) != verbatim_environments.end())
+                {
+                    const size_t verbatim_end = latex_code.find(end, environment_end);
+                    if (verbatim_end == std::string::npos) return set_error(position, begin + " is not closed");
+                    position = verbatim_end + end.size();
+                    continue;
+                }
+                else
+                    open_group(begin, end, position);
+                position = environment_end;
+                continue;
+            }
+            else if (name == "verb")
+            {
+                // The argument of \verb is delimited by the character after the command, on the same line.
+                size_t delimiter = command_end;
+                if (delimiter < latex_code.size() && latex_code[delimiter] == '*') delimiter++;
+                if (delimiter >= latex_code.size()) return set_error(position, "\\verb is not closed");
+                const size_t verb_end =
+                    latex_code.find_first_of(std::string(1, latex_code[delimiter]) + "\n", delimiter + 1);
+                if (verb_end == std::string::npos || latex_code[verb_end] == '\n')
+                    return set_error(position, "\\verb is not closed");
+                position = verb_end + 1;
+                continue;
+            }
+            else
+            {
+                const auto argument_command = argument_commands.find(name);
+                if (argument_command != argument_commands.end())
+                {
+                    std::string message;
+                    if (CheckLatexArguments(latex_code, command_end, argument_command->second.first,
+                            argument_command->second.second, name, message) == std::string::npos)
+                        return set_error(position, message);
+                }
+            }
+            position = command_end;
+        }
+        else
+            position++;
+    }
+
+    if (!groups.empty()) return set_error(groups.back().offset_, groups.back().opener_ + " is not closed");
+    return true;
+}
+
+/**
+ *
+ */
+std::string L2A::UTIL::GetLatexSyntaxErrorText(const LatexSyntaxError& error)
+{
+    return "Line " + std::to_string(error.line_) + ", column " + std::to_string(error.column_) + ": " + error.message_;
+}
@@ -0,0 +1,77 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Check the LaTeX code of items for structural errors before it is compiled.
+ */
+
+#ifndef UTIL_LATEX_SYNTAX_H_
+#define UTIL_LATEX_SYNTAX_H_
+
+
+#include <string>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Structural error found in the LaTeX code of an item.
+         */
+        struct LatexSyntaxError
+        {
+            //! Offset of the error in the code in bytes.
+            size_t offset_ = 0;
+
+            //! Offset of the error in the code in characters, this is the cursor position in the item form.
+            size_t character_offset_ = 0;
+
+            //! Line and column of the error, starting with 1. The column is counted in characters.
+            size_t line_ = 0;
+            size_t column_ = 0;
+
+            //! Description of the error.
+            std::string message_;
+        };
+
+        /**
+         * \brief Check the LaTeX code of an item for errors that can be found without TeX, i.e., unbalanced braces,
+         * math delimiters and environments, a stray \end or missing arguments of commands like \frac.
+         *
+         * The check only looks at the tokens of the code and does not know the commands defined in the header. If the
+         * code defines commands or changes category codes, it is not checked.
+         * @param error The first error found in the code.
+         * @return False if an error was found.
+         */
+        bool CheckLatexSyntax(const std::string& latex_code, LatexSyntaxError& error);
+
+        /**
+         * \brief Get the text of a syntax error that is shown to the user, including the line and column.
+         */
+        std::string GetLatexSyntaxErrorText(const LatexSyntaxError& error);
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
@@ -0,0 +1,270 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Functions to maintain the folder with the PDF files of the LaTeX2AI items.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_links_folder.h"
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <unordered_set>
+
+#define CRCPP_USE_CPP11
+#define CRCPP_INCLUDE_ESOTERIC_CRC_DEFINITIONS
+#include "CRC.h"
+
+
+//! First line of the links manifest file, it also contains the version of the file format.
+static const char* links_manifest_header_ = "LaTeX2AI links manifest 2";
+
+
+/**
+ * \brief Convert ASCII upper case characters to lower case, all other characters are not changed.
+ */
+char ToLowerASCII(const char character)
+{
+    if (character >= 'A' && character <= 'Z') return character - 'A' + 'a';
+    return character;
+}
+
+/**
+ *
+ */
+L2A::UTIL::PrefixTrie::PrefixTrie() : nodes_(1) {}
+
+/**
+ *
+ */
+void L2A::UTIL::PrefixTrie::Insert(const std::string& prefix)
+{
+    size_t node_id = 0;
+    for (const char character : prefix)
+    {
+        const char key = ToLowerASCII(character);
+        size_t child_id = GetChild(node_id, key);
+        if (child_id == 0)
+        {
+            child_id = nodes_.size();
+            nodes_[node_id].children_.push_back({key, child_id});
+            nodes_.emplace_back();
+        }
+        node_id = child_id;
+    }
+    nodes_[node_id].is_end_ = true;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::PrefixTrie::HasPrefixOf(const std::string& string) const
+{
+    size_t node_id = 0;
+    if (nodes_[node_id].is_end_) return true;
+    for (const char character : string)
+    {
+        node_id = GetChild(node_id, ToLowerASCII(character));
+        if (node_id == 0) return false;
+        if (nodes_[node_id].is_end_) return true;
+    }
+    return false;
+}
+
+/**
+ *
+ */
+size_t L2A::UTIL::PrefixTrie::GetChild(const size_t node_id, const char character) const
+{
+    // The number of children per node is small, so a linear search is sufficient.
+    for (const auto& child : nodes_[node_id].children_)
+        if (child.first == character) return child.second;
+    return 0;
+}
+
+/**
+ *
+ */
+std::vector<size_t> L2A::UTIL::GetUnusedLinkFiles(const std::vector<std::string>& link_file_names,
+    const std::vector<std::string>& used_file_names, const std::vector<std::string>& other_document_prefixes)
+{
+    const std::unordered_set<std::string> used_files(used_file_names.begin(), used_file_names.end());
+
+    PrefixTrie other_documents;
+    for (const auto& prefix : other_document_prefixes) other_documents.Insert(prefix);
+
+    std::vector<size_t> unused_files;
+    for (size_t i = 0; i < link_file_names.size(); i++)
+    {
+        // The file is kept if it is used by this document or if it shares the name with another document.
+        const auto& file_name = link_file_names[i];
+        if (used_files.find(file_name) == used_files.end() && !other_documents.HasPrefixOf(file_name))
+            unused_files.push_back(i);
+    }
+    return unused_files;
+}
+
+/**
+ *
+ */
+std::uint64_t L2A::UTIL::GetDataContentHash(const char* data, const size_t size)
+{
+    return CRC::Calculate(data, size, CRC::CRC_64());
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::GetFileContentHash(const std::filesystem::path& path, std::uint64_t& content_hash)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (file.bad()) return false;
+    content_hash = GetDataContentHash(contents.data(), contents.size());
+    return true;
+}
+
+/**
+ *
+ */
+L2A::UTIL::LinksManifest::LinksManifest(const std::filesystem::path& manifest_path)
+    : manifest_path_(manifest_path), is_modified_(false)
+{
+    // Each line contains the file name, the hash, and the size, last write time and content hash of the file.
+    std::ifstream manifest_file(manifest_path_);
+    std::string line;
+    if (!std::getline(manifest_file, line) || line != links_manifest_header_) return;
+    while (std::getline(manifest_file, line))
+    {
+        std::istringstream line_stream(line);
+        std::string file_name;
+        LinksManifestEntry entry;
+        if (std::getline(line_stream, file_name, '\t') && std::getline(line_stream, entry.hash_, '\t') &&
+            line_stream >> entry.size_ >> entry.write_time_ >> entry.content_hash_)
+            entries_[file_name] = entry;
+    }
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::LinksManifest::IsValid(const std::string& file_name, const std::string& hash) const
+{
+    const auto it = entries_.find(file_name);
+    if (it == entries_.end() || it->second.hash_ != hash) return false;
+
+    std::uintmax_t size;
+    std::int64_t write_time;
+    if (!GetFileStatus(file_name, size, write_time)) return false;
+    return size == it->second.size_ && write_time == it->second.write_time_;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::LinksManifest::Update(const std::string& file_name, const std::string& hash)
+{
+    LinksManifestEntry entry;
+    entry.hash_ = hash;
+    if (!GetFileStatus(file_name, entry.size_, entry.write_time_) ||
+        !GetFileContentHash(manifest_path_.parent_path() / std::filesystem::u8path(file_name), entry.content_hash_))
+    {
+        Remove(file_name);
+        return;
+    }
+    entries_[file_name] = entry;
+    is_modified_ = true;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::LinksManifest::Update(
+    const std::string& file_name, const std::string& hash, const std::uint64_t content_hash)
+{
+    LinksManifestEntry entry;
+    entry.hash_ = hash;
+    entry.content_hash_ = content_hash;
+    if (!GetFileStatus(file_name, entry.size_, entry.write_time_))
+    {
+        Remove(file_name);
+        return;
+    }
+    entries_[file_name] = entry;
+    is_modified_ = true;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::LinksManifest::Remove(const std::string& file_name)
+{
+    if (entries_.erase(file_name) > 0) is_modified_ = true;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::LinksManifest::Write()
+{
+    if (!is_modified_) return true;
+
+    std::filesystem::path temp_path = manifest_path_;
+    temp_path += ".tmp";
+    {
+        std::ofstream manifest_file(temp_path, std::ios::trunc);
+        manifest_file << links_manifest_header_ << "\n";
+        for (const auto& [file_name, entry] : entries_)
+            manifest_file << file_name << "\t" << entry.hash_ << "\t" << entry.size_ << " " << entry.write_time_ << " "
+                          << entry.content_hash_ << "\n";
+        manifest_file.close();
+        if (manifest_file.fail()) return false;
+    }
+
+    // Replace the manifest with the complete temporary file.
+    std::error_code error_code;
+    std::filesystem::rename(temp_path, manifest_path_, error_code);
+    if (error_code) return false;
+    is_modified_ = false;
+    return true;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::LinksManifest::GetFileStatus(
+    const std::string& file_name, std::uintmax_t& size, std::int64_t& write_time) const
+{
+    std::error_code error_code;
+    const std::filesystem::path file_path = manifest_path_.parent_path() / std::filesystem::u8path(file_name);
+    size = std::filesystem::file_size(file_path, error_code);
+    if (error_code) return false;
+    write_time = (std::int64_t)std::filesystem::last_write_time(file_path, error_code).time_since_epoch().count();
+    return !error_code;
+}
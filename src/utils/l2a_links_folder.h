@@ -0,0 +1,206 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Functions to maintain the folder with the PDF files of the LaTeX2AI items.
+ */
+
+#ifndef UTIL_LINKS_FOLDER_H_
+#define UTIL_LINKS_FOLDER_H_
+
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Trie to check if a string starts with any of the stored prefixes.
+         *
+         * The comparison is case insensitive for ASCII characters, all other characters have to match exactly.
+         */
+        class PrefixTrie
+        {
+           public:
+            /**
+             * \brief Default constructor, creates an empty trie.
+             */
+            PrefixTrie();
+
+            /**
+             * \brief Add a prefix to the trie.
+             */
+            void Insert(const std::string& prefix);
+
+            /**
+             * \brief Check if the string starts with any of the stored prefixes.
+             */
+            bool HasPrefixOf(const std::string& string) const;
+
+           private:
+            /**
+             * \brief Node of the trie.
+             */
+            struct Node
+            {
+                //! Pairs of characters and the indices of the child nodes.
+                std::vector<std::pair<char, size_t>> children_;
+
+                //! Flag if a prefix ends at this node.
+                bool is_end_ = false;
+            };
+
+            /**
+             * \brief Get the index of the child node for a character, or 0 if the child does not exist.
+             */
+            size_t GetChild(const size_t node_id, const char character) const;
+
+           private:
+            //! Nodes of the trie, the first node is the root.
+            std::vector<Node> nodes_;
+        };
+
+        /**
+         * \brief Get the files in the links folder that are not used anymore.
+         * @param link_file_names Names of the PDF files in the links folder.
+         * @param used_file_names Names of the PDF files used by the current document.
+         * @param other_document_prefixes Prefixes of the PDF files of the other documents in the same folder.
+         * @return Indices of the unused files in link_file_names.
+         */
+        std::vector<size_t> GetUnusedLinkFiles(const std::vector<std::string>& link_file_names,
+            const std::vector<std::string>& used_file_names, const std::vector<std::string>& other_document_prefixes);
+
+        /**
+         * \brief Entry in the links manifest for one PDF file.
+         */
+        struct LinksManifestEntry
+        {
+            //! Hash of the encoded PDF contents the file was written from.
+            std::string hash_;
+
+            //! Size of the file after it was written.
+            std::uintmax_t size_ = 0;
+
+            //! Last write time of the file after it was written.
+            std::int64_t write_time_ = 0;
+
+            //! Hash of the file contents after it was written.
+            std::uint64_t content_hash_ = 0;
+        };
+
+        /**
+         * \brief Get the hash of the contents of a file as it is stored in the manifest.
+         */
+        std::uint64_t GetDataContentHash(const char* data, const size_t size);
+
+        /**
+         * \brief Get the hash of the contents of a file. Return false if the file could not be read.
+         */
+        bool GetFileContentHash(const std::filesystem::path& path, std::uint64_t& content_hash);
+
+        /**
+         * \brief Manifest of the PDF files written by LaTeX2AI into a links folder.
+         *
+         * The manifest stores the hash, size and last write time of each written file. With this information the
+         * integrity of a file can be checked by only looking at the file status, without reading the file. If the file
+         * was changed or replaced after it was written, the size or the last write time do not match anymore. The hash
+         * of the file contents is also stored, so the files can be scrubbed in the background.
+         */
+        class LinksManifest
+        {
+           public:
+            /**
+             * \brief Load the manifest file. If it does not exist or can not be read, the manifest is empty.
+             */
+            LinksManifest(const std::filesystem::path& manifest_path);
+
+            /**
+             * \brief Check if the file in the links folder is the one written for the given hash.
+             */
+            bool IsValid(const std::string& file_name, const std::string& hash) const;
+
+            /**
+             * \brief Set the entry of a file that was just written.
+             */
+            void Update(const std::string& file_name, const std::string& hash);
+
+            /**
+             * \brief Set the entry of a file that was just written, with the already known hash of its contents.
+             */
+            void Update(const std::string& file_name, const std::string& hash, const std::uint64_t content_hash);
+
+            /**
+             * \brief Remove the entry of a file.
+             */
+            void Remove(const std::string& file_name);
+
+            /**
+             * \brief Return the entries of the manifest.
+             */
+            const std::map<std::string, LinksManifestEntry>& GetEntries() const { return entries_; }
+
+            /**
+             * \brief Return the number of entries in the manifest.
+             */
+            size_t Size() const { return entries_.size(); }
+
+            /**
+             * \brief Return true if the manifest was changed since it was loaded or written.
+             */
+            bool IsModified() const { return is_modified_; }
+
+            /**
+             * \brief Write the manifest file, if it was changed. The file is first written to a temporary file which
+             * then replaces the manifest, so the manifest file is always complete.
+             * @return False if the manifest could not be written.
+             */
+            bool Write();
+
+           private:
+            /**
+             * \brief Get the size and last write time of a file. Return false if the file does not exist.
+             */
+            bool GetFileStatus(const std::string& file_name, std::uintmax_t& size, std::int64_t& write_time) const;
+
+           private:
+            //! Path to the manifest file.
+            std::filesystem::path manifest_path_;
+
+            //! Entries of the manifest, the keys are the file names.
+            std::map<std::string, LinksManifestEntry> entries_;
+
+            //! Flag if the manifest was changed.
+            bool is_modified_;
+        };
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
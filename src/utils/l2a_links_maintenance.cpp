@@ -0,0 +1,330 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Background worker to maintain the links folders of the documents.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_links_maintenance.h"
+
+#include "l2a_links_folder.h"
+
+#include <algorithm>
+
+
+/**
+ * \brief Check if two entries of the links manifest describe the same file.
+ */
+bool IsEqualManifestEntry(const L2A::UTIL::LinksManifestEntry& entry_a, const L2A::UTIL::LinksManifestEntry& entry_b)
+{
+    return entry_a.hash_ == entry_b.hash_ && entry_a.size_ == entry_b.size_ &&
+           entry_a.write_time_ == entry_b.write_time_ && entry_a.content_hash_ == entry_b.content_hash_;
+}
+
+/**
+ * \brief Check if a file name is a PDF file of a LaTeX2AI item, i.e., it matches the regex ".*<post_fix>.*\.pdf$".
+ */
+bool IsItemPDFFileName(const std::string& file_name, const std::string& item_post_fix)
+{
+    static const std::string extension = ".pdf";
+    const size_t post_fix_position = file_name.find(item_post_fix);
+    if (post_fix_position == std::string::npos) return false;
+    if (file_name.size() < post_fix_position + item_post_fix.size() + extension.size()) return false;
+    return file_name.compare(file_name.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+/**
+ *
+ */
+L2A::UTIL::LinksMaintenanceWorker::LinksMaintenanceWorker(const std::string& item_post_fix,
+    const std::string& manifest_name, const std::uintmax_t max_bytes_per_second, const size_t max_files_per_second)
+    : item_post_fix_(item_post_fix),
+      manifest_name_(manifest_name),
+      max_bytes_per_second_(max_bytes_per_second),
+      max_files_per_second_(max_files_per_second),
+      budget_window_start_(std::chrono::steady_clock::now()),
+      budget_window_bytes_(0),
+      budget_window_files_(0),
+      is_running_job_(false),
+      is_flushing_(false),
+      stop_(false)
+{
+}
+
+/**
+ *
+ */
+void L2A::UTIL::LinksMaintenanceWorker::Post(const LinksMaintenanceJob& job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_) return;
+
+        // A queued job for the same document is replaced, since the new job contains the current state.
+        auto it = std::find_if(jobs_.begin(), jobs_.end(), [&job](const LinksMaintenanceJob& queued_job) {
+            return queued_job.type_ == job.type_ && queued_job.links_directory_ == job.links_directory_ &&
+                   queued_job.document_path_ == job.document_path_;
+        });
+        if (it != jobs_.end())
+            *it = job;
+        else
+            jobs_.push_back(job);
+
+        if (!thread_.joinable()) thread_ = std::thread(&LinksMaintenanceWorker::Run, this);
+    }
+    condition_.notify_all();
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::LinksMaintenanceWorker::IsIdle() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return jobs_.empty() && !is_running_job_;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::LinksMaintenanceWorker::HasResults() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !results_.empty();
+}
+
+/**
+ *
+ */
+std::vector<L2A::UTIL::LinksMaintenanceResult> L2A::UTIL::LinksMaintenanceWorker::TakeResults()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<LinksMaintenanceResult> results;
+    results.swap(results_);
+    return results;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::LinksMaintenanceWorker::Flush()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    is_flushing_ = true;
+    condition_.notify_all();
+    condition_.wait(lock, [this] { return stop_ || (jobs_.empty() && !is_running_job_); });
+    is_flushing_ = false;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::LinksMaintenanceWorker::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        jobs_.clear();
+    }
+    condition_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+/**
+ *
+ */
+L2A::UTIL::LinksMaintenanceStatistics L2A::UTIL::LinksMaintenanceWorker::GetStatistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return statistics_;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::LinksMaintenanceWorker::Run()
+{
+    while (true)
+    {
+        LinksMaintenanceJob job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+            if (stop_) return;
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+            is_running_job_ = true;
+        }
+
+        LinksMaintenanceResult result;
+        result.links_directory_ = job.links_directory_;
+        try
+        {
+            switch (job.type_)
+            {
+                case LinksMaintenanceJob::Type::garbage_collection:
+                    RunGarbageCollection(job, result);
+                    break;
+                case LinksMaintenanceJob::Type::scrub:
+                    RunScrub(job, result);
+                    break;
+            }
+        }
+        catch (const std::exception&)
+        {
+            // Errors of the file system are not fatal for the maintenance, the files will be checked again with the
+            // next job.
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            is_running_job_ = false;
+            statistics_.n_jobs_++;
+            statistics_.n_removed_files_ += result.removed_files_.size();
+            statistics_.n_repair_files_ += result.repair_files_.size();
+            if (!result.removed_files_.empty() || !result.repair_files_.empty()) results_.push_back(std::move(result));
+        }
+        condition_.notify_all();
+    }
+}
+
+/**
+ *
+ */
+void L2A::UTIL::LinksMaintenanceWorker::RunGarbageCollection(
+    const LinksMaintenanceJob& job, LinksMaintenanceResult& result)
+{
+    std::error_code error_code;
+
+    // Get all PDF files of items in the links folder.
+    std::vector<std::filesystem::path> link_files;
+    std::vector<std::string> link_file_names;
+    for (const auto& entry : std::filesystem::directory_iterator(job.links_directory_, error_code))
+    {
+        if (!entry.is_regular_file(error_code)) continue;
+        const std::string file_name = entry.path().filename().u8string();
+        if (!IsItemPDFFileName(file_name, item_post_fix_)) continue;
+        link_files.push_back(entry.path());
+        link_file_names.push_back(file_name);
+    }
+
+    // The PDF files of all other documents in the same folder start with the name of the document.
+    std::vector<std::string> other_document_prefixes;
+    const std::string document_file_name = job.document_path_.filename().u8string();
+    for (const auto& entry : std::filesystem::directory_iterator(job.document_path_.parent_path(), error_code))
+    {
+        if (!entry.is_regular_file(error_code) || entry.path().extension() != ".ai") continue;
+        if (entry.path().filename().u8string() == document_file_name) continue;
+        other_document_prefixes.push_back(entry.path().stem().u8string() + item_post_fix_);
+    }
+
+    // Remove the unused files. Files that were written after the job was created could be used by new items.
+    for (const auto& i_file : GetUnusedLinkFiles(link_file_names, job.used_file_names_, other_document_prefixes))
+    {
+        if (!ConsumeBudget(0)) return;
+        const auto write_time = std::filesystem::last_write_time(link_files[i_file], error_code);
+        if (error_code || write_time >= job.time_) continue;
+        if (std::filesystem::remove(link_files[i_file], error_code))
+            result.removed_files_.push_back(link_file_names[i_file]);
+    }
+}
+
+/**
+ *
+ */
+void L2A::UTIL::LinksMaintenanceWorker::RunScrub(const LinksMaintenanceJob& job, LinksMaintenanceResult& result)
+{
+    const LinksManifest manifest(job.links_directory_ / manifest_name_);
+    const std::string document_prefix = job.document_path_.stem().u8string() + item_post_fix_;
+    for (const auto& [file_name, entry] : manifest.GetEntries())
+    {
+        if (file_name.compare(0, document_prefix.size(), document_prefix) != 0) continue;
+
+        // Files that were verified before are only read again if the manifest entry or the file status changed.
+        const std::filesystem::path file_path = job.links_directory_ / std::filesystem::u8path(file_name);
+        const auto scrubbed_file = scrubbed_files_.find(file_path);
+        if (scrubbed_file != scrubbed_files_.end() && IsEqualManifestEntry(scrubbed_file->second, entry) &&
+            manifest.IsValid(file_name, entry.hash_))
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            statistics_.n_unchanged_files_++;
+            continue;
+        }
+
+        std::error_code error_code;
+        const std::uintmax_t file_size = std::filesystem::file_size(file_path, error_code);
+        if (!ConsumeBudget(error_code ? 0 : file_size)) return;
+
+        std::uint64_t content_hash = 0;
+        const bool is_valid = manifest.IsValid(file_name, entry.hash_) &&
+                              GetFileContentHash(file_path, content_hash) && content_hash == entry.content_hash_;
+        if (is_valid)
+            scrubbed_files_[file_path] = entry;
+        else
+        {
+            scrubbed_files_.erase(file_path);
+            result.repair_files_.push_back(file_name);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        statistics_.n_scrubbed_files_++;
+        if (!error_code) statistics_.n_read_bytes_ += file_size;
+    }
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::LinksMaintenanceWorker::ConsumeBudget(const std::uintmax_t n_bytes)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+        if (stop_) return false;
+        if (is_flushing_) return true;
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - budget_window_start_ >= std::chrono::seconds(1))
+        {
+            budget_window_start_ = now;
+            budget_window_bytes_ = 0;
+            budget_window_files_ = 0;
+        }
+
+        // A single file that is larger than the budget is allowed at the beginning of a window.
+        const bool files_ok = max_files_per_second_ == 0 || budget_window_files_ < max_files_per_second_;
+        const bool bytes_ok = max_bytes_per_second_ == 0 || budget_window_bytes_ == 0 ||
+                              budget_window_bytes_ + n_bytes <= max_bytes_per_second_;
+        if (files_ok && bytes_ok)
+        {
+            budget_window_files_++;
+            budget_window_bytes_ += n_bytes;
+            return true;
+        }
+        condition_.wait_until(lock, budget_window_start_ + std::chrono::seconds(1));
+    }
+}
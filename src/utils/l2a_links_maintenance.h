@@ -0,0 +1,256 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Background worker to maintain the links folders of the documents.
+ */
+
+#ifndef UTIL_LINKS_MAINTENANCE_H_
+#define UTIL_LINKS_MAINTENANCE_H_
+
+
+#include "l2a_links_folder.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Job for the links maintenance worker.
+         */
+        struct LinksMaintenanceJob
+        {
+            /**
+             * \brief Type of the maintenance job.
+             */
+            enum class Type
+            {
+                //! Remove PDF files that are not used by any document.
+                garbage_collection,
+                //! Compare the PDF files of a document with the hashes in the manifest.
+                scrub
+            };
+
+            //! Type of this job.
+            Type type_;
+
+            //! Links folder of the document.
+            std::filesystem::path links_directory_;
+
+            //! Path to the Illustrator document.
+            std::filesystem::path document_path_;
+
+            //! Names of the PDF files used by the document (only for garbage collection).
+            std::vector<std::string> used_file_names_;
+
+            //! Time when the job was created. Files that were written after this time are not removed.
+            std::filesystem::file_time_type time_;
+        };
+
+        /**
+         * \brief Result of a maintenance job, this has to be processed on the main thread.
+         */
+        struct LinksMaintenanceResult
+        {
+            //! Links folder of the job.
+            std::filesystem::path links_directory_;
+
+            //! Names of the removed PDF files.
+            std::vector<std::string> removed_files_;
+
+            //! Names of the PDF files that do not match the manifest and have to be written again.
+            std::vector<std::string> repair_files_;
+        };
+
+        /**
+         * \brief Statistics of the links maintenance worker.
+         */
+        struct LinksMaintenanceStatistics
+        {
+            //! Number of finished jobs.
+            size_t n_jobs_ = 0;
+
+            //! Number of removed files.
+            size_t n_removed_files_ = 0;
+
+            //! Number of scrubbed files.
+            size_t n_scrubbed_files_ = 0;
+
+            //! Number of files that were not read while scrubbing, because they did not change since they were last
+            //! scrubbed.
+            size_t n_unchanged_files_ = 0;
+
+            //! Number of files that have to be repaired.
+            size_t n_repair_files_ = 0;
+
+            //! Number of bytes read while scrubbing.
+            std::uintmax_t n_read_bytes_ = 0;
+        };
+
+        /**
+         * \brief Worker that removes orphaned PDF files and scrubs the PDF files in a background thread.
+         *
+         * The worker only works on the file system, everything that needs Illustrator, i.e., writing the PDF files
+         * from the data stored in the items, has to be done on the main thread with the results returned by
+         * TakeResults. The file operations of the worker are limited by an I/O budget, so the worker does not compete
+         * with Illustrator for the disk.
+         */
+        class LinksMaintenanceWorker
+        {
+           public:
+            /**
+             * \brief Constructor.
+             * @param item_post_fix Postfix of the PDF files after the document name.
+             * @param manifest_name Name of the manifest file in the links folders.
+             * @param max_bytes_per_second Maximum number of bytes read per second, 0 means unlimited.
+             * @param max_files_per_second Maximum number of file operations per second, 0 means unlimited.
+             */
+            LinksMaintenanceWorker(const std::string& item_post_fix, const std::string& manifest_name,
+                const std::uintmax_t max_bytes_per_second, const size_t max_files_per_second);
+
+            /**
+             * \brief Destructor, stops the worker.
+             */
+            ~LinksMaintenanceWorker() { Stop(); }
+
+            /**
+             * \brief Add a job. Jobs that are already queued with the same type and document are replaced.
+             */
+            void Post(const LinksMaintenanceJob& job);
+
+            /**
+             * \brief Return true if there are no queued jobs and no job is running.
+             */
+            bool IsIdle() const;
+
+            /**
+             * \brief Return true if there are results that were not taken yet.
+             */
+            bool HasResults() const;
+
+            /**
+             * \brief Get the results of the finished jobs.
+             */
+            std::vector<LinksMaintenanceResult> TakeResults();
+
+            /**
+             * \brief Wait until all queued jobs are finished. The I/O budget is ignored while flushing.
+             */
+            void Flush();
+
+            /**
+             * \brief Stop the worker. Queued jobs are dropped, the running job is stopped after the current file.
+             */
+            void Stop();
+
+            /**
+             * \brief Get the statistics of the worker.
+             */
+            LinksMaintenanceStatistics GetStatistics() const;
+
+           private:
+            /**
+             * \brief Main loop of the worker thread.
+             */
+            void Run();
+
+            /**
+             * \brief Remove the PDF files in the links folder that are not used by any document.
+             */
+            void RunGarbageCollection(const LinksMaintenanceJob& job, LinksMaintenanceResult& result);
+
+            /**
+             * \brief Compare the PDF files of the document with the manifest. Only files that are new or changed since
+             * they were last scrubbed by this worker are read.
+             */
+            void RunScrub(const LinksMaintenanceJob& job, LinksMaintenanceResult& result);
+
+            /**
+             * \brief Wait until the I/O budget allows a file operation with the given number of bytes.
+             * @return False if the worker is stopped.
+             */
+            bool ConsumeBudget(const std::uintmax_t n_bytes);
+
+           private:
+            //! Postfix of the PDF files after the document name.
+            const std::string item_post_fix_;
+
+            //! Name of the manifest file.
+            const std::string manifest_name_;
+
+            //! I/O budget.
+            const std::uintmax_t max_bytes_per_second_;
+            const size_t max_files_per_second_;
+
+            //! Current budget window.
+            std::chrono::steady_clock::time_point budget_window_start_;
+            std::uintmax_t budget_window_bytes_;
+            size_t budget_window_files_;
+
+            //! Mutex for all members below.
+            mutable std::mutex mutex_;
+
+            //! Condition to wake up the worker thread and the threads waiting for the worker.
+            std::condition_variable condition_;
+
+            //! Queued jobs.
+            std::deque<LinksMaintenanceJob> jobs_;
+
+            //! Results of the finished jobs.
+            std::vector<LinksMaintenanceResult> results_;
+
+            //! Flag if a job is running.
+            bool is_running_job_;
+
+            //! Flag if the queued jobs are flushed.
+            bool is_flushing_;
+
+            //! Flag if the worker has to stop.
+            bool stop_;
+
+            //! Statistics of the worker.
+            LinksMaintenanceStatistics statistics_;
+
+            //! Manifest entries of the files that were verified by a scrub. This is only used by the worker thread.
+            std::map<std::filesystem::path, LinksManifestEntry> scrubbed_files_;
+
+            //! Worker thread, it is started with the first job.
+            std::thread thread_;
+        };
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
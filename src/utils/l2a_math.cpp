@@ -47,3 +47,56 @@ AIReal L2A::UTIL::MATH::GetDistance(const AIRealPoint& point_a, const AIRealPoin
 {
     return GetNorm(point_a - point_b);
 }
+
+/**
+ *
+ */
+AIRealMatrix L2A::UTIL::MATH::GetAffineTransformation(const AIRealPoint& image_origin, const AIRealPoint& image_h,
+    const AIRealPoint& image_v, const AIReal reference_length)
+{
+    AIRealMatrix matrix;
+    matrix.a = (image_h.h - image_origin.h) / reference_length;
+    matrix.b = (image_h.v - image_origin.v) / reference_length;
+    matrix.c = (image_v.h - image_origin.h) / reference_length;
+    matrix.d = (image_v.v - image_origin.v) / reference_length;
+    matrix.tx = image_origin.h;
+    matrix.ty = image_origin.v;
+    return matrix;
+}
+
+/**
+ *
+ */
+AIRealPoint L2A::UTIL::MATH::TransformPoint(const AIRealMatrix& matrix, const AIRealPoint& point)
+{
+    AIRealPoint transformed_point;
+    TransformPoints(matrix, 1, &point.h, &point.v, &transformed_point.h, &transformed_point.v);
+    return transformed_point;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::MATH::TransformPoints(const AIRealMatrix& matrix, const size_t n_points, const AIReal* points_h,
+    const AIReal* points_v, AIReal* transformed_h, AIReal* transformed_v)
+{
+    // Local copies of the matrix entries, so the compiler knows they do not alias with the output arrays.
+    const AIReal a = matrix.a;
+    const AIReal b = matrix.b;
+    const AIReal c = matrix.c;
+    const AIReal d = matrix.d;
+    const AIReal tx = matrix.tx;
+    const AIReal ty = matrix.ty;
+    for (size_t i = 0; i < n_points; i++)
+    {
+        const AIReal h = points_h[i];
+        const AIReal v = points_v[i];
+        transformed_h[i] = a * h + c * v + tx;
+        transformed_v[i] = b * h + d * v + ty;
+    }
+}
+
+/**
+ *
+ */
+ai::int32 L2A::UTIL::MATH::RoundToInteger(const AIReal value) { return (ai::int32)floor(value + AIReal(0.5)); }
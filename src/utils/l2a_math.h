@@ -73,6 +73,33 @@ namespace L2A
              * \brief Calculate the distance between two points.
              */
             AIReal GetDistance(const AIRealPoint& point_a, const AIRealPoint& point_b);
+
+            /**
+             * \brief Get the affine transformation that maps the points (0,0), (reference_length,0) and
+             * (0,reference_length) to the given image points.
+             *
+             * The returned matrix follows the Illustrator convention, i.e., x' = a x + c y + tx and
+             * y' = b x + d y + ty.
+             */
+            AIRealMatrix GetAffineTransformation(const AIRealPoint& image_origin, const AIRealPoint& image_h,
+                const AIRealPoint& image_v, const AIReal reference_length);
+
+            /**
+             * \brief Apply an affine transformation to a point.
+             */
+            AIRealPoint TransformPoint(const AIRealMatrix& matrix, const AIRealPoint& point);
+
+            /**
+             * \brief Apply an affine transformation to multiple points. The coordinates are given as separate arrays,
+             * so the loop can be vectorized by the compiler.
+             */
+            void TransformPoints(const AIRealMatrix& matrix, const size_t n_points, const AIReal* points_h,
+                const AIReal* points_v, AIReal* transformed_h, AIReal* transformed_v);
+
+            /**
+             * \brief Round a real value to the nearest integer.
+             */
+            ai::int32 RoundToInteger(const AIReal value);
         }  // namespace MATH
     }  // namespace UTIL
 }  // namespace L2A
@@ -0,0 +1,256 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Registry for counters and timings of the LaTeX2AI subsystems, shown in the diagnostics of the options form.
+ */
+
+
+#include "l2a_metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+
+/**
+ * \brief Format a number with printf syntax.
+ */
+std::string FormatMetricsNumber(const char* format, const double value)
+{
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), format, value);
+    return buffer;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::MetricsHistogram::Add(const double duration)
+{
+    min_ = count_ == 0 ? duration : std::min(min_, duration);
+    max_ = count_ == 0 ? duration : std::max(max_, duration);
+    count_++;
+    sum_ += duration;
+
+    size_t i_bucket = 0;
+    double bucket_limit = 1e-3;
+    while (duration >= bucket_limit && i_bucket + 1 < n_buckets_)
+    {
+        i_bucket++;
+        bucket_limit *= 2.0;
+    }
+    buckets_[i_bucket]++;
+}
+
+/**
+ *
+ */
+double L2A::UTIL::MetricsHistogram::GetQuantile(const double quantile) const
+{
+    if (count_ == 0) return 0.0;
+
+    const double n_quantile = std::ceil(quantile * (double)count_);
+    size_t n_sum = 0;
+    for (size_t i_bucket = 0; i_bucket < n_buckets_; i_bucket++)
+    {
+        n_sum += buckets_[i_bucket];
+        if ((double)n_sum >= n_quantile && i_bucket + 1 < n_buckets_)
+            return std::min(max_, 1e-3 * std::pow(2.0, (double)i_bucket));
+    }
+    return max_;
+}
+
+/**
+ *
+ */
+std::uint64_t L2A::UTIL::MetricsSnapshot::GetCounter(const std::string& name) const
+{
+    const auto it = counters_.find(name);
+    return it == counters_.end() ? 0 : it->second;
+}
+
+/**
+ *
+ */
+double L2A::UTIL::MetricsSnapshot::GetHitRate(const std::string& hit_name, const std::string& miss_name) const
+{
+    const std::uint64_t n_hits = GetCounter(hit_name);
+    const std::uint64_t n_total = n_hits + GetCounter(miss_name);
+    return n_total == 0 ? -1.0 : (double)n_hits / (double)n_total;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::MetricsRegistry::Increment(const std::string& name, const std::uint64_t value)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    counters_[name] += value;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::MetricsRegistry::Observe(const std::string& name, const double duration)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    histograms_[name].Add(duration);
+}
+
+/**
+ *
+ */
+void L2A::UTIL::MetricsRegistry::AddCompile(const CompileRecord& record)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    compiles_.push_back(record);
+    while (compiles_.size() > n_compile_records_) compiles_.pop_front();
+}
+
+/**
+ *
+ */
+L2A::UTIL::MetricsSnapshot L2A::UTIL::MetricsRegistry::GetSnapshot() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    MetricsSnapshot snapshot;
+    snapshot.counters_ = counters_;
+    snapshot.histograms_ = histograms_;
+    snapshot.compiles_.assign(compiles_.begin(), compiles_.end());
+    return snapshot;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::MetricsRegistry::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    counters_.clear();
+    histograms_.clear();
+    compiles_.clear();
+}
+
+/**
+ *
+ */
+L2A::UTIL::MetricsRegistry& L2A::UTIL::GetMetrics()
+{
+    static MetricsRegistry metrics;
+    return metrics;
+}
+
+/**
+ *
+ */
+std::string L2A::UTIL::GetMetricsText(const MetricsSnapshot& snapshot)
+{
+    std::string text;
+
+    // Counters that form the hit rate of a cache.
+    static const std::vector<std::array<const char*, 3>> hit_rates = {
+        {"Header cache", "header_cache_hits", "header_cache_misses"},
+        {"Skipped document checks", "document_check_skipped", "document_check_performed"},
+        {"Valid linked pdf files", "links_manifest_valid", "links_manifest_invalid"},
+        {"Redo pages from background", "redo_staged_pages", "redo_compiled_pages"},
+    };
+    text += "Cache hit rates\n";
+    for (const auto& [label, hit_name, miss_name] : hit_rates)
+    {
+        const double hit_rate = snapshot.GetHitRate(hit_name, miss_name);
+        if (hit_rate < 0.0) continue;
+        text += std::string("  ") + label + ": " + FormatMetricsNumber("%.1f %%", 100.0 * hit_rate) + " (" +
+                std::to_string(snapshot.GetCounter(hit_name)) + " of " +
+                std::to_string(snapshot.GetCounter(hit_name) + snapshot.GetCounter(miss_name)) + ")\n";
+    }
+
+    text += "Counters\n";
+    for (const auto& [name, value] : snapshot.counters_) text += "  " + name + ": " + std::to_string(value) + "\n";
+
+    text += "Timings (count / mean / median / 95 % / max)\n";
+    for (const auto& [name, histogram] : snapshot.histograms_)
+    {
+        text += "  " + name + ": " + std::to_string(histogram.count_) + " / " +
+                FormatMetricsNumber("%.3f s", histogram.sum_ / (double)histogram.count_) + " / " +
+                FormatMetricsNumber("%.3f s", histogram.GetQuantile(0.5)) + " / " +
+                FormatMetricsNumber("%.3f s", histogram.GetQuantile(0.95)) + " / " +
+                FormatMetricsNumber("%.3f s", histogram.max_) + "\n";
+    }
+
+    text += "Last compilations (newest first)\n";
+    for (auto it = snapshot.compiles_.rbegin(); it != snapshot.compiles_.rend(); it++)
+    {
+        text += std::string("  ") + (it->is_background_ ? "background" : "foreground") +
+                (it->is_ok_ ? "" : " (failed)") + ", " + std::to_string(it->n_items_) + " items / " +
+                std::to_string(it->n_pages_) + " pages: write " + FormatMetricsNumber("%.3f s", it->write_time_) +
+                ", LaTeX " + FormatMetricsNumber("%.3f s", it->latex_time_) + ", split " +
+                FormatMetricsNumber("%.3f s", it->split_time_) + ", total " +
+                FormatMetricsNumber("%.3f s", it->total_time_) + "\n";
+    }
+    return text;
+}
+
+/**
+ *
+ */
+std::string L2A::UTIL::GetMetricsJson(const MetricsSnapshot& snapshot)
+{
+    // The names are identifiers in the code, so they do not have to be escaped.
+    std::string json = "{\n  \"counters\": {";
+    for (auto it = snapshot.counters_.begin(); it != snapshot.counters_.end(); it++)
+        json += std::string(it == snapshot.counters_.begin() ? "" : ",") + "\n    \"" + it->first +
+                "\": " + std::to_string(it->second);
+
+    json += "\n  },\n  \"histograms\": {";
+    for (auto it = snapshot.histograms_.begin(); it != snapshot.histograms_.end(); it++)
+    {
+        const MetricsHistogram& histogram = it->second;
+        json += std::string(it == snapshot.histograms_.begin() ? "" : ",") + "\n    \"" + it->first +
+                "\": {\"count\": " + std::to_string(histogram.count_) +
+                ", \"sum\": " + FormatMetricsNumber("%.6f", histogram.sum_) +
+                ", \"min\": " + FormatMetricsNumber("%.6f", histogram.min_) +
+                ", \"max\": " + FormatMetricsNumber("%.6f", histogram.max_) + ", \"buckets_ms\": [";
+        for (size_t i_bucket = 0; i_bucket < MetricsHistogram::n_buckets_; i_bucket++)
+            json += (i_bucket == 0 ? "" : ", ") + std::to_string(histogram.buckets_[i_bucket]);
+        json += "]}";
+    }
+
+    json += "\n  },\n  \"compiles\": [";
+    for (size_t i_compile = 0; i_compile < snapshot.compiles_.size(); i_compile++)
+    {
+        const CompileRecord& record = snapshot.compiles_[i_compile];
+        json += std::string(i_compile == 0 ? "" : ",") +
+                "\n    {\"background\": " + (record.is_background_ ? "true" : "false") +
+                ", \"ok\": " + (record.is_ok_ ? "true" : "false") +
+                ", \"items\": " + std::to_string(record.n_items_) +
+                ", \"pages\": " + std::to_string(record.n_pages_) +
+                ", \"write\": " + FormatMetricsNumber("%.6f", record.write_time_) +
+                ", \"latex\": " + FormatMetricsNumber("%.6f", record.latex_time_) +
+                ", \"split\": " + FormatMetricsNumber("%.6f", record.split_time_) +
+                ", \"total\": " + FormatMetricsNumber("%.6f", record.total_time_) + "}";
+    }
+    json += "\n  ]\n}\n";
+    return json;
+}
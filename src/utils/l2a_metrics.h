@@ -0,0 +1,244 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Registry for counters and timings of the LaTeX2AI subsystems, shown in the diagnostics of the options form.
+ */
+
+#ifndef UTIL_METRICS_H_
+#define UTIL_METRICS_H_
+
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Histogram of durations with logarithmic buckets.
+         */
+        struct MetricsHistogram
+        {
+            //! Number of buckets, bucket i contains the durations below 2^i milliseconds.
+            static constexpr size_t n_buckets_ = 24;
+
+            /**
+             * \brief Add a duration in seconds.
+             */
+            void Add(const double duration);
+
+            /**
+             * \brief Get an upper bound for the given quantile in seconds, e.g., 0.5 for the median.
+             */
+            double GetQuantile(const double quantile) const;
+
+            //! Number of durations.
+            size_t count_ = 0;
+
+            //! Sum, minimum and maximum of the durations in seconds.
+            double sum_ = 0.0;
+            double min_ = 0.0;
+            double max_ = 0.0;
+
+            //! Number of durations in each bucket, the last bucket also contains all larger durations.
+            std::array<size_t, n_buckets_> buckets_ = {};
+        };
+
+        /**
+         * \brief Timings of one compilation of a LaTeX document.
+         */
+        struct CompileRecord
+        {
+            //! Flag if the document was compiled by the background worker.
+            bool is_background_ = false;
+
+            //! Flag if the compilation was successful.
+            bool is_ok_ = false;
+
+            //! Number of items and pages in the document.
+            size_t n_items_ = 0;
+            size_t n_pages_ = 0;
+
+            //! Time in seconds for writing the files, the LaTeX engine and splitting the pages.
+            double write_time_ = 0.0;
+            double latex_time_ = 0.0;
+            double split_time_ = 0.0;
+
+            //! Total time of the compilation in seconds.
+            double total_time_ = 0.0;
+        };
+
+        /**
+         * \brief Copy of the data in a metrics registry.
+         */
+        struct MetricsSnapshot
+        {
+            //! Counters by name.
+            std::map<std::string, std::uint64_t> counters_;
+
+            //! Duration histograms by name.
+            std::map<std::string, MetricsHistogram> histograms_;
+
+            //! The last compilations, the newest one is the last one.
+            std::vector<CompileRecord> compiles_;
+
+            /**
+             * \brief Get the value of a counter, or 0 if it does not exist.
+             */
+            std::uint64_t GetCounter(const std::string& name) const;
+
+            /**
+             * \brief Get the ratio of the hits to the sum of the hits and misses, or a negative value if both are 0.
+             */
+            double GetHitRate(const std::string& hit_name, const std::string& miss_name) const;
+        };
+
+        /**
+         * \brief Thread-safe registry for counters, duration histograms and the timings of the last compilations.
+         *
+         * The values are only updated at the end of an operation, e.g., once per compilation or document check, so a
+         * single mutex is sufficient.
+         */
+        class MetricsRegistry
+        {
+           public:
+            /**
+             * \brief Constructor.
+             * @param n_compile_records Number of compilations that are kept.
+             */
+            MetricsRegistry(const size_t n_compile_records = 20) : n_compile_records_(n_compile_records) {}
+
+            /**
+             * \brief Add a value to a counter.
+             */
+            void Increment(const std::string& name, const std::uint64_t value = 1);
+
+            /**
+             * \brief Add a duration in seconds to a histogram.
+             */
+            void Observe(const std::string& name, const double duration);
+
+            /**
+             * \brief Add the timings of a compilation, the oldest compilation is removed if there are too many.
+             */
+            void AddCompile(const CompileRecord& record);
+
+            /**
+             * \brief Get a copy of the current data.
+             */
+            MetricsSnapshot GetSnapshot() const;
+
+            /**
+             * \brief Remove all data.
+             */
+            void Clear();
+
+           private:
+            //! Mutex for all data of the registry.
+            mutable std::mutex mutex_;
+
+            //! Counters by name.
+            std::map<std::string, std::uint64_t> counters_;
+
+            //! Duration histograms by name.
+            std::map<std::string, MetricsHistogram> histograms_;
+
+            //! The last compilations.
+            std::deque<CompileRecord> compiles_;
+
+            //! Number of compilations that are kept.
+            size_t n_compile_records_;
+        };
+
+        /**
+         * \brief Get the registry of LaTeX2AI.
+         */
+        MetricsRegistry& GetMetrics();
+
+        /**
+         * \brief Measure the time of a scope and add it to a histogram of the LaTeX2AI registry.
+         */
+        class MetricsTimer
+        {
+           public:
+            /**
+             * \brief Start the timer.
+             */
+            MetricsTimer(const char* name) : name_(name), start_(std::chrono::steady_clock::now()), is_stopped_(false)
+            {
+            }
+
+            /**
+             * \brief Add the elapsed time to the histogram, if the timer was not stopped before.
+             */
+            ~MetricsTimer() { Stop(); }
+
+            /**
+             * \brief Add the elapsed time to the histogram and return it in seconds. The time is only added once.
+             */
+            double Stop()
+            {
+                const double elapsed_time =
+                    std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+                if (!is_stopped_) GetMetrics().Observe(name_, elapsed_time);
+                is_stopped_ = true;
+                return elapsed_time;
+            }
+
+            MetricsTimer(const MetricsTimer&) = delete;
+            MetricsTimer& operator=(const MetricsTimer&) = delete;
+
+           private:
+            //! Name of the histogram.
+            const char* name_;
+
+            //! Start time.
+            std::chrono::steady_clock::time_point start_;
+
+            //! Flag if the time was already added.
+            bool is_stopped_;
+        };
+
+        /**
+         * \brief Get a text with the counters, cache hit rates, histograms and last compilations of a snapshot.
+         */
+        std::string GetMetricsText(const MetricsSnapshot& snapshot);
+
+        /**
+         * \brief Get the data of a snapshot as JSON.
+         */
+        std::string GetMetricsJson(const MetricsSnapshot& snapshot);
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
@@ -0,0 +1,84 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Merge bursts of notifications from Illustrator, so they are only processed once.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_notifier_coalescer.h"
+
+
+/**
+ *
+ */
+void L2A::UTIL::NotifierCoalescer::Post(const NotifierEvent event, const std::string& document_key)
+{
+    switch (event)
+    {
+        case NotifierEvent::selection_changed:
+            statistics_.n_received_selection_++;
+            selection_changed_pending_ = true;
+            break;
+        case NotifierEvent::document_changed:
+            statistics_.n_received_document_++;
+            document_changed_pending_ = true;
+            pending_document_key_ = document_key;
+            break;
+    }
+}
+
+/**
+ *
+ */
+L2A::UTIL::PendingNotifierEvents L2A::UTIL::NotifierCoalescer::TakePending()
+{
+    PendingNotifierEvents pending_events;
+
+    if (selection_changed_pending_)
+    {
+        statistics_.n_processed_selection_++;
+        pending_events.selection_changed_ = true;
+    }
+
+    if (document_changed_pending_)
+    {
+        // Without an active document there is nothing to check.
+        if (pending_document_key_.empty())
+            statistics_.n_skipped_document_++;
+        else
+        {
+            statistics_.n_processed_document_++;
+            pending_events.check_document_ = true;
+            pending_events.document_key_ = pending_document_key_;
+        }
+    }
+
+    selection_changed_pending_ = false;
+    document_changed_pending_ = false;
+    pending_document_key_.clear();
+    return pending_events;
+}
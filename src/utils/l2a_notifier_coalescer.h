@@ -0,0 +1,135 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Merge bursts of notifications from Illustrator, so they are only processed once.
+ */
+
+#ifndef UTIL_NOTIFIER_COALESCER_H_
+#define UTIL_NOTIFIER_COALESCER_H_
+
+
+#include <string>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Notifier events that can be merged.
+         */
+        enum class NotifierEvent
+        {
+            //! The art selection in the document changed.
+            selection_changed,
+            //! The active document (view) changed.
+            document_changed
+        };
+
+        /**
+         * \brief Events that have to be processed after a burst of notifications.
+         */
+        struct PendingNotifierEvents
+        {
+            //! The selection changed at least once.
+            bool selection_changed_ = false;
+
+            //! The document with document_key_ has to be checked.
+            bool check_document_ = false;
+
+            //! Key of the document that has to be checked.
+            std::string document_key_;
+        };
+
+        /**
+         * \brief Statistics of received and processed notifications.
+         */
+        struct NotifierStatistics
+        {
+            //! Number of received selection changed notifications.
+            size_t n_received_selection_ = 0;
+
+            //! Number of processed selection changes.
+            size_t n_processed_selection_ = 0;
+
+            //! Number of received document changed notifications.
+            size_t n_received_document_ = 0;
+
+            //! Number of document checks, i.e., merged document changes.
+            size_t n_processed_document_ = 0;
+
+            //! Number of merged document changes without an active document.
+            size_t n_skipped_document_ = 0;
+        };
+
+        /**
+         * \brief Collect notifications and merge them until they are processed.
+         *
+         * Multiple selection changes result in a single selection change. For document changes only the last active
+         * document is relevant. If this document changed since its last check is not decided here, this is done by
+         * the document check itself.
+         */
+        class NotifierCoalescer
+        {
+           public:
+            /**
+             * \brief Add a received notification.
+             * @param document_key Identifier of the active document, only used for document changes. An empty key
+             * means that no document is active.
+             */
+            void Post(const NotifierEvent event, const std::string& document_key = "");
+
+            /**
+             * \brief Return true if there are notifications that were not processed yet.
+             */
+            bool HasPending() const { return selection_changed_pending_ || document_changed_pending_; }
+
+            /**
+             * \brief Get the events that have to be processed and reset the pending notifications.
+             */
+            PendingNotifierEvents TakePending();
+
+            /**
+             * \brief Get the statistics of the notifications.
+             */
+            const NotifierStatistics& GetStatistics() const { return statistics_; }
+
+           private:
+            //! Flag if a selection change is pending.
+            bool selection_changed_pending_ = false;
+
+            //! Flag if a document change is pending.
+            bool document_changed_pending_ = false;
+
+            //! Key of the last active document.
+            std::string pending_document_key_;
+
+            //! Statistics of the notifications.
+            NotifierStatistics statistics_;
+        };
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
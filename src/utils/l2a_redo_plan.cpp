@@ -0,0 +1,95 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Plan which items have to be compiled when LaTeX2AI items are redone.
+ */
+
+
+#include "l2a_redo_plan.h"
+
+#include <unordered_map>
+
+
+/**
+ *
+ */
+L2A::UTIL::RedoPlan L2A::UTIL::CreateRedoPlan(const std::vector<RedoPlanItem>& items)
+{
+    RedoPlan plan;
+    plan.compile_index_.resize(items.size(), RedoPlan::skip);
+
+    // The baseline flag is added in front of the code, so it is part of the key.
+    std::unordered_map<std::string, size_t> compiled_codes;
+    for (size_t i_item = 0; i_item < items.size(); i_item++)
+    {
+        const auto& item = items[i_item];
+        if (item.is_up_to_date_)
+        {
+            plan.n_skipped_++;
+            continue;
+        }
+
+        const std::string key = (item.is_baseline_ ? "b" : "c") + item.latex_code_;
+        const auto [it, is_new] = compiled_codes.try_emplace(key, plan.compile_items_.size());
+        if (is_new)
+            plan.compile_items_.push_back(i_item);
+        else
+            plan.n_deduplicated_++;
+        plan.compile_index_[i_item] = it->second;
+    }
+    return plan;
+}
+
+/**
+ *
+ */
+L2A::UTIL::RedoPlanTime L2A::UTIL::GetRedoPlanTime(const std::vector<RedoPlanItem>& items, const RedoPlan& plan)
+{
+    // Identical items are compiled on one page, the page gets the time of any of them that has a known time.
+    std::vector<size_t> page_time_items(plan.compile_items_.size(), RedoPlan::skip);
+    for (size_t i_item = 0; i_item < items.size(); i_item++)
+    {
+        const size_t i_page = plan.compile_index_[i_item];
+        if (i_page == RedoPlan::skip || items[i_item].compile_time_ < 0.0) continue;
+        if (page_time_items[i_page] == RedoPlan::skip ||
+            items[page_time_items[i_page]].compile_time_ < items[i_item].compile_time_)
+            page_time_items[i_page] = i_item;
+    }
+
+    RedoPlanTime plan_time;
+    for (const auto& i_item : page_time_items)
+    {
+        if (i_item == RedoPlan::skip)
+        {
+            plan_time.n_unknown_++;
+            continue;
+        }
+        plan_time.compile_time_ += items[i_item].compile_time_;
+        if (plan_time.slowest_item_ == RedoPlan::skip ||
+            items[plan_time.slowest_item_].compile_time_ < items[i_item].compile_time_)
+            plan_time.slowest_item_ = i_item;
+    }
+    return plan_time;
+}
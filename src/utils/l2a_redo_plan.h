@@ -0,0 +1,112 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Plan which items have to be compiled when LaTeX2AI items are redone.
+ */
+
+#ifndef UTIL_REDO_PLAN_H_
+#define UTIL_REDO_PLAN_H_
+
+
+#include <string>
+#include <vector>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Data of an item that is relevant for the redo plan.
+         */
+        struct RedoPlanItem
+        {
+            //! LaTeX code of the item.
+            std::string latex_code_;
+
+            //! Flag if the item is a baseline item, this changes the compiled pdf.
+            bool is_baseline_ = false;
+
+            //! Flag if the stored pdf was compiled with the current header and options.
+            bool is_up_to_date_ = false;
+
+            //! Time in seconds the LaTeX engine spent on the page of this item in the last compilation, negative if it
+            //! is not known.
+            double compile_time_ = -1.0;
+        };
+
+        /**
+         * \brief Plan for redoing a batch of items.
+         */
+        struct RedoPlan
+        {
+            //! Value in compile_index_ for items that are skipped.
+            static constexpr size_t skip = static_cast<size_t>(-1);
+
+            //! For each item the index in compile_items_ of the item whose pdf it gets, or skip.
+            std::vector<size_t> compile_index_;
+
+            //! Indices of the items that have to be compiled.
+            std::vector<size_t> compile_items_;
+
+            //! Number of items that are up to date and are skipped.
+            size_t n_skipped_ = 0;
+
+            //! Number of items that get the pdf of an identical item in the batch.
+            size_t n_deduplicated_ = 0;
+        };
+
+        /**
+         * \brief Create the plan for redoing the given items.
+         *
+         * Items that are up to date are skipped. Items with the same LaTeX code and baseline flag result in the same
+         * pdf, so they are only compiled once. This is also used to collapse identical pages in a single LaTeX
+         * document.
+         */
+        RedoPlan CreateRedoPlan(const std::vector<RedoPlanItem>& items);
+
+        /**
+         * \brief Expected LaTeX time of a redo plan, based on the last compile times of the items.
+         */
+        struct RedoPlanTime
+        {
+            //! Sum of the known compile times of the compiled items in seconds.
+            double compile_time_ = 0.0;
+
+            //! Number of compiled items without a known compile time.
+            size_t n_unknown_ = 0;
+
+            //! Index of the compiled item with the largest compile time, or RedoPlan::skip if no time is known.
+            size_t slowest_item_ = RedoPlan::skip;
+        };
+
+        /**
+         * \brief Get the expected LaTeX time of a redo plan.
+         */
+        RedoPlanTime GetRedoPlanTime(const std::vector<RedoPlanItem>& items, const RedoPlan& plan);
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
@@ -0,0 +1,227 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Spatial index to find items by position in the document.
+ */
+
+
+#include "IllustratorSDK.h"
+
+#include "l2a_spatial_index.h"
+
+#include <algorithm>
+
+
+//! Maximum number of grid cells in one direction.
+static const size_t max_cells_per_direction_ = 1024;
+
+
+/**
+ *
+ */
+AIRealRect L2A::UTIL::GetBoundingBox(const std::vector<AIRealPoint>& points)
+{
+    AIRealRect bounding_box = {0, 0, 0, 0};
+    if (points.size() == 0) return bounding_box;
+
+    bounding_box.left = points[0].h;
+    bounding_box.right = points[0].h;
+    bounding_box.top = points[0].v;
+    bounding_box.bottom = points[0].v;
+    for (const auto& point : points)
+    {
+        bounding_box.left = std::min(bounding_box.left, point.h);
+        bounding_box.right = std::max(bounding_box.right, point.h);
+        bounding_box.bottom = std::min(bounding_box.bottom, point.v);
+        bounding_box.top = std::max(bounding_box.top, point.v);
+    }
+    return bounding_box;
+}
+
+/**
+ *
+ */
+L2A::UTIL::SpatialIndex::SpatialIndex() : grid_box_({0, 0, 0, 0}), cell_size_(1.0), n_cells_h_(0), n_cells_v_(0) {}
+
+/**
+ *
+ */
+void L2A::UTIL::SpatialIndex::Build(const std::vector<AIRealRect>& boxes)
+{
+    Clear();
+    if (boxes.size() == 0) return;
+
+    // Get the sorted boxes and the extent of the grid.
+    boxes_.reserve(boxes.size());
+    for (const auto& rect : boxes) boxes_.push_back(ToBox(rect));
+    grid_box_ = boxes_[0];
+    for (const auto& box : boxes_)
+    {
+        grid_box_.min_h_ = std::min(grid_box_.min_h_, box.min_h_);
+        grid_box_.min_v_ = std::min(grid_box_.min_v_, box.min_v_);
+        grid_box_.max_h_ = std::max(grid_box_.max_h_, box.max_h_);
+        grid_box_.max_v_ = std::max(grid_box_.max_v_, box.max_v_);
+    }
+
+    // Choose the cell size such that there is roughly one item per cell.
+    const AIReal width = grid_box_.max_h_ - grid_box_.min_h_;
+    const AIReal height = grid_box_.max_v_ - grid_box_.min_v_;
+    const AIReal n_items = (AIReal)boxes_.size();
+    if (width * height > 0.0)
+        cell_size_ = sqrt(width * height / n_items);
+    else if (std::max(width, height) > 0.0)
+        cell_size_ = std::max(width, height) / n_items;
+    else
+        cell_size_ = 1.0;
+    cell_size_ = std::max(cell_size_, std::max(width, height) / (AIReal)max_cells_per_direction_);
+    n_cells_h_ = std::min(max_cells_per_direction_, (size_t)(width / cell_size_) + 1);
+    n_cells_v_ = std::min(max_cells_per_direction_, (size_t)(height / cell_size_) + 1);
+
+    // Count the number of items in each cell.
+    std::vector<size_t> cell_count(n_cells_h_ * n_cells_v_, 0);
+    size_t h_start, h_end, v_start, v_end;
+    for (const auto& box : boxes_)
+    {
+        GetCellRange(box, h_start, h_end, v_start, v_end);
+        for (size_t i_v = v_start; i_v <= v_end; i_v++)
+            for (size_t i_h = h_start; i_h <= h_end; i_h++) cell_count[i_v * n_cells_h_ + i_h]++;
+    }
+
+    // Compressed storage of the item indices for each cell.
+    cell_offsets_.resize(cell_count.size() + 1);
+    cell_offsets_[0] = 0;
+    for (size_t i_cell = 0; i_cell < cell_count.size(); i_cell++)
+        cell_offsets_[i_cell + 1] = cell_offsets_[i_cell] + cell_count[i_cell];
+    cell_items_.resize(cell_offsets_.back());
+    std::vector<size_t> cell_position(cell_offsets_.begin(), cell_offsets_.end() - 1);
+    for (size_t i_item = 0; i_item < boxes_.size(); i_item++)
+    {
+        GetCellRange(boxes_[i_item], h_start, h_end, v_start, v_end);
+        for (size_t i_v = v_start; i_v <= v_end; i_v++)
+            for (size_t i_h = h_start; i_h <= h_end; i_h++)
+                cell_items_[cell_position[i_v * n_cells_h_ + i_h]++] = i_item;
+    }
+}
+
+/**
+ *
+ */
+void L2A::UTIL::SpatialIndex::Clear()
+{
+    boxes_.clear();
+    grid_box_ = {0, 0, 0, 0};
+    cell_size_ = 1.0;
+    n_cells_h_ = 0;
+    n_cells_v_ = 0;
+    cell_offsets_.clear();
+    cell_items_.clear();
+}
+
+/**
+ *
+ */
+std::vector<size_t> L2A::UTIL::SpatialIndex::QueryPoint(const AIRealPoint& point, const AIReal tolerance) const
+{
+    const AIReal abs_tolerance = std::abs(tolerance);
+    Box query_box = {point.h - abs_tolerance, point.v - abs_tolerance, point.h + abs_tolerance,
+        point.v + abs_tolerance};
+    return Query(query_box);
+}
+
+/**
+ *
+ */
+std::vector<size_t> L2A::UTIL::SpatialIndex::QueryRect(const AIRealRect& rect) const { return Query(ToBox(rect)); }
+
+/**
+ *
+ */
+L2A::UTIL::SpatialIndex::Box L2A::UTIL::SpatialIndex::ToBox(const AIRealRect& rect)
+{
+    Box box;
+    box.min_h_ = std::min(rect.left, rect.right);
+    box.max_h_ = std::max(rect.left, rect.right);
+    box.min_v_ = std::min(rect.top, rect.bottom);
+    box.max_v_ = std::max(rect.top, rect.bottom);
+    return box;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::SpatialIndex::Intersects(const Box& box_a, const Box& box_b)
+{
+    return box_a.min_h_ <= box_b.max_h_ && box_b.min_h_ <= box_a.max_h_ && box_a.min_v_ <= box_b.max_v_ &&
+           box_b.min_v_ <= box_a.max_v_;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::SpatialIndex::GetCellRange(
+    const Box& box, size_t& h_start, size_t& h_end, size_t& v_start, size_t& v_end) const
+{
+    if (n_cells_h_ == 0 || n_cells_v_ == 0 || !Intersects(box, grid_box_)) return false;
+
+    auto get_cell = [this](const AIReal coordinate, const AIReal grid_start, const size_t n_cells)
+    {
+        const AIReal position = floor((coordinate - grid_start) / cell_size_);
+        if (position <= 0.0) return (size_t)0;
+        return std::min(n_cells - 1, (size_t)position);
+    };
+    h_start = get_cell(box.min_h_, grid_box_.min_h_, n_cells_h_);
+    h_end = get_cell(box.max_h_, grid_box_.min_h_, n_cells_h_);
+    v_start = get_cell(box.min_v_, grid_box_.min_v_, n_cells_v_);
+    v_end = get_cell(box.max_v_, grid_box_.min_v_, n_cells_v_);
+    return true;
+}
+
+/**
+ *
+ */
+std::vector<size_t> L2A::UTIL::SpatialIndex::Query(const Box& query_box) const
+{
+    std::vector<size_t> result;
+    size_t h_start, h_end, v_start, v_end;
+    if (!GetCellRange(query_box, h_start, h_end, v_start, v_end)) return result;
+
+    for (size_t i_v = v_start; i_v <= v_end; i_v++)
+    {
+        for (size_t i_h = h_start; i_h <= h_end; i_h++)
+        {
+            const size_t i_cell = i_v * n_cells_h_ + i_h;
+            for (size_t i_entry = cell_offsets_[i_cell]; i_entry < cell_offsets_[i_cell + 1]; i_entry++)
+            {
+                const size_t i_item = cell_items_[i_entry];
+                if (Intersects(boxes_[i_item], query_box)) result.push_back(i_item);
+            }
+        }
+    }
+
+    // Items that span multiple cells can be found more than once.
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
@@ -0,0 +1,151 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Spatial index to find items by position in the document.
+ */
+
+#ifndef UTIL_SPATIAL_INDEX_H_
+#define UTIL_SPATIAL_INDEX_H_
+
+
+#include "IllustratorSDK.h"
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief Get the axis aligned bounding box of a set of points.
+         *
+         * The returned rectangle follows the artwork convention, i.e., top >= bottom.
+         */
+        AIRealRect GetBoundingBox(const std::vector<AIRealPoint>& points);
+
+        /**
+         * \brief Uniform grid over axis aligned bounding boxes.
+         *
+         * The index stores the bounding boxes of the items and sorts them into the cells of a regular grid. Point and
+         * rectangle queries only have to check the items in the cells that are touched by the query, which makes them
+         * independent of the total number of items for reasonably distributed items. The returned values are the
+         * indices of the boxes in the vector that was passed to Build, sorted in ascending order.
+         */
+        class SpatialIndex
+        {
+           public:
+            /**
+             * \brief Default constructor, creates an empty index.
+             */
+            SpatialIndex();
+
+            /**
+             * \brief (Re)build the index for the given bounding boxes.
+             */
+            void Build(const std::vector<AIRealRect>& boxes);
+
+            /**
+             * \brief Remove all items from the index.
+             */
+            void Clear();
+
+            /**
+             * \brief Return the number of items in the index.
+             */
+            size_t Size() const { return boxes_.size(); }
+
+            /**
+             * \brief Return true if there are no items in the index.
+             */
+            bool IsEmpty() const { return boxes_.empty(); }
+
+            /**
+             * \brief Get all items whose bounding box (enlarged by the tolerance) contains the point.
+             */
+            std::vector<size_t> QueryPoint(const AIRealPoint& point, const AIReal tolerance = 0.0) const;
+
+            /**
+             * \brief Get all items whose bounding box intersects the rectangle.
+             */
+            std::vector<size_t> QueryRect(const AIRealRect& rect) const;
+
+           private:
+            /**
+             * \brief Bounding box with sorted coordinates.
+             */
+            struct Box
+            {
+                AIReal min_h_;
+                AIReal min_v_;
+                AIReal max_h_;
+                AIReal max_v_;
+            };
+
+            /**
+             * \brief Convert an AIRealRect to a box with sorted coordinates.
+             */
+            static Box ToBox(const AIRealRect& rect);
+
+            /**
+             * \brief Check if two boxes intersect.
+             */
+            static bool Intersects(const Box& box_a, const Box& box_b);
+
+            /**
+             * \brief Get the range of cells covered by a box. Returns false if the box is outside of the grid.
+             */
+            bool GetCellRange(const Box& box, size_t& h_start, size_t& h_end, size_t& v_start, size_t& v_end) const;
+
+            /**
+             * \brief Get all items whose bounding box intersects the given box.
+             */
+            std::vector<size_t> Query(const Box& query_box) const;
+
+           private:
+            //! Bounding boxes of all items.
+            std::vector<Box> boxes_;
+
+            //! Bounding box of all items.
+            Box grid_box_;
+
+            //! Size of one grid cell.
+            AIReal cell_size_;
+
+            //! Number of cells in horizontal direction.
+            size_t n_cells_h_;
+
+            //! Number of cells in vertical direction.
+            size_t n_cells_v_;
+
+            //! Offset of each cell in the cell_items_ vector (the last entry is the total number of entries).
+            std::vector<size_t> cell_offsets_;
+
+            //! Item indices of all cells.
+            std::vector<size_t> cell_items_;
+        };
+    }  // namespace UTIL
+}  // namespace L2A
+
+
+#endif
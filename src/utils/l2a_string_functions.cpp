@@ -30,15 +30,12 @@
 
 #include "l2a_string_functions.h"
 
+#include "l2a_compile_core.h"
 #include "l2a_error.h"
 #include "l2a_suites.h"
 
 #include <iomanip>
 
-#define CRCPP_USE_CPP11
-#define CRCPP_INCLUDE_ESOTERIC_CRC_DEFINITIONS
-#include "CRC.h"
-
 
 /**
  *
@@ -176,9 +173,5 @@ std::vector<ai::UnicodeString> L2A::UTIL::SplitString(
  */
 ai::UnicodeString L2A::UTIL::StringHash(const ai::UnicodeString& string)
 {
-    auto string_std = StringAiToStd(string);
-    std::uint64_t crc = CRC::Calculate(string_std.c_str(), string_std.size(), CRC::CRC_64());
-    std::stringstream buffer;
-    buffer << std::hex << crc;
-    return StringStdToAi(buffer.str());
+    return StringStdToAi(GetStringHash(StringAiToStd(string)));
 }
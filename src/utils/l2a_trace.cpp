@@ -0,0 +1,185 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Record the time spent in the stages of the item pipeline and export it in the Chrome trace event format.
+ */
+
+
+#include "l2a_trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+
+/**
+ *
+ */
+L2A::UTIL::TraceBuffer::TraceBuffer(const size_t capacity)
+    : slots_(new Slot[std::max(capacity, (size_t)1)]),
+      capacity_(std::max(capacity, (size_t)1)),
+      n_recorded_(0),
+      first_index_(0),
+      is_enabled_(false)
+{
+    for (size_t i_slot = 0; i_slot < capacity_; i_slot++)
+    {
+        slots_[i_slot].sequence_.store(0, std::memory_order_relaxed);
+        slots_[i_slot].name_.store(nullptr, std::memory_order_relaxed);
+        slots_[i_slot].start_.store(0, std::memory_order_relaxed);
+        slots_[i_slot].duration_.store(0, std::memory_order_relaxed);
+        slots_[i_slot].thread_id_.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ *
+ */
+void L2A::UTIL::TraceBuffer::Record(const char* name, const std::uint64_t start, const std::uint64_t end)
+{
+    // The sequence of the span with index i is 2i+1 while it is written and 2i+2 after it is written.
+    const std::uint64_t index = n_recorded_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots_[index % capacity_];
+    slot.sequence_.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name_.store(name, std::memory_order_relaxed);
+    slot.start_.store(start, std::memory_order_relaxed);
+    slot.duration_.store(end > start ? end - start : 0, std::memory_order_relaxed);
+    slot.thread_id_.store(GetTraceThreadId(), std::memory_order_relaxed);
+    slot.sequence_.store(2 * index + 2, std::memory_order_release);
+}
+
+/**
+ *
+ */
+std::vector<L2A::UTIL::TraceEvent> L2A::UTIL::TraceBuffer::GetEvents() const
+{
+    const std::uint64_t n_recorded = n_recorded_.load(std::memory_order_acquire);
+    const std::uint64_t first_index = std::max(first_index_.load(std::memory_order_relaxed),
+        n_recorded > capacity_ ? n_recorded - capacity_ : (std::uint64_t)0);
+
+    std::vector<std::pair<std::uint64_t, TraceEvent>> indexed_events;
+    indexed_events.reserve(capacity_);
+    for (size_t i_slot = 0; i_slot < capacity_; i_slot++)
+    {
+        const Slot& slot = slots_[i_slot];
+        const std::uint64_t sequence = slot.sequence_.load(std::memory_order_acquire);
+        if (sequence == 0 || sequence % 2 == 1) continue;
+
+        TraceEvent event;
+        event.name_ = slot.name_.load(std::memory_order_relaxed);
+        event.start_ = slot.start_.load(std::memory_order_relaxed);
+        event.duration_ = slot.duration_.load(std::memory_order_relaxed);
+        event.thread_id_ = slot.thread_id_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        // Skip slots that were overwritten while they were read.
+        const std::uint64_t index = sequence / 2 - 1;
+        if (slot.sequence_.load(std::memory_order_relaxed) != sequence || index < first_index) continue;
+        indexed_events.push_back({index, event});
+    }
+
+    std::sort(indexed_events.begin(), indexed_events.end(),
+        [](const auto& event_a, const auto& event_b) { return event_a.first < event_b.first; });
+    std::vector<TraceEvent> events;
+    events.reserve(indexed_events.size());
+    for (const auto& indexed_event : indexed_events) events.push_back(indexed_event.second);
+    return events;
+}
+
+/**
+ *
+ */
+void L2A::UTIL::TraceBuffer::Clear()
+{
+    first_index_.store(n_recorded_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+/**
+ *
+ */
+L2A::UTIL::TraceBuffer& L2A::UTIL::GetTraceBuffer()
+{
+    static TraceBuffer trace_buffer(1 << 14);
+    return trace_buffer;
+}
+
+/**
+ *
+ */
+std::uint64_t L2A::UTIL::GetTraceTime()
+{
+    return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ *
+ */
+std::uint32_t L2A::UTIL::GetTraceThreadId()
+{
+    static std::atomic<std::uint32_t> n_threads(0);
+    thread_local const std::uint32_t thread_id = ++n_threads;
+    return thread_id;
+}
+
+/**
+ *
+ */
+std::string L2A::UTIL::GetChromeTrace(const std::vector<TraceEvent>& events)
+{
+    // Complete events ("ph": "X") with the times in microseconds.
+    std::string trace = "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    char buffer[128];
+    for (size_t i_event = 0; i_event < events.size(); i_event++)
+    {
+        const TraceEvent& event = events[i_event];
+        trace += i_event == 0 ? "\n" : ",\n";
+        trace += "{\"name\": \"";
+        for (const char* character = event.name_; character != nullptr && *character != '\0'; character++)
+        {
+            if (*character == '"' || *character == '\\') trace += '\\';
+            trace += *character;
+        }
+        std::snprintf(buffer, sizeof(buffer),
+            "\", \"cat\": \"LaTeX2AI\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": %u}",
+            (double)event.start_ * 1e-3, (double)event.duration_ * 1e-3, (unsigned int)event.thread_id_);
+        trace += buffer;
+    }
+    trace += "\n]}\n";
+    return trace;
+}
+
+/**
+ *
+ */
+bool L2A::UTIL::WriteChromeTrace(const TraceBuffer& buffer, const std::filesystem::path& path)
+{
+    std::ofstream trace_file(path, std::ios::binary | std::ios::trunc);
+    trace_file << GetChromeTrace(buffer.GetEvents());
+    return trace_file.good();
+}
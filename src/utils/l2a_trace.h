@@ -0,0 +1,204 @@
+// -----------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2020-2024 Ivo Steinbrecher
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+// -----------------------------------------------------------------------------
+
+/**
+ * \brief Record the time spent in the stages of the item pipeline and export it in the Chrome trace event format.
+ */
+
+#ifndef UTIL_TRACE_H_
+#define UTIL_TRACE_H_
+
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace L2A
+{
+    namespace UTIL
+    {
+        /**
+         * \brief One recorded span.
+         */
+        struct TraceEvent
+        {
+            //! Name of the span, this has to be a string literal.
+            const char* name_;
+
+            //! Start and duration of the span in nanoseconds.
+            std::uint64_t start_;
+            std::uint64_t duration_;
+
+            //! Id of the thread that recorded the span.
+            std::uint32_t thread_id_;
+        };
+
+        /**
+         * \brief Ring buffer for the recorded spans.
+         *
+         * Spans can be recorded from multiple threads without a lock. Each slot has a sequence number that is odd
+         * while the slot is written, so a reader can detect and skip slots that are overwritten while it reads them.
+         * If more spans are recorded than fit in the buffer, the oldest ones are overwritten.
+         */
+        class TraceBuffer
+        {
+           public:
+            /**
+             * \brief Create an empty and disabled buffer with the given number of slots.
+             */
+            TraceBuffer(const size_t capacity);
+
+            /**
+             * \brief Enable or disable the recording of spans.
+             */
+            void SetEnabled(const bool is_enabled) { is_enabled_.store(is_enabled, std::memory_order_relaxed); }
+
+            /**
+             * \brief Check if spans are recorded.
+             */
+            bool IsEnabled() const { return is_enabled_.load(std::memory_order_relaxed); }
+
+            /**
+             * \brief Record a span, the name has to be a string literal.
+             */
+            void Record(const char* name, const std::uint64_t start, const std::uint64_t end);
+
+            /**
+             * \brief Get the recorded spans that are in the buffer, ordered by the time they were recorded.
+             */
+            std::vector<TraceEvent> GetEvents() const;
+
+            /**
+             * \brief Remove all spans from the buffer.
+             */
+            void Clear();
+
+            /**
+             * \brief Get the number of slots in the buffer.
+             */
+            size_t Capacity() const { return capacity_; }
+
+           private:
+            /**
+             * \brief Slot in the buffer, all members are atomic so a slot can be read while it is written.
+             */
+            struct Slot
+            {
+                std::atomic<std::uint64_t> sequence_;
+                std::atomic<const char*> name_;
+                std::atomic<std::uint64_t> start_;
+                std::atomic<std::uint64_t> duration_;
+                std::atomic<std::uint32_t> thread_id_;
+            };
+
+            //! Slots of the buffer.
+            std::unique_ptr<Slot[]> slots_;
+
+            //! Number of slots.
+            size_t capacity_;
+
+            //! Number of spans that were recorded, the next span is written to this index modulo the capacity.
+            std::atomic<std::uint64_t> n_recorded_;
+
+            //! Index of the first span that was not removed by Clear.
+            std::atomic<std::uint64_t> first_index_;
+
+            //! Flag if spans are recorded.
+            std::atomic<bool> is_enabled_;
+        };
+
+        /**
+         * \brief Get the buffer that the spans of LaTeX2AI are recorded to.
+         */
+        TraceBuffer& GetTraceBuffer();
+
+        /**
+         * \brief Get the current time for the trace in nanoseconds.
+         */
+        std::uint64_t GetTraceTime();
+
+        /**
+         * \brief Get a small id of the calling thread.
+         */
+        std::uint32_t GetTraceThreadId();
+
+        /**
+         * \brief Get the events in the Chrome trace event format, i.e., the JSON that can be loaded in chrome://tracing
+         * or https://ui.perfetto.dev.
+         */
+        std::string GetChromeTrace(const std::vector<TraceEvent>& events);
+
+        /**
+         * \brief Write the events of a buffer in the Chrome trace event format to a file.
+         * @return False if the file could not be written.
+         */
+        bool WriteChromeTrace(const TraceBuffer& buffer, const std::filesystem::path& path);
+
+        /**
+         * \brief Record the lifetime of this object as a span in the trace buffer.
+         *
+         * If the recording is disabled when the object is created, nothing else is done, so scopes can stay in the
+         * code.
+         */
+        class TraceScope
+        {
+           public:
+            /**
+             * \brief Start the span, the name has to be a string literal.
+             */
+            TraceScope(const char* name, TraceBuffer& buffer = GetTraceBuffer())
+                : buffer_(buffer), name_(buffer.IsEnabled() ? name : nullptr), start_(0)
+            {
+                if (name_ != nullptr) start_ = GetTraceTime();
+            }
+
+            /**
+             * \brief End the span.
+             */
+            ~TraceScope()
+            {
+                if (name_ != nullptr) buffer_.Record(name_, start_, GetTraceTime());
+            }
+
+            TraceScope(const TraceScope&) = delete;
+            TraceScope& operator=(const TraceScope&) = delete;
+
+           private:
+            //! Buffer that the span is recorded to.
+            TraceBuffer& buffer_;
+
+            //! Name of the span, this is a nullptr if the span is not recorded.
+            const char* name_;
+
+            //! Start time of the span.
+            std::uint64_t start_;
+        };
+    }  // namespace UTIL
+}  // namespace L2A
+
+#endif
@@ -86,3 +86,9 @@ function check_git_hash(xml) {
         )
     }
 }
+
+function bool_to_string(value) {
+    if (value == true) return "1"
+    else if (value == false) return "0"
+    else alert("Got unexpected value in bool_to_string")
+}
@@ -108,4 +108,19 @@ function update_create_form(event) {
             "The error ocurred while recompiling items that were not changed.\nThis usually happens when something in the header changes or the document is compiled on a different system than before."
         )
     }
+
+    // Time of the pages that LaTeX finished before the error
+    var n_timed_pages = parseInt(l2a_xml.attr("n_timed_pages"))
+    if (n_timed_pages > 0) {
+        $("#page_times").prop(
+            "innerHTML",
+            "LaTeX finished " +
+                n_timed_pages +
+                " page(s), the slowest was page " +
+                l2a_xml.attr("slowest_page") +
+                " with " +
+                (parseInt(l2a_xml.attr("slowest_page_ms")) / 1000).toFixed(2) +
+                " s."
+        )
+    }
 }
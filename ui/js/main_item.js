@@ -6,6 +6,7 @@ var latex_text_input = null
 var cursor_position_input = null
 var close_on_focus = false
 var item_ui_finish_on_enter = null
+var syntax_check_timeout = null
 
 $(function () {
     var csInterface = new CSInterface()
@@ -58,6 +59,25 @@ $(function () {
         "com.adobe.csxs.events.latex2ai.item.set_close_on_focus",
         set_close_on_focus
     )
+    csInterface.addEventListener(
+        "com.adobe.csxs.events.latex2ai.item.syntax",
+        update_syntax_error
+    )
+
+    // Check the LaTeX code for syntax errors when the user stops typing
+    $("#latex_text").on("input", function () {
+        clearTimeout(syntax_check_timeout)
+        syntax_check_timeout = setTimeout(function () {
+            var event = new CSEvent(
+                "com.adobe.csxs.events.latex2ai.item.check_syntax",
+                "APPLICATION",
+                "ILST",
+                "LaTeX2AIUI"
+            )
+            event.data = get_form_return_xml_string(null, true)
+            csInterface.dispatchEvent(event)
+        }, 300)
+    })
 
     document.addEventListener("keydown", (event) => {
         if (
@@ -275,3 +295,21 @@ function set_close_on_focus(event) {
     close_on_focus_string = l2a_xml.attr("close_on_focus")
     close_on_focus = close_on_focus_string == "1"
 }
+
+function update_syntax_error(event) {
+    var xmlData = $.parseXML(event.data)
+    var $xml = $(xmlData)
+
+    check_git_hash($xml)
+
+    var l2a_xml = $xml.find("form_data")
+
+    // Show the error below the code and move the cursor to it if requested
+    $("#syntax_error_text").text(l2a_xml.attr("syntax_error"))
+    if (l2a_xml.attr("select_error") == "1") {
+        let position = parseInt(l2a_xml.attr("syntax_error_position"))
+        $("#latex_text").focus()
+        $("#latex_text").prop("selectionStart", position)
+        $("#latex_text").prop("selectionEnd", position)
+    }
+}
@@ -116,6 +116,29 @@ $(function () {
         csInterface.dispatchEvent(event)
     })
 
+    $("#button_show_diagnostics").click(function (event) {
+        // Request the tool versions, document size and metrics from the main application
+        event.preventDefault()
+        var event = new CSEvent(
+            "com.adobe.csxs.events.latex2ai.options.show_diagnostics",
+            "APPLICATION",
+            "ILST",
+            "LaTeX2AIUI"
+        )
+        csInterface.dispatchEvent(event)
+    })
+    $("#button_write_report").click(function (event) {
+        // Write the diagnostics, options and the last compilation to the report folder
+        event.preventDefault()
+        var event = new CSEvent(
+            "com.adobe.csxs.events.latex2ai.options.write_report",
+            "APPLICATION",
+            "ILST",
+            "LaTeX2AIUI"
+        )
+        csInterface.dispatchEvent(event)
+    })
+
     // let the native plug-in part of this sample know that we are ready to receive events now..
     var panelReadyEvent = new CSEvent(
         "com.adobe.csxs.events.latex2ai.options.ready",
@@ -163,10 +186,22 @@ function form_content_to_xml() {
         "gs_command",
         $("#gs_command").prop("value")
     )
+    xml_document.documentElement.setAttribute(
+        "watch_header",
+        bool_to_string($("#watch_header").prop("checked"))
+    )
+    xml_document.documentElement.setAttribute(
+        "trace_pipeline",
+        bool_to_string($("#trace_pipeline").prop("checked"))
+    )
     xml_document.documentElement.setAttribute(
         "item_ui_finish_on_enter",
         bool_to_string($("#item_ui_finish_on_enter").prop("checked"))
     )
+    xml_document.documentElement.setAttribute(
+        "check_latex_syntax",
+        bool_to_string($("#check_latex_syntax").prop("checked"))
+    )
     xml_document.documentElement.setAttribute(
         "warning_boundary_boxes",
         bool_to_string($("#warning_save_boundary_box").prop("checked"))
@@ -207,6 +242,8 @@ function update_form(event) {
             "tex_options"
         )
         if_found_update_value(latex2ai_data, "latex_engine", "tex_engine")
+        if_found_update_checkbox(latex2ai_data, "watch_header", "watch_header")
+        if_found_update_checkbox(latex2ai_data, "trace_pipeline", "trace_pipeline")
 
         // Item creation options
         if_found_update_checkbox(
@@ -214,6 +251,11 @@ function update_form(event) {
             "item_ui_finish_on_enter",
             "item_ui_finish_on_enter"
         )
+        if_found_update_checkbox(
+            latex2ai_data,
+            "check_latex_syntax",
+            "check_latex_syntax"
+        )
 
         // Warnings
         if_found_update_checkbox(
@@ -261,6 +303,12 @@ function update_form(event) {
             button.hide()
         }
     }
+
+    // Set the diagnostics
+    var diagnostics_xml = form_data.find("diagnostics")
+    if (diagnostics_xml.length > 0) {
+        $("#diagnostics_text").val(diagnostics_xml.text())
+    }
 }
 
 function if_found_update_value(xml, xml_name, html_id) {
@@ -288,9 +336,3 @@ function if_found_update_checkbox(xml, xml_name, html_id) {
         }
     }
 }
-
-function bool_to_string(value) {
-    if (value == true) return "1"
-    else if (value == false) return "0"
-    else alert("Got unexpected value in bool_to_string")
-}
@@ -32,6 +32,9 @@ $(function () {
         event.data = get_form_return_xml_string("ok", true)
         csInterface.dispatchEvent(event)
     })
+    $("input[name='action'], input[name='items'], #force_recompile").change(
+        update_redo_plan
+    )
     $("#button_cancel").click(function (event) {
         event.preventDefault()
         // No callback needed here
@@ -80,10 +83,56 @@ function form_content_to_xml() {
         $("input[name='items']:checked").val()
     )
 
+    // Set if items that are up to date are also compiled
+    xml_document.documentElement.setAttribute(
+        "force_recompile",
+        bool_to_string($("#force_recompile").prop("checked"))
+    )
+
     // Return the created xml document
     return xml_document
 }
 
+// Plans for recompiling the items, set by the plugin
+var redo_plans = null
+
+function update_redo_plan() {
+    // The plan is only relevant if the LaTeX code is recompiled
+    var items = $("input[name='items']:checked").val()
+    if ($("#force_recompile").prop("checked")) items += "_force"
+    if (
+        redo_plans == null ||
+        $("input[name='action']:checked").val() != "latex"
+    ) {
+        $("#redo_plan").prop("innerHTML", "")
+        return
+    }
+    var plan_text =
+        redo_plans.attr("plan_" + items + "_skipped") +
+        " skipped / " +
+        redo_plans.attr("plan_" + items + "_deduplicated") +
+        " deduped / " +
+        redo_plans.attr("plan_" + items + "_compiled") +
+        " compiled"
+
+    // Expected LaTeX time from the last compilation of the items
+    var time_ms = parseInt(redo_plans.attr("plan_" + items + "_time_ms"))
+    var n_unknown = parseInt(redo_plans.attr("plan_" + items + "_time_unknown"))
+    var slowest_code = redo_plans.attr("plan_" + items + "_slowest_code")
+    if (slowest_code != null) {
+        plan_text += "<br>Last LaTeX time: " + (time_ms / 1000).toFixed(2) + " s"
+        if (n_unknown > 0) plan_text += " (" + n_unknown + " items without time)"
+        if (slowest_code.length > 40) slowest_code = slowest_code.substring(0, 40) + "..."
+        plan_text +=
+            "<br>Slowest item: " +
+            $("<div>").text(slowest_code).html() +
+            " (" +
+            (parseInt(redo_plans.attr("plan_" + items + "_slowest_ms")) / 1000).toFixed(2) +
+            " s)"
+    }
+    $("#redo_plan").prop("innerHTML", plan_text)
+}
+
 function update_form(event) {
     var xmlData = $.parseXML(event.data)
     var $xml = $(xmlData)
@@ -99,4 +148,14 @@ function update_form(event) {
         "innerHTML",
         "Selected Items (" + redo_xml.attr("n_selected_items") + ")"
     )
+    // Stale items that were already compiled in the background can be swapped in directly
+    var n_staged_items = parseInt(redo_xml.attr("n_staged_items"))
+    var stale_label = "Stale Items (" + redo_xml.attr("n_stale_items")
+    if (n_staged_items > 0) {
+        stale_label += ", " + n_staged_items + " compiled in background"
+        $("#items_stale").prop("checked", true)
+    }
+    $("#items_stale_label").prop("innerHTML", stale_label + ")")
+    redo_plans = redo_xml
+    update_redo_plan()
 }